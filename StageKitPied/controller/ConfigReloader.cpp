@@ -0,0 +1,180 @@
+#include "ConfigReloader.h"
+
+ConfigReloader::ConfigReloader() {
+  m_running = false;
+  m_led_amount = 0;
+  m_settings_is_ready = false;
+};
+
+ConfigReloader::~ConfigReloader() {
+  this->Stop();
+};
+
+bool ConfigReloader::Start( const std::string& lights_ini_file, const LightsSettings& settings,
+                            const std::vector<std::string>& leds_ini_files, const int led_amount ) {
+  this->Stop();
+
+  m_lights_ini_file = lights_ini_file;
+  m_leds_ini_files  = leds_ini_files;
+  m_led_amount      = led_amount;
+  m_settings        = settings;
+
+  if( !mFileWatcher.Init() ) {
+    return false;
+  }
+
+  if( !mFileWatcher.AddFile( m_lights_ini_file ) ) {
+    return false;
+  }
+
+  for( const std::string& leds_ini_file : m_leds_ini_files ) {
+    mFileWatcher.AddFile( leds_ini_file );
+  }
+
+  m_running = true;
+  m_thread = std::thread( &ConfigReloader::Run, this );
+
+  MSG_CONFIGRELOADER_INFO( "Watching " << m_leds_ini_files.size() + 1 << " ini files for changes." );
+
+  return true;
+};
+
+void ConfigReloader::Stop() {
+  m_running = false;
+
+  if( m_thread.joinable() ) {
+    m_thread.join();
+  }
+
+  mFileWatcher.Close();
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_profiles_ready.clear();
+  m_profiles_retired.clear();
+  m_settings_is_ready = false;
+};
+
+std::unique_ptr<LEDProfile> ConfigReloader::TakeProfile() {
+  std::unique_lock<std::mutex> lock( m_mutex, std::try_to_lock );
+
+  if( !lock.owns_lock() || m_profiles_ready.empty() ) {
+    return nullptr;
+  }
+
+  std::unique_ptr<LEDProfile> profile = std::move( m_profiles_ready.back() );
+  m_profiles_ready.pop_back();
+
+  return profile;
+};
+
+bool ConfigReloader::TakeSettings( LightsSettings* ptr_settings ) {
+  std::unique_lock<std::mutex> lock( m_mutex, std::try_to_lock );
+
+  if( !lock.owns_lock() || !m_settings_is_ready ) {
+    return false;
+  }
+
+  *ptr_settings = m_settings_ready;
+  m_settings_is_ready = false;
+
+  return true;
+};
+
+void ConfigReloader::Retire( std::unique_ptr<LEDProfile> profile ) {
+  std::unique_lock<std::mutex> lock( m_mutex, std::try_to_lock );
+
+  // Busy - Let it go here rather than wait.
+  if( lock.owns_lock() ) {
+    m_profiles_retired.push_back( std::move( profile ) );
+  }
+};
+
+void ConfigReloader::Run() {
+  ALLOC_SCOPE( "config" );
+
+  std::vector<std::string> changed_files;
+  uint32_t realtime_generation = Realtime::GetGeneration();
+
+  // Off the output CPU, it's started from the main loop.
+  Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+
+  while( m_running ) {
+    if( realtime_generation != Realtime::GetGeneration() ) {
+      realtime_generation = Realtime::GetGeneration();
+      Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+    }
+
+    if( !mFileWatcher.Wait( CONFIGRELOADER_WAIT_MS, changed_files ) ) {
+      MSG_CONFIGRELOADER_ERROR( "Stopped watching for changes." );
+      break;
+    }
+
+    // Let the writes settle.
+    if( !changed_files.empty() ) {
+      size_t amount_changed;
+      do {
+        amount_changed = changed_files.size();
+        mFileWatcher.Wait( CONFIGRELOADER_SETTLE_MS, changed_files );
+      } while( m_running && changed_files.size() != amount_changed );
+    }
+
+    for( const std::string& changed_file : changed_files ) {
+      if( changed_file == m_lights_ini_file ) {
+        this->ReloadSettings();
+      }
+
+      for( size_t profile_id = 0; profile_id < m_leds_ini_files.size(); profile_id++ ) {
+        if( changed_file == m_leds_ini_files[ profile_id ] ) {
+          this->ReloadProfile( profile_id );
+        }
+      }
+    }
+    changed_files.clear();
+
+    // Swapped out profiles are let go of here.
+    std::vector< std::unique_ptr<LEDProfile> > profiles_retired;
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      profiles_retired.swap( m_profiles_retired );
+    }
+  }
+};
+
+void ConfigReloader::ReloadSettings() {
+  INI_Handler ini_handler;
+
+  if( !ini_handler.Load( m_lights_ini_file ) ) {
+    MSG_CONFIGRELOADER_ERROR( "Reload of " << m_lights_ini_file << " failed, keeping the current settings." );
+    MSG_CONFIGRELOADER_ERROR( " - Err= " << ini_handler.GetErrorMessage() );
+    return;
+  }
+
+  m_settings.Read( &ini_handler );
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_settings_ready = m_settings;
+  m_settings_is_ready = true;
+
+  MSG_CONFIGRELOADER_INFO( "Reloaded " << m_lights_ini_file );
+};
+
+void ConfigReloader::ReloadProfile( const int profile_id ) {
+  std::unique_ptr<LEDProfile> profile( new LEDProfile( profile_id ) );
+
+  if( !profile->Load( m_leds_ini_files[ profile_id ], m_led_amount ) ) {
+    MSG_CONFIGRELOADER_ERROR( "Reload of " << m_leds_ini_files[ profile_id ] << " failed, keeping the current LED profile." );
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+
+  // Only the newest copy of a profile is worth keeping.
+  for( std::unique_ptr<LEDProfile>& profile_ready : m_profiles_ready ) {
+    if( profile_ready->GetID() == profile_id ) {
+      m_profiles_retired.push_back( std::move( profile_ready ) );
+      profile_ready = std::move( profile );
+      return;
+    }
+  }
+  m_profiles_ready.push_back( std::move( profile ) );
+};
@@ -0,0 +1,76 @@
+#ifndef _CONFIGRELOADER_H_
+#define _CONFIGRELOADER_H_
+
+#define MSG_CONFIGRELOADER_DEBUG( str ) LOG_DEBUG( "ConfigReloader", str )
+
+#define MSG_CONFIGRELOADER_ERROR( str ) LOG_ERROR( "ConfigReloader", str )
+#define MSG_CONFIGRELOADER_INFO( str ) LOG_INFO( "ConfigReloader", str )
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/AllocTracker.h"
+#include "helpers/FileWatcher.h"
+#include "helpers/INI_Handler.h"
+#include "helpers/Log.h"
+#include "helpers/Realtime.h"
+#include "controller/LightsSettings.h"
+#include "leds/LEDProfile.h"
+
+#define CONFIGRELOADER_WAIT_MS   200  // How often the thread checks if it should stop.
+#define CONFIGRELOADER_SETTLE_MS 100  // Quiet time after a change before reloading, editors can write more than once.
+
+// Watches lights.ini & the LED inis, reloading them on its own thread.
+// Results are picked up by the main loop, which never waits on the reload.
+class ConfigReloader {
+public:
+  ConfigReloader();
+
+  ~ConfigReloader();
+
+  // settings are the ones in use, the ini is read over the top of them.
+  bool Start( const std::string& lights_ini_file, const LightsSettings& settings,
+              const std::vector<std::string>& leds_ini_files, const int led_amount );
+
+  void Stop();
+
+  // Takes a reloaded LED profile if one is ready.  Never blocks.
+  std::unique_ptr<LEDProfile> TakeProfile();
+
+  // Takes reloaded settings if they're ready.  Never blocks.
+  bool TakeSettings( LightsSettings* ptr_settings );
+
+  // Hands back a profile that's been swapped out, so it's released on the reload thread.
+  void Retire( std::unique_ptr<LEDProfile> profile );
+
+private:
+  void Run();
+
+  void ReloadSettings();
+
+  void ReloadProfile( const int profile_id );
+
+  FileWatcher                 mFileWatcher;
+
+  std::thread                 m_thread;
+  std::atomic<bool>           m_running;
+
+  std::string                 m_lights_ini_file;
+  std::vector<std::string>    m_leds_ini_files;
+  int                         m_led_amount;
+  LightsSettings              m_settings;
+
+  // Shared with the main loop.
+  std::mutex                  m_mutex;
+  std::vector< std::unique_ptr<LEDProfile> > m_profiles_ready;
+  std::vector< std::unique_ptr<LEDProfile> > m_profiles_retired;
+  bool                        m_settings_is_ready;
+  LightsSettings              m_settings_ready;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include "CueRecorder.h"
+
+CueRecorder::CueRecorder() {
+  m_next   = 0;
+  m_amount = 0;
+};
+
+void CueRecorder::Record( const uint8_t left_weight, const uint8_t right_weight ) {
+  Cue& cue = m_cues[ m_next ];
+  cue.m_time         = std::chrono::steady_clock::now();
+  cue.m_left_weight  = left_weight;
+  cue.m_right_weight = right_weight;
+
+  m_next = ( m_next + 1 ) % CUERECORDER_CUES;
+  if( m_amount < CUERECORDER_CUES ) {
+    m_amount++;
+  }
+};
+
+uint32_t CueRecorder::Copy( ControlCueRecord* ptr_records ) {
+  const std::chrono::steady_clock::time_point time_now = std::chrono::steady_clock::now();
+  const uint32_t first = ( m_next + CUERECORDER_CUES - m_amount ) % CUERECORDER_CUES;
+
+  for( uint32_t index = 0; index < m_amount; index++ ) {
+    const Cue& cue = m_cues[ ( first + index ) % CUERECORDER_CUES ];
+    ptr_records[ index ].m_age_ms       = std::chrono::duration_cast<std::chrono::milliseconds>( time_now - cue.m_time ).count();
+    ptr_records[ index ].m_left_weight  = cue.m_left_weight;
+    ptr_records[ index ].m_right_weight = cue.m_right_weight;
+  }
+
+  return m_amount;
+};
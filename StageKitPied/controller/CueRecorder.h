@@ -0,0 +1,35 @@
+#ifndef _CUERECORDER_H_
+#define _CUERECORDER_H_
+
+#define CUERECORDER_CUES 512  // Recent cues kept, oldest dropped first.  A busy song sends a few a second.
+
+#include <chrono>
+#include <cstdint>
+
+#include "network/ControlSocket.h"
+
+// Keeps the last CUERECORDER_CUES cues with when they came in, so what led up to a glitch can be looked at after.
+// A fixed ring, recording never allocates.
+class CueRecorder {
+public:
+  CueRecorder();
+
+  void Record( const uint8_t left_weight, const uint8_t right_weight );
+
+  // Oldest first, aged from now.  Returns the amount copied, up to CUERECORDER_CUES.
+  uint32_t Copy( ControlCueRecord* ptr_records );
+
+private:
+  struct Cue
+  {
+    std::chrono::steady_clock::time_point m_time;
+    uint8_t m_left_weight;
+    uint8_t m_right_weight;
+  };
+
+  Cue      m_cues[ CUERECORDER_CUES ];
+  uint32_t m_next;    // Written next, the oldest once full.
+  uint32_t m_amount;
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "LightsSettings.h"
+
+LightsSettings::LightsSettings() {
+  m_sleeptime_idle          = 500;
+  m_sleeptime_stagekit      = 10;
+  m_sleeptime_strobe        = 5;
+
+  m_leds_strobe_enabled     = false;
+  m_leds_strobe_rate[ 0 ]   = 120;
+  m_leds_strobe_rate[ 1 ]   = 100;
+  m_leds_strobe_rate[ 2 ]   = 80;
+  m_leds_strobe_rate[ 3 ]   = 60;
+
+  m_leds_frame_rate         = 100;
+  m_leds_fade_in_ms         = 0;
+  m_leds_fade_out_ms        = 0;
+  m_leds_high_depth         = false;
+  m_leds_render_threads     = 1;
+
+  m_nodata_ms               = 10 * 1000;
+  m_nodata_red              = 0;
+  m_nodata_green            = 0;
+  m_nodata_blue             = 0;
+  m_nodata_brightness       = 0;
+
+  for( int config_id = 0; config_id < LIGHTSSETTINGS_STAGEKIT_CONFIGS; config_id++ ) {
+    m_stagekit_config_set[ config_id ] = false;
+    m_stagekit_config[ config_id ] = StageKitConfig();
+  }
+};
+
+void LightsSettings::Read( INI_Handler* ptrINI_Handler ) {
+  if( ptrINI_Handler->SetSection( "SLEEP_TIMES" ) ) {
+    m_sleeptime_idle      = ptrINI_Handler->GetTokenValue( "IDLE" );
+    m_sleeptime_stagekit  = ptrINI_Handler->GetTokenValue( "STAGEKIT" );
+    m_sleeptime_strobe    = ptrINI_Handler->GetTokenValue( "STROBE" );
+  }
+
+  if( ptrINI_Handler->SetSection( "LEDS" ) ) {
+    m_leds_strobe_enabled   = ptrINI_Handler->GetTokenValue( "STROBE_ENABLED" ) == 1;
+    m_leds_strobe_rate[ 0 ] = ptrINI_Handler->GetTokenValue( "STROBE_RATE_1_MS" );
+    m_leds_strobe_rate[ 1 ] = ptrINI_Handler->GetTokenValue( "STROBE_RATE_2_MS" );
+    m_leds_strobe_rate[ 2 ] = ptrINI_Handler->GetTokenValue( "STROBE_RATE_3_MS" );
+    m_leds_strobe_rate[ 3 ] = ptrINI_Handler->GetTokenValue( "STROBE_RATE_4_MS" );
+
+    // Older inis don't have fades, so leave them off.
+    if( ptrINI_Handler->TokenExists( "FRAME_RATE" ) ) {
+      m_leds_frame_rate = ptrINI_Handler->GetTokenValue( "FRAME_RATE" );
+      if( m_leds_frame_rate <= 0 ) {
+        m_leds_frame_rate = 100;
+      }
+    }
+    if( ptrINI_Handler->TokenExists( "FADE_IN_MS" ) ) {
+      m_leds_fade_in_ms = ptrINI_Handler->GetTokenValue( "FADE_IN_MS" );
+    }
+    if( ptrINI_Handler->TokenExists( "FADE_OUT_MS" ) ) {
+      m_leds_fade_out_ms = ptrINI_Handler->GetTokenValue( "FADE_OUT_MS" );
+    }
+    if( ptrINI_Handler->TokenExists( "HIGH_DEPTH" ) ) {
+      m_leds_high_depth = ptrINI_Handler->GetTokenValue( "HIGH_DEPTH" ) == 1;
+    }
+    if( ptrINI_Handler->TokenExists( "REMAP" ) ) {
+      m_leds_remap = ptrINI_Handler->GetTokenString( "REMAP" );
+    }
+    if( ptrINI_Handler->TokenExists( "RENDER_THREADS" ) ) {
+      m_leds_render_threads = ptrINI_Handler->GetTokenValue( "RENDER_THREADS" );
+    }
+  }
+
+  if( ptrINI_Handler->SetSection( "REALTIME" ) ) {
+    if( ptrINI_Handler->TokenExists( "ENABLED" ) ) {
+      m_realtime.m_enabled = ptrINI_Handler->GetTokenValue( "ENABLED" ) == 1;
+    }
+    if( ptrINI_Handler->TokenExists( "LOCK_MEMORY" ) ) {
+      m_realtime.m_lock_memory = ptrINI_Handler->GetTokenValue( "LOCK_MEMORY" ) == 1;
+    }
+    if( ptrINI_Handler->TokenExists( "OUTPUT_CPU" ) ) {
+      m_realtime.m_output_cpu = ptrINI_Handler->GetTokenValue( "OUTPUT_CPU" );
+    }
+    if( ptrINI_Handler->TokenExists( "MAIN_PRIORITY" ) ) {
+      m_realtime.m_priority[ REALTIME_ROLE_MAIN ] = ptrINI_Handler->GetTokenValue( "MAIN_PRIORITY" );
+    }
+    if( ptrINI_Handler->TokenExists( "RENDER_PRIORITY" ) ) {
+      m_realtime.m_priority[ REALTIME_ROLE_RENDER ] = ptrINI_Handler->GetTokenValue( "RENDER_PRIORITY" );
+    }
+    if( ptrINI_Handler->TokenExists( "HOUSEKEEPING_PRIORITY" ) ) {
+      m_realtime.m_priority[ REALTIME_ROLE_HOUSEKEEPING ] = ptrINI_Handler->GetTokenValue( "HOUSEKEEPING_PRIORITY" );
+    }
+  }
+
+  if( ptrINI_Handler->SetSection( "METRICS" ) ) {
+    if( ptrINI_Handler->TokenExists( "ENABLED" ) ) {
+      m_metrics.m_enabled = ptrINI_Handler->GetTokenValue( "ENABLED" ) == 1;
+    }
+    if( ptrINI_Handler->TokenExists( "FILE" ) ) {
+      m_metrics.m_file = ptrINI_Handler->GetTokenString( "FILE" );
+    }
+    if( ptrINI_Handler->TokenExists( "SOCKET" ) ) {
+      m_metrics.m_socket = ptrINI_Handler->GetTokenString( "SOCKET" );
+    }
+    if( ptrINI_Handler->TokenExists( "INTERVAL_MS" ) ) {
+      m_metrics.m_interval_ms = ptrINI_Handler->GetTokenValue( "INTERVAL_MS" );
+    }
+  }
+
+  if( ptrINI_Handler->SetSection( "NO_DATA" ) ) {
+    m_nodata_ms = ptrINI_Handler->GetTokenValue( "NO_DATA_SECONDS" );
+    m_nodata_ms *= 1000;
+
+    ReadRGB( ptrINI_Handler->GetTokenView( "NO_DATA_RGB" ), &m_nodata_red, &m_nodata_green, &m_nodata_blue );
+
+    m_nodata_brightness = ptrINI_Handler->GetTokenValue( "NO_DATA_BRIGHTNESS" );
+  }
+
+  std::string section_name;
+  for( int config_id = 1; config_id < LIGHTSSETTINGS_STAGEKIT_CONFIGS; config_id++ ) {
+    // Stagekit configs.  Config=0 is internal for all off.
+    section_name = "STAGEKIT_CONFIG_";
+    section_name += std::to_string( config_id );
+
+    if( ptrINI_Handler->SetSection( section_name ) ) {
+      StageKitConfig* ptr_config = &m_stagekit_config[ config_id ];
+
+      ptr_config->m_light_pod_enabled        = ptrINI_Handler->GetTokenValue( "ENABLE_POD_LIGHTS" ) == 1;
+      ptr_config->m_strobe_enabled           = ptrINI_Handler->GetTokenValue( "ENABLE_STROBE" ) == 1;
+      ptr_config->m_fog_enabled              = ptrINI_Handler->GetTokenValue( "ENABLE_FOG" ) == 1;
+      ptr_config->m_fog_instance_time_max_ms = ptrINI_Handler->GetTokenValue( "FOG_MAX_INSTANCE_TIME_SECONDS" ) * 1000;
+      ptr_config->m_fog_total_time_max_ms    = ptrINI_Handler->GetTokenValue( "FOG_MAX_TOTAL_TIME_SECONDS" ) * 1000;
+
+      m_stagekit_config_set[ config_id ] = true;
+    }
+  }
+};
+
+// "r,g,b" - Missing or bad values are left alone.
+void LightsSettings::ReadRGB( std::string_view text, uint8_t* ptr_red, uint8_t* ptr_green, uint8_t* ptr_blue ) {
+  uint8_t* colours[ 3 ] = { ptr_red, ptr_green, ptr_blue };
+
+  for( int i = 0; i < 3 && !text.empty(); i++ ) {
+    size_t comma = text.find( ',' );
+    std::string_view value = text.substr( 0, comma );
+
+    while( !value.empty() && value.front() == ' ' ) {
+      value.remove_prefix( 1 );
+    }
+
+    int number;
+    if( std::from_chars( value.data(), value.data() + value.size(), number ).ec == std::errc() ) {
+      *colours[ i ] = number;
+    }
+
+    if( comma == std::string_view::npos ) {
+      break;
+    }
+    text.remove_prefix( comma + 1 );
+  }
+};
@@ -0,0 +1,66 @@
+#ifndef _LIGHTSSETTINGS_H_
+#define _LIGHTSSETTINGS_H_
+
+#include <charconv>  // from_chars
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "helpers/INI_Handler.h"
+#include "helpers/MetricsExporter.h"
+#include "helpers/Realtime.h"
+#include "stagekit/StageKitConfig.h"
+
+#define LIGHTSSETTINGS_STAGEKIT_CONFIGS 5  // 0 is the internal all off config.
+
+// The lights.ini settings that can be changed while running, without touching any devices.
+struct LightsSettings
+{
+  LightsSettings();
+
+  // Anything missing from the ini keeps its current value.
+  void Read( INI_Handler* ptrINI_Handler );
+
+  // Sleep times
+  uint16_t       m_sleeptime_idle;      // Time to sleep when program is in idle mode
+  uint16_t       m_sleeptime_stagekit;  // Time to sleep when program is in stagekit mode
+  uint16_t       m_sleeptime_strobe;    // Time to sleep when program is currently doing strobe
+
+  // LED array strobe
+  bool           m_leds_strobe_enabled;
+  uint16_t       m_leds_strobe_rate[ 4 ];  // Time in MS between strobes for each stagekit rate
+
+  // LED array fades
+  int            m_leds_frame_rate;     // Frames a second while fading
+  int            m_leds_fade_in_ms;     // Time for a colour group to come fully on, 0 for instant
+  int            m_leds_fade_out_ms;    // Time for a colour group to go off, the afterglow
+  bool           m_leds_high_depth;     // 16 bit colour, dithered with the SK9822 brightness
+
+  // LED array wiring
+  std::string    m_leds_remap;          // Strip order, see LEDRemap.  Empty sends LEDs as numbered
+
+  // LED array drawing
+  int            m_leds_render_threads; // Threads drawing each frame, 0 for one per core
+
+  // Realtime scheduling
+  RealtimeSettings m_realtime;
+
+  // Metrics export
+  MetricsSettings  m_metrics;
+
+  // NO DATA
+  long           m_nodata_ms;
+  uint8_t        m_nodata_red;
+  uint8_t        m_nodata_green;
+  uint8_t        m_nodata_blue;
+  uint8_t        m_nodata_brightness;
+
+  // Stage kit configs, only those found in the ini are set.
+  bool           m_stagekit_config_set[ LIGHTSSETTINGS_STAGEKIT_CONFIGS ];
+  StageKitConfig m_stagekit_config[ LIGHTSSETTINGS_STAGEKIT_CONFIGS ];
+
+private:
+  static void ReadRGB( std::string_view text, uint8_t* ptr_red, uint8_t* ptr_green, uint8_t* ptr_blue );
+};
+
+#endif
@@ -12,24 +12,17 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
   m_stagekit_colour_blue        = 0x00;  // Bit set for led number indication
   m_stagekit_colour_yellow      = 0x00;  // Bit set for led number indication
 
-  m_sleeptime_idle              = 500;   // Time to sleep when program is in idle mode
-  m_sleeptime_stagekit          = 10;    // Time to sleep when program is in stagekit mode
-  m_sleeptime_strobe            = 5;     // Time to sleep when program is currently doing strobe
-
   m_leds_enabled                = false; // Default no leds
-  m_leds_strobe_enabled         = false; // Default don't strobe
-  m_leds_strobe_rate[ 0 ]       = 120;   // Time in MS between strobes for stagekit rate 1
-  m_leds_strobe_rate[ 1 ]       = 100;   // Time in MS between strobes for stagekit rate 2
-  m_leds_strobe_rate[ 2 ]       = 80;    // Time in MS between strobes for stagekit rate 3
-  m_leds_strobe_rate[ 3 ]       = 60;    // Time in MS between strobes for stagekit rate 4
   m_leds_strobe_speed_current   = 0;
   m_leds_strobe_next_on_ms      = 0;
+  m_leds_ini_amount             = 0;
+  m_leds_ini_number             = 1;
+  m_leds_ini_default            = 1;
+  m_leds_amount                 = 0;
 
-  m_nodata_ms                   = 10 * 1000;
   m_nodata_ms_count             = 0;
-  m_nodata_red                  = 0;
-  m_nodata_green                = 0;
-  m_nodata_blue                 = 0;
+  m_reload_enabled              = false;
+  m_control_enabled             = false;
   
   m_stagekit_default_config     = 0;
   
@@ -37,6 +30,28 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
   
   m_ptr_control_request_data = (unsigned char*) &m_control_request.header;
   m_serial_connected_to_x360 = false;
+  m_serial_reconnect         = false;
+  m_serial_reconnect_delay_ms = SERIAL_RECONNECT_DELAY_MS;
+  m_serial_auto_discover     = false;
+  m_serial_probe_timeout_ms  = SERIALADAPTER_PROBE_TIMEOUT;
+
+  mLEDZones.SetMain( &mLEDS );
+
+  static const char* cue_names[ RPLC_CUES ] = { "red", "green", "blue", "yellow", "fog_on", "fog_off", "strobe_off",
+                                                "strobe_1", "strobe_2", "strobe_3", "strobe_4", "all_off", "unknown" };
+  for( int cue = 0; cue < RPLC_CUES; cue++ ) {
+    m_ptr_cues[ cue ] = Metrics::Counter( "skp_cues_total", "Stage kit cues received.", std::string( "cue=\"" ) + cue_names[ cue ] + "\"" );
+  }
+
+  static const char* tier_names[ RPLC_SLEEP_TIERS ] = { "idle", "stagekit", "strobe", "frame" };
+  for( int tier = 0; tier < RPLC_SLEEP_TIERS; tier++ ) {
+    m_ptr_sleep_ms[ tier ] = Metrics::Counter( "skp_sleep_milliseconds_total", "Time spent waiting in each sleep tier.",
+                                               std::string( "tier=\"" ) + tier_names[ tier ] + "\"" );
+  }
+
+  m_ptr_strobe_edges = Metrics::Counter( "skp_strobe_edges_total", "LED strobe flashes on & off." );
+  m_ptr_update_time  = Metrics::Histogram( "skp_update_seconds", "Time to handle one pass of the main loop." );
+  m_sleep_tier       = RPLC_SLEEP_TIER_IDLE;
 
   // Path
   char path_buffer[ 256 ];
@@ -48,17 +63,25 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
   std::string file = dirname( path_buffer );
   file += "/";
   file += ini_file;
+  m_lights_ini_file = file;
+
+  // Sleep times, strobe rates, no data & stage kit configs.  Defaults unless the ini has them.
+  LightsSettings settings;
 
   if( !mINI_Handler.Load( file ) ) {
     MSG_RPLC_ERROR( "Error loading config.ini" );
     MSG_RPLC_ERROR( " - Err= " << mINI_Handler.GetErrorMessage() );
   } else {
-    // Sleep times from ini if found
-    if( mINI_Handler.SetSection( "SLEEP_TIMES" ) ) {
-      // Pod lights
-      m_sleeptime_idle      = mINI_Handler.GetTokenValue( "IDLE" );
-      m_sleeptime_stagekit  = mINI_Handler.GetTokenValue( "STAGEKIT" );
-      m_sleeptime_strobe    = mINI_Handler.GetTokenValue( "STROBE" );
+    // Settings that can also be reloaded while running.
+    settings.Read( &mINI_Handler );
+
+    if( mINI_Handler.SetSection( "RELOAD" ) ) {
+      m_reload_enabled = mINI_Handler.GetTokenValue( "ENABLED" ) == 1;
+    }
+
+    if( mINI_Handler.SetSection( "CONTROL" ) ) {
+      m_control_enabled = mINI_Handler.GetTokenValue( "ENABLED" ) == 1;
+      m_control_socket  = mINI_Handler.GetTokenString( "SOCKET" );
     }
 
     // RB3Enhanced mode?
@@ -98,41 +121,14 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
       }
     }
     
-    std::string section_name;
-    for( uint8_t config_id = 1; config_id < 5; config_id++ ) {
-      // Stagekit configs.  Config=0 is internal for all off.
-      section_name = "STAGEKIT_CONFIG_";
-      section_name += std::to_string( config_id );
-      
-      if( !mINI_Handler.SetSection( section_name ) ) {
-        MSG_RPLC_INFO( "INI section 'STAGEKIT_CONFIG_" << config_id << "' not found - Using default settings." );
-      } else {
-        // Pod lights
-        int enable = mINI_Handler.GetTokenValue( "ENABLE_POD_LIGHTS" );
-        if( enable == 1 ) {
-          mStageKitManager.ConfigEnableLights( config_id, true );
-        } else {
-          mStageKitManager.ConfigEnableLights( config_id, false );
-        }
-
-        // Strobe
-        enable = mINI_Handler.GetTokenValue( "ENABLE_STROBE" );
-        if( enable == 1 ) {
-          mStageKitManager.ConfigEnableStrobe( config_id, true );
-        } else {
-          mStageKitManager.ConfigEnableStrobe( config_id, false );
-        }
-        
-        // Fogger
-        enable = mINI_Handler.GetTokenValue( "ENABLE_FOG" );
-        if( enable == 1 ) {
-          mStageKitManager.ConfigEnableFog( config_id, true );
-        } else {
-          mStageKitManager.ConfigEnableFog( config_id, false );
-        }
-        long fog_instance_time_ms = mINI_Handler.GetTokenValue( "FOG_MAX_INSTANCE_TIME_SECONDS" ) * 1000;
-        long fog_total_time_ms    = mINI_Handler.GetTokenValue( "FOG_MAX_TOTAL_TIME_SECONDS" ) * 1000;
-        mStageKitManager.ConfigSetFogTimes( config_id, fog_instance_time_ms, fog_total_time_ms );      
+    // Serial link speed.  Adapter negotiates down from this if the link can't keep up.
+    if( mINI_Handler.SetSection( "SERIAL_INTERFACE" ) ) {
+      if( mINI_Handler.TokenExists( "BAUDRATE_MAX" ) ) {
+        mSerialAdapter.SetBaudrateMax( mINI_Handler.GetTokenValue( "BAUDRATE_MAX" ) );
+      }
+      m_serial_auto_discover = mINI_Handler.GetTokenValue( "AUTO_DISCOVER" ) > 0;
+      if( mINI_Handler.TokenExists( "PROBE_TIMEOUT_MS" ) ) {
+        m_serial_probe_timeout_ms = mINI_Handler.GetTokenValue( "PROBE_TIMEOUT_MS" );
       }
     }
 
@@ -149,10 +145,15 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
         m_leds_enabled = false;
       }
 
+      std::string led_type;
+      if( mINI_Handler.TokenExists( "TYPE" ) ) {
+        led_type = mINI_Handler.GetTokenString( "TYPE" );
+      }
       std::string led_device = mINI_Handler.GetTokenString( "DEVICE" );
       int led_amount = mINI_Handler.GetTokenValue( "LED_AMOUNT" );
       m_leds_ini_amount = mINI_Handler.GetTokenValue( "INI_AMOUNT" );
       m_leds_ini_number = mINI_Handler.GetTokenValue( "INI_DEFAULT" );
+      m_leds_ini_default = m_leds_ini_number;
 
       m_leds_ini = new std::string[ m_leds_ini_amount ];
       std::string token;
@@ -163,26 +164,18 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
         m_leds_ini[ i ] = mINI_Handler.GetTokenString( token );
       }
 
-      // Strobe
-      enable = mINI_Handler.GetTokenValue( "STROBE_ENABLED" );
-      if( enable == 1 ) {
-        m_leds_strobe_enabled = true;
-      } else {
-        m_leds_strobe_enabled = false;
-      }
-      m_leds_strobe_rate[ 0 ] = mINI_Handler.GetTokenValue( "STROBE_RATE_1_MS" );
-      m_leds_strobe_rate[ 1 ] = mINI_Handler.GetTokenValue( "STROBE_RATE_2_MS" );
-      m_leds_strobe_rate[ 2 ] = mINI_Handler.GetTokenValue( "STROBE_RATE_3_MS" );
-      m_leds_strobe_rate[ 3 ] = mINI_Handler.GetTokenValue( "STROBE_RATE_4_MS" );
-
-      // LEDs Config
+      // LEDs Config - Every profile is loaded, so switching never touches a file.
       bytes_read = readlink( "/proc/self/exe", path_buffer, len );
       path_buffer[ bytes_read ] = '\0';
-      file = dirname( path_buffer );
-      file += "/";
-      file += m_leds_ini[ m_leds_ini_number - 1 ];
+      std::string leds_path = dirname( path_buffer );
+      leds_path += "/";
 
-      if( !mLEDS.Init( led_device, led_amount ) ) {
+      for( int i = 0; i < m_leds_ini_amount; i++ ) {
+        m_leds_ini_files.push_back( leds_path + m_leds_ini[ i ] );
+      }
+      m_leds_amount = led_amount;
+
+      if( !mLEDS.Init( led_type, led_device, led_amount ) ) {
         MSG_RPLC_ERROR( "LED Array init failed." );
         return;
       }
@@ -192,27 +185,6 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
         return;
       }
 
-      if( mINI_Handler.SetSection( "NO_DATA" ) ) {
-        m_nodata_ms = mINI_Handler.GetTokenValue( "NO_DATA_SECONDS" );
-        m_nodata_ms *= 1000;
-        m_nodata_ms_count = 0;
-
-        std::string tmp;
-        std::stringstream rgb;
-        rgb.str( mINI_Handler.GetTokenString( "NO_DATA_RGB" ) );
-
-        std::getline( rgb, tmp, ',' );
-        m_nodata_red = std::stoi( tmp );
-
-        std::getline( rgb, tmp, ',' );
-        m_nodata_green = std::stoi( tmp );
-
-        std::getline( rgb, tmp, ',' );
-        m_nodata_blue = std::stoi( tmp );
-
-        m_nodata_brightness = mINI_Handler.GetTokenValue( "NO_DATA_BRIGHTNESS" );
-      }
-
       int flash_red        = 0;
       int flash_green      = 255;
       int flash_blue       = 0;
@@ -256,14 +228,30 @@ RpiLightsController::RpiLightsController( const char* ini_file ) {
         }
       }
 
-      if( mLEDS.LoadSettingsSK( file ) ) {
+      this->LoadLEDZones( leds_path );
+
+      if( !mLEDS.LoadProfiles( m_leds_ini_files ) ) {
+        MSG_RPLC_ERROR( "Failed to load LED settings." );
+      } else if( mLEDS.SelectProfile( m_leds_ini_number - 1 ) ) {
         MSG_RPLC_INFO( "LED Settings loaded." );
       } else {
-        MSG_RPLC_ERROR( "Failed to load LED settings." );
+        // Default didn't load, fall back to the first that did.
+        for( int profile_id = 0; profile_id < mLEDS.GetAmountProfiles(); profile_id++ ) {
+          if( mLEDS.SelectProfile( profile_id ) ) {
+            break;
+          }
+        }
+        m_leds_ini_number = mLEDS.GetProfile() + 1;
+        MSG_RPLC_ERROR( "Default LED settings failed to load, using INI" << +m_leds_ini_number << "." );
       }
     }
   }
 
+  this->ApplySettings( settings );
+
+  // Still starting up, so the slow memory lock can be done here.  Reloads leave it to the housekeeping threads.
+  Realtime::UpdateMemoryLock();
+
   // Idle sleep time.
   m_sleep_time = m_sleeptime_idle;
 
@@ -279,6 +267,16 @@ RpiLightsController::~RpiLightsController() {
 };
 
 bool RpiLightsController::Start() {
+  if( m_reload_enabled ) {
+    if( !mConfigReloader.Start( m_lights_ini_file, m_settings, m_leds_ini_files, m_leds_amount ) ) {
+      MSG_RPLC_ERROR( "Unable to watch the ini files for changes. Running without reloading." );
+    }
+  }
+
+  if( m_control_enabled && !mControlSocket.Start( m_control_socket ) ) {
+    MSG_RPLC_ERROR( "Unable to open the control socket. Running without." );
+  }
+
   // RB3E MODE
   if( m_rb3e_listener_enabled ) {
     if( !mRB3E_Network.StartReceiver( m_rb3e_source_ip, m_rb3e_listening_port ) ) {
@@ -317,44 +315,80 @@ bool RpiLightsController::Start() {
     return false;
   }
 
-  if( !this->Handle_SerialConnect() ) {
+  if( !this->Handle_SerialConnect( true ) ) {
     return false;
   }
 
+  // From now on, try to get the adapter back if it drops out.
+  m_serial_reconnect = true;
+
   return true;
 };
 
 long RpiLightsController::Update( long time_passed_ms ) {
-  
+  const std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+
+  // Time since the last pass was spent asleep, near enough.
+  m_ptr_sleep_ms[ m_sleep_tier ]->Add( time_passed_ms );
+
   if( m_rb3e_listener_enabled ) {
     this->RB3ENetwork_Poll();
   } else {
     this->SerialAdapter_Poll();
+    this->SerialAdapter_CheckConnection( time_passed_ms );
   }
 
+  // Before the flush, so injected cues are drawn in the same frame as the game's.
+  this->ControlSocket_Poll();
+
+  // One LED frame for however many light changes came in, every zone drawn at once.
+  mLEDZones.Flush();
+
   m_sleep_time = this->Handle_TimeUpdate( time_passed_ms );
+  m_sleep_tier = m_leds_strobe_speed_current > 0 ? RPLC_SLEEP_TIER_STROBE : RPLC_SLEEP_TIER_STAGEKIT;
+
+  // Wake up in time for the next fade or dither frame.
+  if( mLEDZones.IsAnimating() && m_sleep_time > mLEDZones.GetFrameIntervalMs() ) {
+    m_sleep_time = mLEDZones.GetFrameIntervalMs();
+    m_sleep_tier = RPLC_SLEEP_TIER_FRAME;
+  }
 
   // Yeah this isn't right, since we probably had data but that data will reset counter to 0
   // so it'll be close enough :D
   if( m_nodata_ms > 0 ) {
     m_nodata_ms_count += m_sleep_time;
     if( m_nodata_ms_count > m_nodata_ms ) {
-      mLEDS.SetAllLED( m_nodata_red, m_nodata_green, m_nodata_blue, m_nodata_brightness );
+      mLEDZones.SetAllLED( m_nodata_red, m_nodata_green, m_nodata_blue, m_nodata_brightness );
       m_nodata_ms_count = 0;
     }
   }
 
-  this->StageKit_PollButtons( time_passed_ms );
+  {
+    ALLOC_SCOPE( "usb" );
+    this->StageKit_PollButtons( time_passed_ms );
+  }
+
+  if( m_reload_enabled ) {
+    ALLOC_SCOPE( "config" );
+    this->Handle_ConfigReload();
+  }
+
+  m_ptr_update_time->ObserveSince( time_start );
 
   return m_sleep_time;
 };
 
 void RpiLightsController::Stop() {
+  mConfigReloader.Stop();
+  mMetricsExporter.Stop();
+  mControlSocket.Stop();
+
   if( m_rb3e_listener_enabled || m_rb3e_sender_enabled ) {
     mRB3E_Network.Stop();
     return;
   }
   
+  mSerialDiscovery.Stop();
   mSerialAdapter.Close();
 
   mStageKitManager.End();
@@ -430,6 +464,22 @@ void RpiLightsController::SerialAdapter_HandleOutReport() {
 
 };
 
+void RpiLightsController::SerialAdapter_CheckConnection( const long time_passed_ms ) {
+  if( !m_serial_reconnect || mSerialAdapter.IsRunning() ) {
+    return;
+  }
+
+  if( time_passed_ms < m_serial_reconnect_delay_ms ) {
+    m_serial_reconnect_delay_ms -= time_passed_ms;
+    return;
+  }
+  m_serial_reconnect_delay_ms = m_serial_auto_discover ? SERIAL_DISCOVER_DELAY_MS : SERIAL_RECONNECT_DELAY_MS;
+
+  MSG_RPLC_INFO( "Serial Adapter not running.  Attempting to reconnect." );
+  m_serial_connected_to_x360 = false;
+  this->Handle_SerialConnect( false );
+};
+
 void RpiLightsController::RB3ENetwork_Poll() {
   if( mRB3E_Network.Poll() ) {
     MSG_RPLC_DEBUG( "Received RB3E network data." );
@@ -440,6 +490,196 @@ void RpiLightsController::RB3ENetwork_Poll() {
   }
 };
 
+void RpiLightsController::ControlSocket_Poll() {
+  for( int message = 0; message < CONTROLSOCKET_MESSAGES_PER_POLL && mControlSocket.Poll(); message++ ) {
+    this->ControlSocket_HandleCommand();
+  }
+};
+
+void RpiLightsController::ControlSocket_HandleCommand() {
+  const uint8_t* ptr_data  = mControlSocket.GetData();
+  const uint32_t data_size = mControlSocket.GetDataSize();
+
+  switch( mControlSocket.GetCommand() ) {
+    case CONTROL_COMMAND_SELECT_PROFILE:
+      if( data_size != 1 ) {
+        mControlSocket.Reply( CONTROL_STATUS_BAD_LENGTH );
+      } else {
+        mControlSocket.Reply( this->SelectLEDProfile( ptr_data[ 0 ] ) ? CONTROL_STATUS_OK : CONTROL_STATUS_FAILED );
+      }
+      break;
+    case CONTROL_COMMAND_SET_KIT_CONFIG:
+      if( data_size != 2 ) {
+        mControlSocket.Reply( CONTROL_STATUS_BAD_LENGTH );
+      } else if( ptr_data[ 0 ] >= mStageKitManager.AmountOfStageKits() || ptr_data[ 1 ] >= LIGHTSSETTINGS_STAGEKIT_CONFIGS ) {
+        mControlSocket.Reply( CONTROL_STATUS_FAILED );
+      } else {
+        MSG_RPLC_INFO( "Setting Stage Kit [ " << +ptr_data[ 0 ] << " ] to config [ " << +ptr_data[ 1 ] << " ]" );
+        mStageKitManager.SetConfigIDForStageKit( ptr_data[ 0 ], ptr_data[ 1 ] );
+        mControlSocket.Reply( CONTROL_STATUS_OK );
+      }
+      break;
+    case CONTROL_COMMAND_CUE:
+      // Taken the same as cues from the game.
+      if( data_size == 0 || data_size % 2 != 0 ) {
+        mControlSocket.Reply( CONTROL_STATUS_BAD_LENGTH );
+      } else {
+        for( uint32_t cue = 0; cue < data_size; cue += 2 ) {
+          this->Handle_RumbleData( ptr_data[ cue ], ptr_data[ cue + 1 ] );
+        }
+        mControlSocket.Reply( CONTROL_STATUS_OK );
+      }
+      break;
+    case CONTROL_COMMAND_GET_STATE: {
+      ControlState state;
+      memset( &state, 0, sizeof( state ) );
+      state.m_profile         = m_leds_ini_number;
+      state.m_profile_amount  = mLEDS.GetAmountProfiles();
+      state.m_red             = m_stagekit_colour_red;
+      state.m_green           = m_stagekit_colour_green;
+      state.m_blue            = m_stagekit_colour_blue;
+      state.m_yellow          = m_stagekit_colour_yellow;
+      state.m_strobe_speed    = m_leds_strobe_speed_current;
+      state.m_fog_on          = mStageKitManager.IsFogOn();
+      state.m_stagekit_amount = mStageKitManager.AmountOfStageKits();
+      for( uint8_t stagekit_id = 0; stagekit_id < state.m_stagekit_amount && stagekit_id < 4; stagekit_id++ ) {
+        state.m_stagekit_config[ stagekit_id ] = mStageKitManager.GetConfigIDForStageKit( stagekit_id );
+      }
+      mControlSocket.Reply( CONTROL_STATUS_OK, &state, sizeof( state ) );
+      break;
+    }
+    case CONTROL_COMMAND_GET_STATS: {
+      ALLOC_SCOPE( "control" );
+      std::string text;
+      Metrics::Export( text );
+      mControlSocket.Reply( CONTROL_STATUS_OK, text.data(), text.size() );
+      break;
+    }
+    case CONTROL_COMMAND_GET_RECORDING: {
+      ControlCueRecord records[ CUERECORDER_CUES ];
+      const uint32_t amount = mCueRecorder.Copy( records );
+      mControlSocket.Reply( CONTROL_STATUS_OK, records, amount * sizeof( ControlCueRecord ) );
+      break;
+    }
+    default:
+      mControlSocket.Reply( CONTROL_STATUS_UNKNOWN_COMMAND );
+      break;
+  }
+};
+
+void RpiLightsController::ApplySettings( const LightsSettings& settings ) {
+  m_settings = settings;
+
+  m_sleeptime_idle        = settings.m_sleeptime_idle;
+  m_sleeptime_stagekit    = settings.m_sleeptime_stagekit;
+  m_sleeptime_strobe      = settings.m_sleeptime_strobe;
+
+  // First, so render threads started below pick it up.
+  Realtime::Set( settings.m_realtime );
+  if( !Realtime::Apply( REALTIME_ROLE_MAIN ) ) {
+    MSG_RPLC_ERROR( "Realtime scheduling not allowed, run as root or give skp CAP_SYS_NICE." );
+  }
+
+  m_leds_strobe_enabled   = settings.m_leds_strobe_enabled;
+  for( int rate = 0; rate < 4; rate++ ) {
+    m_leds_strobe_rate[ rate ] = settings.m_leds_strobe_rate[ rate ];
+  }
+
+  mLEDZones.SetFade( settings.m_leds_frame_rate, settings.m_leds_fade_in_ms, settings.m_leds_fade_out_ms );
+  mLEDZones.SetHighDepth( settings.m_leds_high_depth );
+  mLEDZones.SetRenderThreads( settings.m_leds_render_threads );
+  if( !mLEDS.SetRemap( settings.m_leds_remap ) ) {
+    MSG_RPLC_ERROR( "LED REMAP not used, LEDs are sent as numbered." );
+  }
+
+  m_nodata_ms             = settings.m_nodata_ms;
+  m_nodata_red            = settings.m_nodata_red;
+  m_nodata_green          = settings.m_nodata_green;
+  m_nodata_blue           = settings.m_nodata_blue;
+  m_nodata_brightness     = settings.m_nodata_brightness;
+
+  for( uint8_t config_id = 1; config_id < LIGHTSSETTINGS_STAGEKIT_CONFIGS; config_id++ ) {
+    if( !settings.m_stagekit_config_set[ config_id ] ) {
+      MSG_RPLC_INFO( "INI section 'STAGEKIT_CONFIG_" << +config_id << "' not found - Using default settings." );
+      continue;
+    }
+
+    const StageKitConfig& config = settings.m_stagekit_config[ config_id ];
+    mStageKitManager.ConfigEnableLights( config_id, config.m_light_pod_enabled );
+    mStageKitManager.ConfigEnableStrobe( config_id, config.m_strobe_enabled );
+    mStageKitManager.ConfigEnableFog( config_id, config.m_fog_enabled );
+    mStageKitManager.ConfigSetFogTimes( config_id, config.m_fog_instance_time_max_ms, config.m_fog_total_time_max_ms );
+    mLEDZones.SetConfig( config_id, config.m_light_pod_enabled, config.m_strobe_enabled );
+  }
+
+  if( !mMetricsExporter.Start( settings.m_metrics ) ) {
+    MSG_RPLC_ERROR( "Unable to start the metrics export thread." );
+  }
+};
+
+void RpiLightsController::LoadLEDZones( const std::string& leds_path ) {
+  std::string section_name;
+
+  for( int zone = 1; ; zone++ ) {
+    section_name = "LEDS_ZONE_";
+    section_name += std::to_string( zone );
+
+    if( !mINI_Handler.SetSection( section_name ) ) {
+      break;
+    }
+
+    if( mINI_Handler.GetTokenValue( "ENABLED" ) != 1 ) {
+      continue;
+    }
+
+    std::string led_type;
+    if( mINI_Handler.TokenExists( "TYPE" ) ) {
+      led_type = mINI_Handler.GetTokenString( "TYPE" );
+    }
+    std::string led_remap;
+    if( mINI_Handler.TokenExists( "REMAP" ) ) {
+      led_remap = mINI_Handler.GetTokenString( "REMAP" );
+    }
+    int config_id = 0;
+    if( mINI_Handler.TokenExists( "CONFIG" ) ) {
+      config_id = mINI_Handler.GetTokenValue( "CONFIG" );
+    }
+
+    if( !mLEDZones.Add( section_name, led_type, mINI_Handler.GetTokenString( "DEVICE" ), mINI_Handler.GetTokenValue( "LED_AMOUNT" ),
+                        leds_path + mINI_Handler.GetTokenString( "INI" ), led_remap, config_id ) ) {
+      MSG_RPLC_ERROR( "LED zone " << section_name << " not used." );
+    }
+  }
+
+  if( mLEDZones.GetAmountZones() > 1 ) {
+    MSG_RPLC_INFO( "Driving " << mLEDZones.GetAmountZones() << " LED zones." );
+  }
+};
+
+void RpiLightsController::Handle_ConfigReload() {
+  // Only swaps pointers & copies values, the loading was done on the reload thread.
+  std::unique_ptr<LEDProfile> profile = mConfigReloader.TakeProfile();
+
+  while( profile ) {
+    const int profile_id = profile->GetID();
+
+    mConfigReloader.Retire( mLEDS.ReplaceProfile( std::move( profile ) ) );
+
+    if( profile_id == mLEDS.GetProfile() ) {
+      mLEDS.Render( m_stagekit_colour_red, m_stagekit_colour_green, m_stagekit_colour_blue, m_stagekit_colour_yellow );
+    }
+    MSG_RPLC_INFO( "LED profile INI" << profile_id + 1 << " reloaded." );
+
+    profile = mConfigReloader.TakeProfile();
+  }
+
+  LightsSettings settings;
+  if( mConfigReloader.TakeSettings( &settings ) ) {
+    this->ApplySettings( settings );
+    MSG_RPLC_INFO( "Settings reloaded." );
+  }
+};
+
 void RpiLightsController::Stagekit_ResetVariables() {
   m_stagekit_colour_red       = 0;
   m_stagekit_colour_green     = 0;
@@ -468,11 +708,57 @@ void RpiLightsController::StageKit_PollButtons( long time_passed_in_ms ) {
           mStageKitManager.SetConfigIDForStageKit( stagekit_id, config_id );
           MSG_RPLC_DEBUG( "Setting Stage Kit [ " << +stagekit_id << " ] to config [ " << +config_id << " ]" );
         }
+        this->StageKit_HandleProfileButtons( buttons );
       }
     }
   }
 };
 
+void RpiLightsController::StageKit_HandleProfileButtons( const uint16_t buttons ) {
+  int step = 0;
+
+  if( ( buttons & ( SKBUTTON::SK_BUTTON_RIGHT | SKBUTTON::SK_BUTTON_A ) ) != 0 ) {
+    step = 1;
+  } else if( ( buttons & ( SKBUTTON::SK_BUTTON_LEFT | SKBUTTON::SK_BUTTON_B ) ) != 0 ) {
+    step = -1;
+  } else if( ( buttons & SKBUTTON::SK_BUTTON_UP ) != 0 ) {
+    this->SelectLEDProfile( m_leds_ini_default );
+    return;
+  } else {
+    return;
+  }
+
+  // Step round to the next profile that loaded.
+  int profile_number = m_leds_ini_number;
+  for( int i = 0; i < m_leds_ini_amount; i++ ) {
+    profile_number += step;
+    if( profile_number > m_leds_ini_amount ) {
+      profile_number = 1;
+    } else if( profile_number < 1 ) {
+      profile_number = m_leds_ini_amount;
+    }
+
+    if( this->SelectLEDProfile( profile_number ) ) {
+      return;
+    }
+  }
+};
+
+bool RpiLightsController::SelectLEDProfile( const int profile_number ) {
+  if( !mLEDS.SelectProfile( profile_number - 1 ) ) {
+    return false;
+  }
+
+  m_leds_ini_number = profile_number;
+
+  MSG_RPLC_INFO( "LED profile INI" << profile_number << " selected." );
+
+  // Redraw what the stage kit is currently showing.  The strobe picks the profile up on its next flash.
+  mLEDS.Render( m_stagekit_colour_red, m_stagekit_colour_green, m_stagekit_colour_blue, m_stagekit_colour_yellow );
+
+  return true;
+};
+
 bool RpiLightsController::Handle_StagekitConnect() {
   // If already connected then reset the connection
   if( mStageKitManager.IsConnected() ) {
@@ -520,7 +806,7 @@ void RpiLightsController::Handle_StagekitDisconnect() {
   this->Stagekit_ResetVariables();
 };
 
-bool RpiLightsController::Handle_SerialConnect() {
+bool RpiLightsController::Handle_SerialConnect( const bool is_starting ) {
   if( !mStageKitManager.IsConnected() ) {
     MSG_RPLC_ERROR( "A USB SK360 POD needs to be connected before starting the Serial Adapter." );
     return false;
@@ -534,16 +820,43 @@ bool RpiLightsController::Handle_SerialConnect() {
 
     bool surpress_warnings = mINI_Handler.GetTokenValue( "SURPRESS_WARNINGS" ) > 0 ? true : false;
 
-    std::string serial_port = mINI_Handler.GetTokenString( "SERIAL_PORT_1" );
-    MSG_RPLC_INFO( "Attempting Serial Adapter connection on '" << serial_port << "'" );
+    std::vector<std::string> serial_ports = { mINI_Handler.GetTokenString( "SERIAL_PORT_1" ),
+                                              mINI_Handler.GetTokenString( "SERIAL_PORT_2" ) };
+
+    if( m_serial_auto_discover ) {
+      // Probe every port at once rather than waiting out a full handshake on each.
+      std::string serial_port;
+      if( is_starting ) {
+        SerialDiscovery discovery;
+        discovery.ScanPorts( serial_ports );
+        serial_port = discovery.FindAdapter( m_serial_probe_timeout_ms );
+      } else if( !mSerialDiscovery.TakeResult( &serial_port ) ) {
+        // From the main loop the search runs on its own thread, a later attempt picks up what it found.
+        if( mSerialDiscovery.StartSearch( serial_ports, m_serial_probe_timeout_ms ) ) {
+          MSG_RPLC_DEBUG( "Searching the serial ports for the Serial Adapter." );
+        }
+        return false;
+      }
 
-    if( !mSerialAdapter.Init( serial_port.c_str(), surpress_warnings ) ) {
-      serial_port = mINI_Handler.GetTokenString( "SERIAL_PORT_2" );
-      MSG_RPLC_INFO( "Attempting Serial Adapter connection on '" << serial_port << "'" );
-      if( !mSerialAdapter.Init( serial_port.c_str(), surpress_warnings ) ) {
-        MSG_RPLC_ERROR( "Unable to find a connected Serial Adapter." );
+      if( serial_port.empty() ) {
+        MSG_RPLC_ERROR( "Unable to find a connected Serial Adapter on any serial port." );
         return false;
       }
+      serial_ports = { serial_port };
+    }
+
+    bool connected = false;
+    for( const std::string& serial_port : serial_ports ) {
+      MSG_RPLC_INFO( "Attempting Serial Adapter connection on '" << serial_port << "'" );
+      if( mSerialAdapter.Init( serial_port.c_str(), surpress_warnings ) ) {
+        connected = true;
+        break;
+      }
+    }
+
+    if( !connected ) {
+      MSG_RPLC_ERROR( "Unable to find a connected Serial Adapter." );
+      return false;
     }
     MSG_RPLC_INFO( "Connected to Serial Adapter." );
 
@@ -560,52 +873,66 @@ void RpiLightsController::Handle_SerialDisconnect() {
 };
 
 void RpiLightsController::Handle_RumbleData( uint8_t left_weight, uint8_t right_weight ) {
+  mCueRecorder.Record( left_weight, right_weight );
+
   switch( right_weight ) {
     case SKRUMBLEDATA::SK_LED_RED:
+      m_ptr_cues[ RPLC_CUE_RED ]->Add();
       MSG_RPLC_DEBUG( "RED LED" );
       this->Handle_LEDUpdate( left_weight, SKRUMBLEDATA::SK_LED_RED);
       break;
    case SKRUMBLEDATA::SK_LED_GREEN:
+      m_ptr_cues[ RPLC_CUE_GREEN ]->Add();
       MSG_RPLC_DEBUG( "GREEN LED" );
       this->Handle_LEDUpdate( left_weight, SKRUMBLEDATA::SK_LED_GREEN);
       break;
     case SKRUMBLEDATA::SK_LED_BLUE:
+      m_ptr_cues[ RPLC_CUE_BLUE ]->Add();
       MSG_RPLC_DEBUG( "BLUE LED" );
       this->Handle_LEDUpdate( left_weight, SKRUMBLEDATA::SK_LED_BLUE);
       break;
     case SKRUMBLEDATA::SK_LED_YELLOW:
+      m_ptr_cues[ RPLC_CUE_YELLOW ]->Add();
       MSG_RPLC_DEBUG( "YELLLOW LED" );
       this->Handle_LEDUpdate( left_weight, SKRUMBLEDATA::SK_LED_YELLOW);
       break;
     case SKRUMBLEDATA::SK_FOG_ON:
+      m_ptr_cues[ RPLC_CUE_FOG_ON ]->Add();
       MSG_RPLC_DEBUG( "FOG ON" );
       this->Handle_FogUpdate( true );
       break;
     case SKRUMBLEDATA::SK_FOG_OFF:
+      m_ptr_cues[ RPLC_CUE_FOG_OFF ]->Add();
       MSG_RPLC_DEBUG( "FOG OFF" );
       this->Handle_FogUpdate( false );
       break;
     case SKRUMBLEDATA::SK_STROBE_OFF:
+      m_ptr_cues[ RPLC_CUE_STROBE_OFF ]->Add();
       MSG_RPLC_DEBUG( "Strobe OFF" );
       this->Handle_StrobeUpdate( 0 );
       break;
     case SKRUMBLEDATA::SK_STROBE_SPEED_1:
+      m_ptr_cues[ RPLC_CUE_STROBE_1 ]->Add();
       MSG_RPLC_DEBUG( "Strobe - Speed 1" );
       this->Handle_StrobeUpdate( 1 );
       break;
     case SKRUMBLEDATA::SK_STROBE_SPEED_2:
+      m_ptr_cues[ RPLC_CUE_STROBE_2 ]->Add();
       MSG_RPLC_DEBUG( "Strobe - Speed 2" );
       this->Handle_StrobeUpdate( 2 );
       break;
     case SKRUMBLEDATA::SK_STROBE_SPEED_3:
+      m_ptr_cues[ RPLC_CUE_STROBE_3 ]->Add();
       MSG_RPLC_DEBUG( "Strobe - Speed 3" );
       this->Handle_StrobeUpdate( 3 );
       break;
     case SKRUMBLEDATA::SK_STROBE_SPEED_4:
+      m_ptr_cues[ RPLC_CUE_STROBE_4 ]->Add();
       MSG_RPLC_DEBUG( "Strobe - Speed 4" );
       this->Handle_StrobeUpdate( 4 );
       break;
     case SKRUMBLEDATA::SK_ALL_OFF:
+      m_ptr_cues[ RPLC_CUE_ALL_OFF ]->Add();
       // I suspect all off includes fog & strobe.
       MSG_RPLC_DEBUG( "ALL OFF - LEDS & STROBE - " );
       this->Handle_LEDUpdate( SKRUMBLEDATA::SK_NONE, SKRUMBLEDATA::SK_ALL_OFF );
@@ -613,6 +940,7 @@ void RpiLightsController::Handle_RumbleData( uint8_t left_weight, uint8_t right_
       this->Handle_FogUpdate( false );
       break;
     default:
+      m_ptr_cues[ RPLC_CUE_UNKNOWN ]->Add();
       MSG_RPLC_INFO( "Unhandled stagekit data received : " << right_weight );
       break;
   }
@@ -648,7 +976,7 @@ void RpiLightsController::Handle_LEDUpdate( const uint8_t leds, const uint8_t co
       break;
   }
 
-  mLEDS.SetLights( colour, leds );
+  mLEDZones.SetLights( colour, leds );
 
   mStageKitManager.SetLights( leds, colour );
 };
@@ -663,7 +991,7 @@ void RpiLightsController::Handle_StrobeUpdate( const uint8_t strobe_speed ) {
 
   if( strobe_speed == 0  ) {
     m_leds_strobe_next_on_ms = 0;
-    mLEDS.Strobe( false );
+    mLEDZones.Strobe( false );
   }
 
   mStageKitManager.SetStrobe( strobe_speed );
@@ -680,10 +1008,11 @@ long RpiLightsController::Handle_TimeUpdate( long time_passed_ms ) {
     if( time_passed_ms < m_leds_strobe_next_on_ms ) {
       m_leds_strobe_next_on_ms -= time_passed_ms;
     } else {
-      mLEDS.Strobe( true );
+      mLEDZones.Strobe( true );
       m_leds_strobe_next_on_ms += m_leds_strobe_rate[ m_leds_strobe_speed_current - 1 ];
       m_leds_strobe_next_on_ms -= time_passed_ms;
-      mLEDS.Strobe( false );
+      mLEDZones.Strobe( false );
+      m_ptr_strobe_edges->Add( 2 );
     }
 
     // How long till the strobe needs to be checked?
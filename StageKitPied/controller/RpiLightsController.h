@@ -1,37 +1,73 @@
 #ifndef _RPILIGHTSCONTROLLER_H_
 #define _RPILIGHTSCONTROLLER_H_
 
-#ifdef DEBUG
-  #define MSG_RPLC_DEBUG( str ) do { std::cout << "RpiLightsController : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_RPLC_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_RPLC_DEBUG( str ) LOG_DEBUG( "RpiLightsController", str )
 
-#define MSG_RPLC_ERROR( str ) do { std::cout << "RpiLightsController : ERROR : " << str << std::endl; } while( false )
-#define MSG_RPLC_INFO( str ) do { std::cout << "RpiLightsController : INFO : " << str << std::endl; } while( false )
+#define MSG_RPLC_ERROR( str ) LOG_ERROR( "RpiLightsController", str )
+#define MSG_RPLC_INFO( str ) LOG_INFO( "RpiLightsController", str )
 
 //
 #include <iostream>
 #include <string>
+#include <vector>
 #include <cstdlib>  // system
 #include <cstring>  // memcpy
+#include <sstream>  // stringstream
 #include <unistd.h> // readlink
 #include <libgen.h> // dirname
 
 //
 #include "helpers/INI_Handler.h"
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
+#include "helpers/MetricsExporter.h"
 #include "helpers/SleepTimer.h"
 #include "serial/SerialAdapter.h"
+#include "serial/SerialDiscovery.h"
+#include "controller/ConfigReloader.h"
+#include "controller/CueRecorder.h"
+#include "controller/LightsSettings.h"
 #include "stagekit/USB_ControlRequest.h"
 #include "stagekit/StageKitManager.h"
 #include "stagekit/StageKitConsts.h"
 #include "leds/LEDArray.h"
+#include "leds/LEDZones.h"
+#include "network/ControlSocket.h"
 #include "network/RB3E_Network.h"
 
 //
 #define USB_DIRECTION_IN 0x80
 #define ALIVE_CHECK_ITR 1                // Check clients
 #define ALIVE_CLEAR_ITR 20               // Remove clients
+#define SERIAL_RECONNECT_DELAY_MS 2000   // Time between serial adapter reconnect attempts
+#define SERIAL_DISCOVER_DELAY_MS  1000   // Same, when auto discovering.  The search runs on its own thread, this picks up its result.
+
+// Cues counted for metrics, by what they asked for.
+enum RPLC_CUE {
+  RPLC_CUE_RED,
+  RPLC_CUE_GREEN,
+  RPLC_CUE_BLUE,
+  RPLC_CUE_YELLOW,
+  RPLC_CUE_FOG_ON,
+  RPLC_CUE_FOG_OFF,
+  RPLC_CUE_STROBE_OFF,
+  RPLC_CUE_STROBE_1,
+  RPLC_CUE_STROBE_2,
+  RPLC_CUE_STROBE_3,
+  RPLC_CUE_STROBE_4,
+  RPLC_CUE_ALL_OFF,
+  RPLC_CUE_UNKNOWN,
+  RPLC_CUES
+};
+
+// Which sleep time the main loop last went with.
+enum RPLC_SLEEP_TIER {
+  RPLC_SLEEP_TIER_IDLE,
+  RPLC_SLEEP_TIER_STAGEKIT,
+  RPLC_SLEEP_TIER_STROBE,
+  RPLC_SLEEP_TIER_FRAME,    // Cut short for a fade or dither frame.
+  RPLC_SLEEP_TIERS
+};
 
 class RpiLightsController {
 public:
@@ -45,6 +81,9 @@ public:
 
   void Stop();
 
+  // Switches the LED array to another preloaded leds ini.  1 = INI1.
+  bool SelectLEDProfile( const int profile_number );
+
 private:
 
   void SerialAdapter_Poll();
@@ -52,20 +91,40 @@ private:
   void SerialAdapter_HandleControlData();
 
   void SerialAdapter_HandleOutReport();
+
+  void SerialAdapter_CheckConnection( const long time_passed_ms );
   
   void RB3ENetwork_Poll();
 
+  // Commands from the control socket, a few each pass.
+  void ControlSocket_Poll();
+
+  void ControlSocket_HandleCommand();
+
+  // Takes on settings read from lights.ini, at start up & on reload.
+  void ApplySettings( const LightsSettings& settings );
+
+  // [LEDS_ZONE_1], [LEDS_ZONE_2]... extra LED arrays, each with its own device & leds ini.
+  void LoadLEDZones( const std::string& leds_path );
+
   void Stagekit_ResetVariables();
 
   void StageKit_PollButtons( const long time_passed_ms );
 
+  // D-pad right or A = next LED profile, left or B = previous, up = INI_DEFAULT.
+  void StageKit_HandleProfileButtons( const uint16_t buttons );
+
   long Handle_TimeUpdate( const long time_passed_ms );
 
+  // Picks up anything the reloader has finished loading.
+  void Handle_ConfigReload();
+
   bool Handle_StagekitConnect();
 
   void Handle_StagekitDisconnect();
 
-  bool Handle_SerialConnect();
+  // is_starting waits for auto discovery, otherwise it runs on its own thread & is picked up by a later call.
+  bool Handle_SerialConnect( const bool is_starting );
 
   void Handle_SerialDisconnect();
 
@@ -78,10 +137,22 @@ private:
   void Handle_StrobeUpdate( const uint8_t strobe_speed );
 
   SerialAdapter      mSerialAdapter;
+  SerialDiscovery    mSerialDiscovery;
   StageKitManager    mStageKitManager;
   LEDArray           mLEDS;
+  LEDZones           mLEDZones;           // mLEDS & any LEDS_ZONE_ arrays, light changes & frames go through here.
   INI_Handler        mINI_Handler;
   RB3E_Network       mRB3E_Network;
+  ConfigReloader     mConfigReloader;
+  MetricsExporter    mMetricsExporter;
+  ControlSocket      mControlSocket;
+  CueRecorder        mCueRecorder;
+
+  std::string        m_lights_ini_file;
+  LightsSettings     m_settings;           // In use
+  bool               m_reload_enabled;
+  bool               m_control_enabled;
+  std::string        m_control_socket;
   
   bool               m_rb3e_listener_enabled;
   bool               m_rb3e_sender_enabled;
@@ -93,6 +164,10 @@ private:
   USB_ControlRequest m_control_request;
   unsigned char*     m_ptr_control_request_data;
   bool               m_serial_connected_to_x360;
+  bool               m_serial_reconnect;
+  long               m_serial_reconnect_delay_ms;
+  bool               m_serial_auto_discover;
+  int                m_serial_probe_timeout_ms;
 
   uint8_t            m_stagekit_default_config;
 
@@ -114,7 +189,10 @@ private:
   bool               m_leds_enabled;
   std::string*       m_leds_ini;
   uint16_t           m_leds_ini_amount;
-  uint8_t            m_leds_ini_number;
+  uint8_t            m_leds_ini_number;   // Profile in use
+  uint8_t            m_leds_ini_default;
+  std::vector<std::string> m_leds_ini_files;
+  int                m_leds_amount;
   
   bool               m_leds_strobe_enabled;
   uint16_t           m_leds_strobe_rate[ 4 ];
@@ -134,6 +212,13 @@ private:
   uint8_t            m_nodata_brightness;
   
   long               m_button_check_delay;
+
+  // Metrics
+  MetricCounter*     m_ptr_cues[ RPLC_CUES ];
+  MetricCounter*     m_ptr_strobe_edges;
+  MetricCounter*     m_ptr_sleep_ms[ RPLC_SLEEP_TIERS ];
+  MetricHistogram*   m_ptr_update_time;
+  RPLC_SLEEP_TIER    m_sleep_tier;
 };
 
 #endif
@@ -0,0 +1,145 @@
+#include "AllocTracker.h"
+
+#ifdef ALLOC_TRACKING
+#include <cerrno>  // ENOMEM, EINVAL
+#endif
+
+AllocTracker::Subsystem AllocTracker::s_subsystems[ ALLOCTRACKER_SUBSYSTEMS ];
+
+thread_local const char* AllocTracker::t_subsystem = NULL;
+
+bool AllocTracker::IsEnabled() {
+#ifdef ALLOC_TRACKING
+  return true;
+#else
+  return false;
+#endif
+};
+
+void AllocTracker::Reset() {
+  for( int index = 0; index < ALLOCTRACKER_SUBSYSTEMS; index++ ) {
+    s_subsystems[ index ].m_amount = 0;
+    s_subsystems[ index ].m_bytes  = 0;
+  }
+};
+
+uint64_t AllocTracker::GetAmount() {
+  uint64_t amount = 0;
+
+  for( int index = 0; index < ALLOCTRACKER_SUBSYSTEMS; index++ ) {
+    amount += s_subsystems[ index ].m_amount;
+  }
+
+  return amount;
+};
+
+int AllocTracker::GetAmountSubsystems() {
+  return ALLOCTRACKER_SUBSYSTEMS;
+};
+
+const char* AllocTracker::GetSubsystemName( const int index ) {
+  const char* name = s_subsystems[ index ].m_name;
+  return name != NULL ? name : "other";
+};
+
+uint64_t AllocTracker::GetSubsystemAmount( const int index ) {
+  return s_subsystems[ index ].m_amount;
+};
+
+uint64_t AllocTracker::GetSubsystemBytes( const int index ) {
+  return s_subsystems[ index ].m_bytes;
+};
+
+void AllocTracker::Report() {
+  if( !IsEnabled() ) {
+    MSG_ALLOCTRACKER_INFO( "Not built in, make with ALLOC_TRACKING=1 to count allocations." );
+    return;
+  }
+
+  MSG_ALLOCTRACKER_INFO( "Allocations " << GetAmount() << " :" );
+
+  for( int index = 0; index < ALLOCTRACKER_SUBSYSTEMS; index++ ) {
+    if( s_subsystems[ index ].m_amount > 0 ) {
+      MSG_ALLOCTRACKER_INFO( "  " << GetSubsystemName( index ) << " : " << s_subsystems[ index ].m_amount << " ("
+                             << s_subsystems[ index ].m_bytes << " bytes)" );
+    }
+  }
+};
+
+const char* AllocTracker::SetSubsystem( const char* name ) {
+  const char* previous = t_subsystem;
+  t_subsystem = name;
+  return previous;
+};
+
+void AllocTracker::Count( const size_t size ) {
+  const char* name = t_subsystem;
+
+  // Slot 0 is other, the rest are claimed by the first allocation under each name.
+  int slot = 0;
+  if( name != NULL ) {
+    for( int index = 1; index < ALLOCTRACKER_SUBSYSTEMS; index++ ) {
+      const char* slot_name = s_subsystems[ index ].m_name;
+      if( slot_name == name ) {
+        slot = index;
+        break;
+      }
+      if( slot_name == NULL ) {
+        const char* empty = NULL;
+        if( s_subsystems[ index ].m_name.compare_exchange_strong( empty, name ) || empty == name ) {
+          slot = index;
+          break;
+        }
+      }
+    }
+  }
+
+  s_subsystems[ slot ].m_amount.fetch_add( 1, std::memory_order_relaxed );
+  s_subsystems[ slot ].m_bytes.fetch_add( size, std::memory_order_relaxed );
+};
+
+#ifdef ALLOC_TRACKING
+// glibc's own allocators, under the names it keeps for this.  Interposing these covers new, std::string & the rest.
+extern "C" {
+  void* __libc_malloc( size_t size );
+  void* __libc_calloc( size_t amount, size_t size );
+  void* __libc_realloc( void* ptr, size_t size );
+  void* __libc_memalign( size_t alignment, size_t size );
+
+  void* malloc( size_t size ) {
+    AllocTracker::Count( size );
+    return __libc_malloc( size );
+  };
+
+  void* calloc( size_t amount, size_t size ) {
+    AllocTracker::Count( amount * size );
+    return __libc_calloc( amount, size );
+  };
+
+  void* realloc( void* ptr, size_t size ) {
+    AllocTracker::Count( size );
+    return __libc_realloc( ptr, size );
+  };
+
+  void* memalign( size_t alignment, size_t size ) {
+    AllocTracker::Count( size );
+    return __libc_memalign( alignment, size );
+  };
+
+  void* aligned_alloc( size_t alignment, size_t size ) {
+    AllocTracker::Count( size );
+    return __libc_memalign( alignment, size );
+  };
+
+  int posix_memalign( void** ptr, size_t alignment, size_t size ) {
+    if( alignment < sizeof( void* ) || ( alignment & ( alignment - 1 ) ) != 0 ) {
+      return EINVAL;
+    }
+
+    AllocTracker::Count( size );
+    *ptr = __libc_memalign( alignment, size );
+
+    return *ptr != NULL ? 0 : ENOMEM;
+  };
+}
+#endif
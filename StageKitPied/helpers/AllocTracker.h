@@ -0,0 +1,80 @@
+#ifndef _ALLOCTRACKER_H_
+#define _ALLOCTRACKER_H_
+
+#define MSG_ALLOCTRACKER_INFO( str ) LOG_INFO( "AllocTracker", str )
+
+#define ALLOCTRACKER_SUBSYSTEMS 16  // Names past this are counted as "other".
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "helpers/Log.h"
+
+// Counts heap allocations, by the subsystem each thread says it's in.  Only built in with make ALLOC_TRACKING=1,
+// which interposes malloc, calloc, realloc & the aligned allocators.  new & delete go through those too.
+// Without it ALLOC_SCOPE compiles to nothing & IsEnabled is false.
+#ifdef ALLOC_TRACKING
+  #define ALLOC_SCOPE( name ) AllocScope alloc_scope_( name )
+#else
+  #define ALLOC_SCOPE( name ) do { } while( false )
+#endif
+
+class AllocTracker {
+public:
+  // True when built with ALLOC_TRACKING.
+  static bool IsEnabled();
+
+  // Zeroes every count, such as once start up is done.
+  static void Reset();
+
+  // Allocations since the last Reset.
+  static uint64_t GetAmount();
+
+  static int GetAmountSubsystems();
+
+  static const char* GetSubsystemName( const int index );
+
+  static uint64_t GetSubsystemAmount( const int index );
+
+  static uint64_t GetSubsystemBytes( const int index );
+
+  // Every subsystem that allocated.
+  static void Report();
+
+  // Subsystem of the calling thread, name must be a string literal.  NULL is "other".
+  static const char* SetSubsystem( const char* name );
+
+  // From the interposed allocators.
+  static void Count( const size_t size );
+
+private:
+  struct Subsystem
+  {
+    std::atomic<const char*> m_name;
+    std::atomic<uint64_t>    m_amount;
+    std::atomic<uint64_t>    m_bytes;
+  };
+
+  static Subsystem s_subsystems[ ALLOCTRACKER_SUBSYSTEMS ];
+
+  static thread_local const char* t_subsystem;
+};
+
+// Sets the calling thread's subsystem until the end of the scope.
+class AllocScope {
+public:
+  AllocScope( const char* name ) {
+    m_ptr_previous = AllocTracker::SetSubsystem( name );
+  };
+
+  ~AllocScope() {
+    AllocTracker::SetSubsystem( m_ptr_previous );
+  };
+
+private:
+  const char* m_ptr_previous;
+};
+
+#endif
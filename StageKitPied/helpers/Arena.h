@@ -0,0 +1,81 @@
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <cstddef>
+#include <cstring>     // memcpy
+#include <memory>      // unique_ptr
+#include <new>         // placement new
+#include <string_view>
+#include <type_traits>
+#include <utility>     // forward
+#include <vector>
+
+#define ARENA_DEFAULT_BLOCK_SIZE 16384
+
+// Bump allocator for data that lives & dies together, like everything parsed from one file.
+// Objects are never destroyed one by one, so only trivially destructible types may be stored.
+class Arena
+{
+public:
+  Arena( const size_t block_size = ARENA_DEFAULT_BLOCK_SIZE ) {
+    m_block_size = block_size;
+    m_block_used = 0;
+    m_block_capacity = 0;
+  };
+
+  ~Arena() {
+  };
+
+  Arena( const Arena& ) = delete;
+  Arena& operator=( const Arena& ) = delete;
+
+  void* Allocate( const size_t size, const size_t alignment ) {
+    size_t start = ( m_block_used + alignment - 1 ) & ~( alignment - 1 );
+
+    if( m_blocks.empty() || start + size > m_block_capacity ) {
+      // Oversized requests get a block of their own.
+      m_block_capacity = size > m_block_size ? size : m_block_size;
+      m_blocks.emplace_back( new char[ m_block_capacity ] );
+      start = 0;
+    }
+
+    m_block_used = start + size;
+
+    return m_blocks.back().get() + start;
+  };
+
+  template< typename T, typename... Args >
+  T* New( Args&&... args ) {
+    static_assert( std::is_trivially_destructible<T>::value, "Arena objects are never destroyed." );
+
+    return new( this->Allocate( sizeof( T ), alignof( T ) ) ) T( std::forward<Args>( args )... );
+  };
+
+  // Copies text into the arena, the view stays valid until Clear.
+  std::string_view Copy( const std::string_view text ) {
+    if( text.empty() ) {
+      return std::string_view();
+    }
+
+    char* ptr_text = static_cast<char*>( this->Allocate( text.size(), 1 ) );
+    memcpy( ptr_text, text.data(), text.size() );
+
+    return std::string_view( ptr_text, text.size() );
+  };
+
+  // Releases everything.  All pointers & views from this arena are invalid afterwards.
+  void Clear() {
+    m_blocks.clear();
+    m_block_used = 0;
+    m_block_capacity = 0;
+  };
+
+private:
+  std::vector< std::unique_ptr<char[]> > m_blocks;
+  size_t m_block_size;
+  size_t m_block_used;     // Bytes used in the last block.
+  size_t m_block_capacity; // Size of the last block.
+
+};
+
+#endif
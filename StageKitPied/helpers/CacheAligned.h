@@ -0,0 +1,46 @@
+#ifndef _CACHEALIGNED_H_
+#define _CACHEALIGNED_H_
+
+#define CACHE_LINE_BYTES 64  // Pi 3, 4 & 5, & most everything else.
+
+#include <cstddef>
+#include <new>     // align_val_t
+#include <vector>
+
+// Allocator starting every block on a cache line.  For buffers split between threads, so parts that start on a
+// line boundary never share a line with another thread's part.
+template< typename T >
+struct CacheAlignedAllocator
+{
+  typedef T value_type;
+
+  CacheAlignedAllocator() {
+  };
+
+  template< typename U >
+  CacheAlignedAllocator( const CacheAlignedAllocator<U>& ) {
+  };
+
+  T* allocate( const size_t amount ) {
+    return static_cast<T*>( ::operator new( amount * sizeof( T ), std::align_val_t( CACHE_LINE_BYTES ) ) );
+  };
+
+  void deallocate( T* ptr, const size_t ) {
+    ::operator delete( ptr, std::align_val_t( CACHE_LINE_BYTES ) );
+  };
+
+  template< typename U >
+  bool operator==( const CacheAlignedAllocator<U>& ) const {
+    return true;
+  };
+
+  template< typename U >
+  bool operator!=( const CacheAlignedAllocator<U>& ) const {
+    return false;
+  };
+};
+
+template< typename T >
+using CacheAlignedVector = std::vector< T, CacheAlignedAllocator<T> >;
+
+#endif
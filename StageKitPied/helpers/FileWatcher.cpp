@@ -0,0 +1,121 @@
+#include "FileWatcher.h"
+
+FileWatcher::FileWatcher() {
+  m_fd = -1;
+};
+
+FileWatcher::~FileWatcher() {
+  this->Close();
+};
+
+bool FileWatcher::Init() {
+  this->Close();
+
+  m_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+  if( m_fd == -1 ) {
+    MSG_FILEWATCHER_ERROR( "inotify_init1 failed : " << strerror( errno ) );
+    return false;
+  }
+
+  return true;
+};
+
+bool FileWatcher::AddFile( const std::string& file ) {
+  if( m_fd == -1 ) {
+    return false;
+  }
+
+  std::string directory = ".";
+  size_t slash = file.rfind( '/' );
+  if( slash != std::string::npos ) {
+    directory = file.substr( 0, slash );
+  }
+
+  // Same directory gives back the same descriptor.
+  int wd = inotify_add_watch( m_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+  if( wd == -1 ) {
+    MSG_FILEWATCHER_ERROR( "Unable to watch " << directory << " : " << strerror( errno ) );
+    return false;
+  }
+
+  m_directories[ wd ] = directory;
+
+  if( slash == std::string::npos ) {
+    m_files.insert( "./" + file );
+  } else {
+    m_files.insert( file );
+  }
+
+  MSG_FILEWATCHER_DEBUG( "Watching " << file );
+
+  return true;
+};
+
+bool FileWatcher::Wait( const int timeout_ms, std::vector<std::string>& changed_files ) {
+  if( m_fd == -1 ) {
+    return false;
+  }
+
+  struct pollfd poll_fd;
+  poll_fd.fd      = m_fd;
+  poll_fd.events  = POLLIN;
+  poll_fd.revents = 0;
+
+  int ret = poll( &poll_fd, 1, timeout_ms );
+  if( ret == -1 ) {
+    return errno == EINTR;
+  }
+  if( ret == 0 ) {
+    return true;
+  }
+
+  alignas( struct inotify_event ) char buffer[ 4096 ];
+
+  while( true ) {
+    ssize_t bytes_read = read( m_fd, buffer, sizeof( buffer ) );
+    if( bytes_read <= 0 ) {
+      break;
+    }
+
+    for( char* ptr = buffer; ptr < buffer + bytes_read; ) {
+      const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>( ptr );
+      ptr += sizeof( struct inotify_event ) + event->len;
+
+      if( event->len == 0 ) {
+        continue;
+      }
+
+      auto directory = m_directories.find( event->wd );
+      if( directory == m_directories.end() ) {
+        continue;
+      }
+
+      std::string file = directory->second + "/" + event->name;
+      if( m_files.count( file ) == 0 ) {
+        continue;
+      }
+
+      bool listed = false;
+      for( const std::string& changed : changed_files ) {
+        if( changed == file ) {
+          listed = true;
+          break;
+        }
+      }
+      if( !listed ) {
+        changed_files.push_back( file );
+      }
+    }
+  }
+
+  return true;
+};
+
+void FileWatcher::Close() {
+  if( m_fd != -1 ) {
+    close( m_fd );
+    m_fd = -1;
+  }
+  m_directories.clear();
+  m_files.clear();
+};
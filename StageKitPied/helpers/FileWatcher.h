@@ -0,0 +1,46 @@
+#ifndef _FILEWATCHER_H_
+#define _FILEWATCHER_H_
+
+#define MSG_FILEWATCHER_DEBUG( str ) LOG_DEBUG( "FileWatcher", str )
+
+#define MSG_FILEWATCHER_ERROR( str ) LOG_ERROR( "FileWatcher", str )
+#define MSG_FILEWATCHER_INFO( str ) LOG_INFO( "FileWatcher", str )
+
+#include <cerrno>
+#include <cstring>  // strerror
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+#include "helpers/Log.h"
+
+// Reports when watched files have been written.
+// The directory is watched rather than the file, as editors tend to save by replacing the file.
+class FileWatcher {
+public:
+  FileWatcher();
+
+  ~FileWatcher();
+
+  bool Init();
+
+  bool AddFile( const std::string& file );
+
+  // Waits up to timeout_ms for watched files to change.  Changed files are added to changed_files, once each.
+  // Returns false on error.
+  bool Wait( const int timeout_ms, std::vector<std::string>& changed_files );
+
+  void Close();
+
+private:
+  int                          m_fd;
+  std::map<int, std::string>   m_directories;  // Watch descriptor to directory.
+  std::set<std::string>        m_files;
+};
+
+#endif
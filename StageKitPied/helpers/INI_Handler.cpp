@@ -2,6 +2,7 @@
 
 INI_Handler::INI_Handler() {
   // A few defaults.
+  m_ptr_file_buffer  = NULL;
   m_file_buffer_size = 0;
   m_section_start    = '[';
   m_section_end      = ']';
@@ -63,8 +64,7 @@ bool INI_Handler::Load( const std::string& filename ) {
   }
 
   // Generate a "default" section, which is our current section.
-  m_section_current = new INI_Section;
-  m_section_list.push_back( m_section_current );
+  m_section_current = this->AddSection( std::string_view() );
 
 
   MSG_INI_DEBUG( "About to process buffer." );
@@ -76,8 +76,7 @@ bool INI_Handler::Load( const std::string& filename ) {
     m_error_msg = "INI_Handler: Error process buffer.";
   }
 
-  // Clean up.
-  this->ClearBuffer();
+  // The buffer is kept, tokens view into it.
 
   // Return the result from the buffer process.
   return m_has_file_loaded;
@@ -87,7 +86,7 @@ bool INI_Handler::HasFileLoaded() {
   return m_has_file_loaded;
 }
 
-bool INI_Handler::CreateSection( const std::string& section_name ) {
+bool INI_Handler::CreateSection( std::string_view section_name ) {
   // Creates a new section with the given name.
   // If the section is already existing, then we just change to
   // that one.
@@ -95,39 +94,55 @@ bool INI_Handler::CreateSection( const std::string& section_name ) {
     return false;
   }
 
-  m_section_current = new INI_Section;
-  m_section_current->m_name = section_name;
-  m_section_list.push_back( m_section_current );
+  m_section_current = this->AddSection( m_arena.Copy( section_name ) );
 
   return true;
 }
 
-bool INI_Handler::DeleteSection( const std::string& section_name ) {
+INI_Section* INI_Handler::AddSection( std::string_view section_name ) {
+  INI_Section*& ptr_section = m_sections[ section_name ];
+
+  if( ptr_section == NULL ) {
+    ptr_section = new INI_Section;
+    ptr_section->m_name = section_name;
+    m_section_list.push_back( ptr_section );
+  }
+
+  return ptr_section;
+}
+
+bool INI_Handler::DeleteSection( std::string_view section_name ) {
   // If it is not a section, then it is removed already.
+  std::unordered_map< std::string_view, INI_Section* >::iterator section = m_sections.find( section_name );
+  if( section == m_sections.end() ) {
+    return false;
+  }
+
+  INI_Section* ptr_section = section->second;
+
+  if( m_section_current == ptr_section ) {
+    m_section_current = NULL;
+  }
+
+  m_sections.erase( section );
+
+  // Remove pointer from vector.
   std::vector< INI_Section* >::iterator itr    = m_section_list.begin();
   std::vector< INI_Section* >::iterator itrEnd = m_section_list.end();
   for( ; itr != itrEnd; itr++ ) {
-    if( (*itr)->m_name == section_name ) {
-      if( m_section_current != NULL ) {
-        if( m_section_current->m_name == section_name ) {
-          m_section_current = NULL;
-        }
-      }
-
-      // free the memory
-      delete (*itr);
-
-      // Remove pointer from vector.
+    if( (*itr) == ptr_section ) {
       m_section_list.erase( itr );
-
-      return true;
+      break;
     }
   }
 
-  return false;
+  // free the memory.  Its tokens stay in the arena until the next clear.
+  delete ptr_section;
+
+  return true;
 }
 
-bool INI_Handler::SetToken( const std::string& token_name, const std::string& token_value ) {
+bool INI_Handler::SetToken( std::string_view token_name, std::string_view token_value ) {
   // Ensure we are already in a section.
   if( m_section_current == NULL ) {
     return false;
@@ -138,19 +153,17 @@ bool INI_Handler::SetToken( const std::string& token_name, const std::string& to
 
   if( ptr_token == NULL ) {
     // Create token.
-    ptr_token               = new INI_Token;
-    ptr_token->m_name       = token_name;
+    ptr_token               = m_arena.New<INI_Token>();
+    ptr_token->m_name       = m_arena.Copy( token_name );
     ptr_token->m_linenumber = 0;  // No real need for a line number on create.
-    ptr_token->m_value      = token_value;
-    ptr_token->m_read       = false;
     m_section_current->m_tokenlist.push_back( ptr_token );
-
-  } else {
-    // Just update token values.
-    ptr_token->m_value = token_value;
-    ptr_token->m_read  = false;
+    m_section_current->m_tokens[ ptr_token->m_name ] = ptr_token;
   }
 
+  ptr_token->m_value  = m_arena.Copy( token_value );
+  ptr_token->m_number = ParseNumber( ptr_token->m_value );
+  ptr_token->m_read   = false;
+
   return true;
 }
 
@@ -158,15 +171,8 @@ std::string INI_Handler::GetErrorMessage() {
   return m_error_msg;
 }
 
-bool INI_Handler::FindSection( const std::string& section_name ) {
-  std::vector< INI_Section* >::iterator itr    = m_section_list.begin();
-  std::vector< INI_Section* >::iterator itrEnd = m_section_list.end();
-  for( ; itr != itrEnd; itr++ ) {
-    if( (*itr)->m_name == section_name ) {
-      return true;
-    }
-  }
-  return false;
+bool INI_Handler::FindSection( std::string_view section_name ) {
+  return m_sections.find( section_name ) != m_sections.end();
 }
 
 bool INI_Handler::SetSection( uint32_t section_number ) {
@@ -181,7 +187,7 @@ bool INI_Handler::SetSection( uint32_t section_number ) {
   return true;
 }
 
-bool INI_Handler::SetSection( const std::string& section_name ) {
+bool INI_Handler::SetSection( std::string_view section_name ) {
   if( m_section_current != NULL ) {
     // Avoid hunting around if we are already in it.
     if( m_section_current->m_name == section_name ) {
@@ -189,65 +195,55 @@ bool INI_Handler::SetSection( const std::string& section_name ) {
     }
   }
 
-  std::vector< INI_Section* >::iterator itr    = m_section_list.begin();
-  std::vector< INI_Section* >::iterator itrEnd = m_section_list.end();
-  for( ; itr != itrEnd; itr++ ) {
-    if( (*itr)->m_name == section_name ) {
-      m_section_current = (*itr);
-      return true;
-    }
+  std::unordered_map< std::string_view, INI_Section* >::iterator section = m_sections.find( section_name );
+  if( section == m_sections.end() ) {
+    return false;
   }
-  return false;
+
+  m_section_current = section->second;
+  return true;
 }
 
 std::string INI_Handler::GetSection() {
-  return m_section_current->m_name;
+  return std::string( m_section_current->m_name );
 }
 
-int INI_Handler::GetTokenValue( const std::string& token_name ) {
+int INI_Handler::GetTokenValue( std::string_view token_name ) {
   INI_Token* ptrTkn = this->GetToken( token_name );
 
   if( ptrTkn == NULL ) {
-    m_error_msg  = "Unable to find token '";
-    m_error_msg += token_name;
-    m_error_msg += "' in section ";
-    m_error_msg += m_section_current->m_name;
-
+    this->TokenNotFound( token_name );
     return 0;
   }
 
   ptrTkn->m_read = true;
 
-  return stoi( ptrTkn->m_value );
+  return ptrTkn->m_number;
 };
 
-bool INI_Handler::GetTokenBool( const std::string& token_name ) {
+bool INI_Handler::GetTokenBool( std::string_view token_name ) {
   INI_Token* ptrTkn = this->GetToken( token_name );
 
   if( ptrTkn == NULL ) {
-    m_error_msg  = "Unable to find token '";
-    m_error_msg += token_name;
-    m_error_msg += "' in section ";
-    m_error_msg += m_section_current->m_name;
-
+    this->TokenNotFound( token_name );
     return false;
   }
 
   ptrTkn->m_read = true;
 
-  return stoi( ptrTkn->m_value ) > 0 ? true : false;
+  return ptrTkn->m_number > 0 ? true : false;
+};
+
+std::string INI_Handler::GetTokenString( std::string_view token_name ) {
+  return std::string( this->GetTokenView( token_name ) );
 };
 
-std::string INI_Handler::GetTokenString( const std::string& token_name ) {
+std::string_view INI_Handler::GetTokenView( std::string_view token_name ) {
   INI_Token* ptrTkn = this->GetToken( token_name );
 
   if( ptrTkn == NULL ) {
-    m_error_msg  = "Unable to find token '";
-    m_error_msg += token_name;
-    m_error_msg += "' in section ";
-    m_error_msg += m_section_current->m_name;
-
-    return std::string();
+    this->TokenNotFound( token_name );
+    return std::string_view();
   }
 
   ptrTkn->m_read = true;
@@ -255,7 +251,7 @@ std::string INI_Handler::GetTokenString( const std::string& token_name ) {
   return ptrTkn->m_value;
 };
 
-bool INI_Handler::TokenExists( const std::string& token_name ) {
+bool INI_Handler::TokenExists( std::string_view token_name ) {
   INI_Token* ptrTkn = this->GetToken( token_name );
 
   return ( ptrTkn != NULL );
@@ -265,21 +261,39 @@ uint32_t INI_Handler::GetNumberOfSections() {
   return m_section_list.size();
 };
 
-int32_t INI_Handler::GetTokenLine( const std::string& token_name ) {
-  INI_Token* ptrTkn = this->GetToken( token_name );
+void INI_Handler::TokenNotFound( std::string_view token_name ) {
+  m_error_msg  = "Unable to find token '";
+  m_error_msg += token_name;
+  m_error_msg += "' in section ";
+  if( m_section_current != NULL ) {
+    m_error_msg += m_section_current->m_name;
+  }
+}
+
+INI_Token* INI_Handler::GetToken( std::string_view token_name ) {
+  if( m_section_current == NULL ) {
+    return NULL;
+  }
 
-  return ( ptrTkn == NULL ? (int32_t)-1 : (int32_t)ptrTkn->m_linenumber );
+  std::unordered_map< std::string_view, INI_Token* >::iterator token = m_section_current->m_tokens.find( token_name );
+
+  return token == m_section_current->m_tokens.end() ? NULL : token->second;
 }
 
-INI_Token* INI_Handler::GetToken( const std::string& token_name ) {
-  std::vector< INI_Token* >::iterator itr    = m_section_current->m_tokenlist.begin();
-  std::vector< INI_Token* >::iterator itrEnd = m_section_current->m_tokenlist.end();
-  for( ; itr != itrEnd; itr++ ) {
-    if( (*itr)->m_name == token_name ) {
-      return (*itr);
-    }
+int INI_Handler::ParseNumber( std::string_view value ) {
+  // Same leading whitespace & sign handling as stoi.
+  size_t start = 0;
+  while( start < value.size() && ( value[ start ] == ' ' || value[ start ] == '\t' ) ) {
+    start++;
+  }
+  if( start < value.size() && value[ start ] == '+' ) {
+    start++;
   }
-  return NULL;
+
+  int number = 0;
+  std::from_chars( value.data() + start, value.data() + value.size(), number );
+
+  return number;
 }
 
 bool INI_Handler::ProcessBuffer() {
@@ -343,16 +357,11 @@ bool INI_Handler::ProcessLine( char* ptr_line, char* ptr_line_end, uint32_t line
 
     // If we found a section finish, then we got a section name!
     if( *ptr_line == m_section_end ) {
-      std::string section_name( ptr_section_start, ptr_line - ptr_section_start );
+      std::string_view section_name( ptr_section_start, ptr_line - ptr_section_start );
 
       // If section does not exist, then create a new section.
-      if( !this->SetSection( section_name ) ) {
-        MSG_INI_DEBUG( "Adding new section. '" << section_name << "'" );
-
-        m_section_current = new INI_Section;
-        m_section_current->m_name = section_name;
-        m_section_list.push_back( m_section_current );
-      }
+      MSG_INI_DEBUG( "Section '" << section_name << "'" );
+      m_section_current = this->AddSection( section_name );
 
       return true;
     }
@@ -379,31 +388,29 @@ bool INI_Handler::ProcessLine( char* ptr_line, char* ptr_line_end, uint32_t line
     return false;
   }
 
-  std::string token_name( ptr_line, ( ptr_value - ptr_line - 1 ) );
+  std::string_view token_name( ptr_line, ( ptr_value - ptr_line - 1 ) );
 
-  MSG_INI_DEBUG( "Testing for existing token '" << token_name << "'" );
+  INI_Token* ptr_token = m_arena.New<INI_Token>();
+  ptr_token->m_name = token_name;
+  ptr_token->m_linenumber = line_number;
 
-  int32_t token_line = this->GetTokenLine( token_name );
+  // Adding by name is also the duplicate check.
+  std::pair< std::unordered_map< std::string_view, INI_Token* >::iterator, bool > added = m_section_current->m_tokens.emplace( token_name, ptr_token );
 
-  if( token_line != -1 ) {
+  if( !added.second ) {
     m_error_msg  = "Duplicate token found at line ";
     m_error_msg += std::to_string( line_number );
     m_error_msg += " previously declared at line ";
-    m_error_msg += std::to_string( token_line );
+    m_error_msg += std::to_string( added.first->second->m_linenumber );
     m_error_msg += " for section '";
     m_error_msg += m_section_current->m_name;
     m_error_msg += "'";
     return false;
   }
 
-  INI_Token* ptr_token = new INI_Token;
-  ptr_token->m_name = token_name;
-  ptr_token->m_linenumber = line_number;
-
   // We can have blank values.
-  if( ptr_value != ptr_line_end ) {
-    ptr_token->m_value.assign( ptr_value, ptr_line_end - ptr_value );
-  }
+  ptr_token->m_value = std::string_view( ptr_value, ptr_line_end - ptr_value );
+  ptr_token->m_number = ParseNumber( ptr_token->m_value );
   ptr_token->m_read = false;
 
   MSG_INI_DEBUG( "Adding new token '" << token_name << "' from line " << line_number << " with value '" << ptr_token->m_value << "'");
@@ -415,33 +422,23 @@ bool INI_Handler::ProcessLine( char* ptr_line, char* ptr_line_end, uint32_t line
 
 void INI_Handler::ClearBuffer() {
   // Ensure buffer is empty.
-  if( m_file_buffer_size > 0 ) {
+  if( m_ptr_file_buffer != NULL ) {
     delete [] m_ptr_file_buffer;
-    m_file_buffer_size = 0;
+    m_ptr_file_buffer = NULL;
   }
+  m_file_buffer_size = 0;
 }
 
 void INI_Handler::ClearSectionsAndTokens() {
-  // Delete all sections and tokens
-  std::vector< INI_Section* >::iterator section_iterator_end = m_section_list.end();
-  std::vector< INI_Token* >::iterator token_iterator;
-  std::vector< INI_Token* >::iterator token_iterator_end;
-
-  for( std::vector< INI_Section* >::iterator section_iterator = m_section_list.begin();
-       section_iterator != section_iterator_end;
-       section_iterator++ ) {
-
-    if( (*section_iterator)->m_tokenlist.size() != 0 ) {
-      token_iterator_end = (*section_iterator)->m_tokenlist.end();
-      for( token_iterator = (*section_iterator)->m_tokenlist.begin();
-           token_iterator != token_iterator_end;
-           token_iterator++ ) {
-        delete (*token_iterator);
-      }
-    }
-    delete (*section_iterator);
+  // Delete all sections, the tokens go with the arena.
+  for( INI_Section* ptr_section : m_section_list ) {
+    delete ptr_section;
   }
   m_section_list.clear();
+  m_sections.clear();
+  m_section_current = NULL;
+
+  m_arena.Clear();
 }
 
 bool INI_Handler::FillBuffer( const std::string& filename ) {
@@ -464,12 +461,12 @@ bool INI_Handler::FillBuffer( const std::string& filename ) {
     return false;
   }
 
-  // Temporary buffer to load the file into.
-  char* ptr_tmp_buffer = new char[ m_file_buffer_size ];
+  // Generate enough room to store whole file.
+  m_ptr_file_buffer = new char[ m_file_buffer_size ];
 
-  // Move to start of file, read file data into temp buffer & then close file.
+  // Move to start of file, read file data into the buffer & then close file.
   file_input.seekg( 0, std::ios::beg );
-  file_input.read( ptr_tmp_buffer, m_file_buffer_size );
+  file_input.read( m_ptr_file_buffer, m_file_buffer_size );
   file_input.close();
 
   // Now we check for file read error.  Bytes In should equal file size.
@@ -478,17 +475,15 @@ bool INI_Handler::FillBuffer( const std::string& filename ) {
   if( bytes_read != m_file_buffer_size ) {
     // File size mismatch from read.
     m_error_msg = "Error during file read.  Read size not same as file size!";
-    delete [] ptr_tmp_buffer;
+    this->ClearBuffer();
     return false;
   }
 
-  // Generate enough room to store whole file.
-  m_ptr_file_buffer = new char[ m_file_buffer_size ];
   m_file_buffer_size = 0;
 
-  // Strip out any unwanted chars
+  // Strip out any unwanted chars, in place.
   char* destination = m_ptr_file_buffer;
-  char* source      = ptr_tmp_buffer;
+  char* source      = m_ptr_file_buffer;
 
   while( bytes_read-- ) {
     if( *source == 10 || *source > 31 ) {
@@ -498,9 +493,6 @@ bool INI_Handler::FillBuffer( const std::string& filename ) {
     source++;
   }
 
-  // Clean up the temporary storage.
-  delete [] ptr_tmp_buffer;
-
   // This could help ;)
   return true;
 }
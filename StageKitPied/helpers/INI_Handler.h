@@ -1,30 +1,36 @@
 #ifndef INI_HANDLER_H_
 #define INI_HANDLER_H_
 
-#ifdef DEBUG
-  #define MSG_INI_DEBUG( str ) do { std::cout << "INI_Handler : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_INI_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_INI_DEBUG( str ) LOG_DEBUG( "INI_Handler", str )
 
-#define MSG_INI_ERROR( str ) do { std::cout << "INI_Handler : ERROR : " << str << std::endl; } while( false )
-#define MSG_INI_INFO( str ) do { std::cout << "INI_Handler : INFO : " << str << std::endl; } while( false )
+#define MSG_INI_ERROR( str ) LOG_ERROR( "INI_Handler", str )
+#define MSG_INI_INFO( str ) LOG_INFO( "INI_Handler", str )
 
 #include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
 #include <memory>
+#include <charconv> // from_chars
+
+#include "helpers/Arena.h"
+#include "helpers/Log.h"
 
 // The basic token struct
+// Held in the handler's arena.  Name & value view the retained file buffer, or the arena for tokens set in code.
 struct INI_Token
 {
   // The name of this token.
-  std::string m_name;
+  std::string_view m_name;
 
   // The value this token has, stored in string format.
-  std::string m_value;
+  std::string_view m_value;
+
+  // The value as a number, converted once when the token is stored.  0 if it isn't one.
+  int m_number;
 
   // The line number this token was read from.
   uint32_t m_linenumber;
@@ -37,10 +43,13 @@ struct INI_Token
 struct INI_Section
 {
   // The name of this section.
-  std::string m_name;
+  std::string_view m_name;
 
-  // A vector containing the tokens of this section.
+  // A vector containing the tokens of this section, in file order.
   std::vector< INI_Token* > m_tokenlist;
+
+  // The tokens of this section by name.
+  std::unordered_map< std::string_view, INI_Token* > m_tokens;
 };
 
 // Quick and dirrty ini handler.
@@ -113,7 +122,7 @@ public:
    *
    * \return  false if section already created, else true.
    */
-  bool CreateSection( const std::string& section_name );
+  bool CreateSection( std::string_view section_name );
 
   // Deletes a section.
   /* If mCurrentSection is the one to delete, then it becomes NULL.
@@ -122,7 +131,7 @@ public:
    *
    * \return  true on deletion, else false.
    */
-  bool DeleteSection( const std::string& section_name );
+  bool DeleteSection( std::string_view section_name );
 
   // Sets the value of the token in the given section.
   /* If the token is not found, then it creates the token.
@@ -132,7 +141,7 @@ public:
    *
    * \return  false if not already in a section, else true.
    */
-  bool SetToken( const std::string& token_name, const std::string& token_value );
+  bool SetToken( std::string_view token_name, std::string_view token_value );
 
   // Gets the last generated error.
   /*
@@ -147,7 +156,7 @@ public:
    *
    * \return true if the section name was found, else false.
    */
-  bool FindSection( const std::string& section_name );
+  bool FindSection( std::string_view section_name );
 
   // Sets the current section to a section in the loaded ini file.
   /* Note: Section numbers start from 1, and are as laid out in ini file.
@@ -164,7 +173,7 @@ public:
    *
    * \return true if the section name was found and set, else false.
    */
-  bool SetSection( const std::string& section_name );
+  bool SetSection( std::string_view section_name );
 
   // Gets the current section name.
   /*
@@ -179,7 +188,7 @@ public:
    *
    * \return The value of the token.
    */
-  int GetTokenValue( const std::string& token_name );
+  int GetTokenValue( std::string_view token_name );
 
   // Gets the token value as a boolean in the current section.
   /* Note: If the tokenname is not found, then false is returned.
@@ -188,7 +197,7 @@ public:
    *
    * \return If value > 0 then true else false.
    */
-  bool GetTokenBool( const std::string& token_name );
+  bool GetTokenBool( std::string_view token_name );
 
   // Gets the token value as a char* in the current section.
   /* Note: If the tokenname is not found, then NULL is returned.
@@ -197,7 +206,17 @@ public:
    *
    * \return String
    */
-  std::string GetTokenString( const std::string& token_name );
+  std::string GetTokenString( std::string_view token_name );
+
+  // Gets the token value as a view in the current section.
+  /* Note: If the tokenname is not found, then an empty view is returned.
+   *       The view is valid until the next Load or ClearAll.
+   *
+   * \param tokenName  The name of the token to find.
+   *
+   * \return View of the value.
+   */
+  std::string_view GetTokenView( std::string_view token_name );
 
   // Gets the amount of sections.
   /*
@@ -211,7 +230,7 @@ public:
    *
    * \return true if token exists, else false.
    */
-  bool TokenExists( const std::string& token_name );
+  bool TokenExists( std::string_view token_name );
 
   // Dumps unused items.
   /* For debugging only.
@@ -240,21 +259,32 @@ public:
 
 private:
 
-  // Gets the file line number of the token in the current section.
+  // Gets the token in the current section.
   /*
    * \param tokenName  The token name to find.
    *
-   * \return -1 if token name does not exist in current section, else its the file line number.
+   * \return NULL if not found, else a pointer to the token.
    */
-  int32_t GetTokenLine( const std::string& token_name );
+  INI_Token* GetToken( std::string_view token_name );
 
-  // Gets the token in the current section.
+  // Records a missing token as the last error.
+  void TokenNotFound( std::string_view token_name );
+
+  // Creates a section, or finds the existing one.
   /*
-   * \param tokenName  The token name to find.
+   * \param  sectionName  The section name.  Must stay valid as long as the section, so the file buffer or arena.
    *
-   * \return NULL if not found, else a pointer to the token.
+   * \return  Pointer to the section.
+   */
+  INI_Section* AddSection( std::string_view section_name );
+
+  // Converts a token value to a number, in the same way as stoi but without throwing.
+  /*
+   * \param  value  The value text.
+   *
+   * \return  The number, or 0 if the value does not start with one.
    */
-  INI_Token* GetToken( const std::string& token_name );
+  static int ParseNumber( std::string_view value );
 
   // Processes the loaded in file buffer.
   /* Pulls out lines from the buffer and sends them to ProcessLine
@@ -287,7 +317,7 @@ private:
    */
   bool FillBuffer( const std::string& filename );
 
-  // The internal file buffer
+  // The internal file buffer.  Kept while loaded, as tokens view into it.
   char*    m_ptr_file_buffer;
 
   // The size of the internal buffer used.
@@ -305,9 +335,15 @@ private:
   // The deliminator character.
   char m_deliminator;
 
-  // Storage for sections.
+  // Storage for sections, in file order.
   std::vector< INI_Section* > m_section_list;
 
+  // The sections by name.
+  std::unordered_map< std::string_view, INI_Section* > m_sections;
+
+  // Storage for tokens & any names or values not in the file buffer.
+  Arena m_arena;
+
   // The current section in use.
   INI_Section* m_section_current;
 
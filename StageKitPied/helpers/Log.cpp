@@ -0,0 +1,193 @@
+#include "Log.h"
+
+#include <algorithm>  // min
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+#include "helpers/Realtime.h"
+
+Log::Slot             Log::s_slots[ LOG_RING_SLOTS ];
+std::atomic<uint32_t> Log::s_write_position( 0 );
+uint32_t              Log::s_read_position = 0;
+std::atomic<uint64_t> Log::s_dropped( 0 );
+std::atomic<bool>     Log::s_is_started( false );
+std::atomic<bool>     Log::s_running( false );
+std::thread           Log::s_thread;
+
+bool Log::Start() {
+  if( s_is_started ) {
+    return true;
+  }
+
+  // Slot n is free for the nth line.
+  for( uint32_t index = 0; index < LOG_RING_SLOTS; index++ ) {
+    s_slots[ index ].m_sequence.store( index, std::memory_order_relaxed );
+  }
+  s_write_position = 0;
+  s_read_position  = 0;
+
+  s_running = true;
+  try {
+    s_thread = std::thread( &Log::Run );
+  } catch( const std::system_error& error ) {
+    s_running = false;
+    return false;
+  }
+
+  s_is_started = true;
+
+  return true;
+};
+
+void Log::Stop() {
+  if( !s_is_started ) {
+    return;
+  }
+
+  // Lines written meanwhile go straight out, the thread only takes what's in the ring.
+  s_is_started = false;
+  s_running    = false;
+
+  if( s_thread.joinable() ) {
+    s_thread.join();
+  }
+};
+
+uint64_t Log::GetAmountDropped() {
+  return s_dropped;
+};
+
+void Log::Write( const char* ptr_text, const uint32_t length ) {
+  if( !s_is_started ) {
+    WriteOut( ptr_text, length );
+    return;
+  }
+
+  // Claims the next slot, if the writer thread is done with it.  Any number of threads can be in here at once.
+  uint32_t position = s_write_position.load( std::memory_order_relaxed );
+  Slot*    ptr_slot;
+
+  while( true ) {
+    ptr_slot = &s_slots[ position % LOG_RING_SLOTS ];
+    const int32_t turn = ptr_slot->m_sequence.load( std::memory_order_acquire ) - position;
+
+    if( turn == 0 ) {
+      if( s_write_position.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) {
+        break;
+      }
+    } else if( turn < 0 ) {
+      // Full - Dropped rather than wait.
+      s_dropped++;
+      return;
+    } else {
+      position = s_write_position.load( std::memory_order_relaxed );
+    }
+  }
+
+  ptr_slot->m_length = std::min<uint32_t>( length, LOG_LINE_BYTES );
+  memcpy( ptr_slot->m_text, ptr_text, ptr_slot->m_length );
+  ptr_slot->m_sequence.store( position + 1, std::memory_order_release );
+};
+
+void Log::Run() {
+  uint32_t realtime_generation = Realtime::GetGeneration();
+  uint64_t dropped_reported    = 0;
+
+  // Writing can block, so never on the output CPU or above normal priority.
+  Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+
+  while( s_running ) {
+    if( realtime_generation != Realtime::GetGeneration() ) {
+      realtime_generation = Realtime::GetGeneration();
+      Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+    }
+
+    Drain();
+
+    const uint64_t dropped = s_dropped;
+    if( dropped != dropped_reported ) {
+      char text[ LOG_LINE_BYTES ];
+      const int length = snprintf( text, sizeof( text ), "Log : ERROR : %llu lines dropped, logging faster than they could be written.",
+                                   (unsigned long long)( dropped - dropped_reported ) );
+      WriteOut( text, std::min<int>( length, sizeof( text ) - 1 ) );
+      dropped_reported = dropped;
+    }
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( LOG_DRAIN_INTERVAL_MS ) );
+  }
+
+  // Anything logged before Stop.
+  Drain();
+};
+
+void Log::Drain() {
+  bool is_written = false;
+
+  while( true ) {
+    Slot& slot = s_slots[ s_read_position % LOG_RING_SLOTS ];
+    if( slot.m_sequence.load( std::memory_order_acquire ) != s_read_position + 1 ) {
+      break;
+    }
+
+    fwrite( slot.m_text, 1, slot.m_length, stdout );
+    fputc( '\n', stdout );
+    is_written = true;
+
+    // Free for the line a ring later.
+    slot.m_sequence.store( s_read_position + LOG_RING_SLOTS, std::memory_order_release );
+    s_read_position++;
+  }
+
+  if( is_written ) {
+    fflush( stdout );
+  }
+};
+
+void Log::WriteOut( const char* ptr_text, const uint32_t length ) {
+  // One call, so lines from different threads don't interleave.
+  char line[ LOG_LINE_BYTES + 1 ];
+  const uint32_t line_length = std::min<uint32_t>( length, LOG_LINE_BYTES );
+  memcpy( line, ptr_text, line_length );
+  line[ line_length ] = '\n';
+
+  fwrite( line, 1, line_length + 1, stdout );
+  fflush( stdout );
+};
+
+bool LogSite::Allow() {
+  const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+  int64_t window_ms = m_window_ms.load( std::memory_order_relaxed );
+
+  // Whoever starts the new window resets the count.  Racing it only lets a line or two more through.
+  if( now_ms - window_ms >= LOG_SITE_WINDOW_MS && m_window_ms.compare_exchange_strong( window_ms, now_ms, std::memory_order_relaxed ) ) {
+    m_amount.store( 0, std::memory_order_relaxed );
+  }
+
+  if( m_amount.fetch_add( 1, std::memory_order_relaxed ) < LOG_SITE_BURST ) {
+    return true;
+  }
+
+  m_suppressed.fetch_add( 1, std::memory_order_relaxed );
+  return false;
+};
+
+uint32_t LogSite::TakeSuppressed() {
+  return m_suppressed.exchange( 0, std::memory_order_relaxed );
+};
+
+LogLine::LogLine() : m_buffer( m_text, sizeof( m_text ) ), m_stream( &m_buffer ) {
+};
+
+std::ostream& LogLine::GetStream() {
+  return m_stream;
+};
+
+void LogLine::Send( const uint32_t suppressed ) {
+  if( suppressed > 0 ) {
+    m_stream << " (" << suppressed << " more like this left out)";
+  }
+
+  Log::Write( m_text, m_buffer.GetLength() );
+};
@@ -0,0 +1,143 @@
+#ifndef _LOG_H_
+#define _LOG_H_
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_ERROR 2
+
+// Lowest level built in, anything under it compiles to nothing.  make LOG_LEVEL=2 for errors only.
+#ifndef LOG_LEVEL
+  #ifdef DEBUG
+    #define LOG_LEVEL LOG_LEVEL_DEBUG
+  #else
+    #define LOG_LEVEL LOG_LEVEL_INFO
+  #endif
+#endif
+
+#define LOG_RING_SLOTS        256   // Lines waiting to be written, past this they're dropped & counted.
+#define LOG_LINE_BYTES        240   // Longer lines are cut short.
+#define LOG_SITE_BURST        10    // Lines each message may log per window, the rest are counted & left out.
+#define LOG_SITE_WINDOW_MS    1000
+#define LOG_DRAIN_INTERVAL_MS 20    // How often the writer thread empties the ring.
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+// Every MSG_ macro comes through here.  Each use gets its own rate limit & the line is formatted on the stack,
+// so logging never allocates or waits on a lock.  Until Start it's written straight away, as before.  After,
+// lines go into a ring that a thread of its own writes out, so a slow terminal or journald can't hold up the
+// lights.
+#define LOG_MESSAGE( level, name, str ) do { \
+    static LogSite log_site_; \
+    if( log_site_.Allow() ) { \
+      LogLine log_line_; \
+      log_line_.GetStream() << name << " : " << level << " : " << str; \
+      log_line_.Send( log_site_.TakeSuppressed() ); \
+    } \
+  } while( false )
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+  #define LOG_DEBUG( name, str ) LOG_MESSAGE( "DEBUG", name, str )
+#else
+  #define LOG_DEBUG( name, str ) do { } while( false )
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+  #define LOG_INFO( name, str ) LOG_MESSAGE( "INFO", name, str )
+#else
+  #define LOG_INFO( name, str ) do { } while( false )
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+  #define LOG_ERROR( name, str ) LOG_MESSAGE( "ERROR", name, str )
+#else
+  #define LOG_ERROR( name, str ) do { } while( false )
+#endif
+
+class Log {
+public:
+  // Starts the writer thread.
+  static bool Start();
+
+  // Writes out whatever's left & goes back to writing straight away.
+  static void Stop();
+
+  // Lines dropped for the ring being full, since start.
+  static uint64_t GetAmountDropped();
+
+  // From LogLine.  Never blocks once started.
+  static void Write( const char* ptr_text, const uint32_t length );
+
+private:
+  struct Slot
+  {
+    std::atomic<uint32_t> m_sequence;  // Whose turn the slot is, see Write & Drain.
+    uint32_t              m_length;
+    char                  m_text[ LOG_LINE_BYTES ];
+  };
+
+  static void Run();
+
+  // Writes out every line that's ready.
+  static void Drain();
+
+  static void WriteOut( const char* ptr_text, const uint32_t length );
+
+  static Slot                  s_slots[ LOG_RING_SLOTS ];
+  static std::atomic<uint32_t> s_write_position;
+  static uint32_t              s_read_position;
+  static std::atomic<uint64_t> s_dropped;
+  static std::atomic<bool>     s_is_started;
+  static std::atomic<bool>     s_running;
+  static std::thread           s_thread;
+};
+
+// Rate limit for one message.  Static in each use of LOG_MESSAGE, so constant initialised & lock free.
+class LogSite {
+public:
+  constexpr LogSite() : m_window_ms( INT64_MIN / 2 ), m_amount( 0 ), m_suppressed( 0 ) {
+  };
+
+  // False once the message has logged LOG_SITE_BURST lines this window.
+  bool Allow();
+
+  // Lines left out since the last one logged.
+  uint32_t TakeSuppressed();
+
+private:
+  std::atomic<int64_t>  m_window_ms;  // Start of the current window.
+  std::atomic<uint32_t> m_amount;
+  std::atomic<uint32_t> m_suppressed;
+};
+
+// A line being formatted, into a buffer on the stack.  Anything past LOG_LINE_BYTES is cut off.
+class LogLine {
+public:
+  LogLine();
+
+  std::ostream& GetStream();
+
+  // Hands the line to Log, noting how many were left out before it.
+  void Send( const uint32_t suppressed );
+
+private:
+  class Buffer : public std::streambuf {
+  public:
+    Buffer( char* ptr_text, const size_t size ) {
+      this->setp( ptr_text, ptr_text + size );
+    };
+
+    uint32_t GetLength() {
+      return this->pptr() - this->pbase();
+    };
+  };
+
+  char         m_text[ LOG_LINE_BYTES ];
+  Buffer       m_buffer;
+  std::ostream m_stream;
+};
+
+#endif
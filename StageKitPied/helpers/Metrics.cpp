@@ -0,0 +1,130 @@
+#include "Metrics.h"
+
+#include <algorithm>  // stable_sort
+#include <cstdio>     // snprintf
+
+std::mutex                  Metrics::s_mutex;
+std::vector<Metrics::Entry> Metrics::s_entries;
+std::deque<MetricCounter>   Metrics::s_counters;
+std::deque<MetricGauge>     Metrics::s_gauges;
+std::deque<MetricHistogram> Metrics::s_histograms;
+
+MetricCounter* Metrics::Counter( const std::string& name, const std::string& help, const std::string& labels ) {
+  std::lock_guard<std::mutex> lock( s_mutex );
+
+  Entry* ptr_entry = Find( name, labels, METRIC_COUNTER );
+  if( ptr_entry != NULL ) {
+    return static_cast<MetricCounter*>( ptr_entry->m_ptr_metric );
+  }
+
+  s_counters.emplace_back();
+  Add( name, help, labels, METRIC_COUNTER, &s_counters.back() );
+
+  return &s_counters.back();
+};
+
+MetricGauge* Metrics::Gauge( const std::string& name, const std::string& help, const std::string& labels ) {
+  std::lock_guard<std::mutex> lock( s_mutex );
+
+  Entry* ptr_entry = Find( name, labels, METRIC_GAUGE );
+  if( ptr_entry != NULL ) {
+    return static_cast<MetricGauge*>( ptr_entry->m_ptr_metric );
+  }
+
+  s_gauges.emplace_back();
+  Add( name, help, labels, METRIC_GAUGE, &s_gauges.back() );
+
+  return &s_gauges.back();
+};
+
+MetricHistogram* Metrics::Histogram( const std::string& name, const std::string& help, const std::string& labels ) {
+  std::lock_guard<std::mutex> lock( s_mutex );
+
+  Entry* ptr_entry = Find( name, labels, METRIC_HISTOGRAM );
+  if( ptr_entry != NULL ) {
+    return static_cast<MetricHistogram*>( ptr_entry->m_ptr_metric );
+  }
+
+  s_histograms.emplace_back();
+  Add( name, help, labels, METRIC_HISTOGRAM, &s_histograms.back() );
+
+  return &s_histograms.back();
+};
+
+void Metrics::Export( std::string& text ) {
+  std::vector<Entry> entries;
+  {
+    std::lock_guard<std::mutex> lock( s_mutex );
+    entries = s_entries;
+  }
+
+  // Prometheus wants each metric's lines together, under one HELP & TYPE.
+  std::stable_sort( entries.begin(), entries.end(), []( const Entry& a, const Entry& b ) {
+    return a.m_name < b.m_name;
+  } );
+
+  static const char* type_names[] = { "counter", "gauge", "histogram" };
+  char number[ 32 ];
+  text.clear();
+
+  for( size_t index = 0; index < entries.size(); index++ ) {
+    const Entry& entry = entries[ index ];
+
+    if( index == 0 || entries[ index - 1 ].m_name != entry.m_name ) {
+      text += "# HELP " + entry.m_name + " " + entry.m_help + "\n";
+      text += "# TYPE " + entry.m_name + " " + type_names[ entry.m_type ] + "\n";
+    }
+
+    const std::string labels = entry.m_labels.empty() ? "" : "{" + entry.m_labels + "}";
+
+    switch( entry.m_type ) {
+      case METRIC_COUNTER:
+        text += entry.m_name + labels + " " + std::to_string( static_cast<MetricCounter*>( entry.m_ptr_metric )->Get() ) + "\n";
+        break;
+      case METRIC_GAUGE:
+        text += entry.m_name + labels + " " + std::to_string( static_cast<MetricGauge*>( entry.m_ptr_metric )->Get() ) + "\n";
+        break;
+      case METRIC_HISTOGRAM: {
+        const MetricHistogram* ptr_histogram = static_cast<MetricHistogram*>( entry.m_ptr_metric );
+        const std::string separator = entry.m_labels.empty() ? "" : entry.m_labels + ",";
+        uint64_t count = 0;
+
+        // Buckets are cumulative, each counts everything up to its le.
+        for( int bucket = 0; bucket <= METRICS_HISTOGRAM_BUCKETS; bucket++ ) {
+          count += ptr_histogram->GetBucket( bucket );
+          if( bucket < METRICS_HISTOGRAM_BUCKETS ) {
+            snprintf( number, sizeof( number ), "%g", ( 1ULL << bucket ) / 1000000.0 );
+          } else {
+            snprintf( number, sizeof( number ), "+Inf" );
+          }
+          text += entry.m_name + "_bucket{" + separator + "le=\"" + number + "\"} " + std::to_string( count ) + "\n";
+        }
+
+        snprintf( number, sizeof( number ), "%.6f", ptr_histogram->GetSumUs() / 1000000.0 );
+        text += entry.m_name + "_sum" + labels + " " + number + "\n";
+        text += entry.m_name + "_count" + labels + " " + std::to_string( count ) + "\n";
+        break;
+      }
+    }
+  }
+};
+
+Metrics::Entry* Metrics::Find( const std::string& name, const std::string& labels, const MetricType type ) {
+  for( Entry& entry : s_entries ) {
+    if( entry.m_type == type && entry.m_name == name && entry.m_labels == labels ) {
+      return &entry;
+    }
+  }
+  return NULL;
+};
+
+void Metrics::Add( const std::string& name, const std::string& help, const std::string& labels, const MetricType type, void* ptr_metric ) {
+  Entry entry;
+  entry.m_name       = name;
+  entry.m_help       = help;
+  entry.m_labels     = labels;
+  entry.m_type       = type;
+  entry.m_ptr_metric = ptr_metric;
+
+  s_entries.push_back( entry );
+};
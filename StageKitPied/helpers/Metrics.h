@@ -0,0 +1,123 @@
+#ifndef _METRICS_H_
+#define _METRICS_H_
+
+#define METRICS_HISTOGRAM_BUCKETS 21  // Powers of 2 microseconds, 1 us to about 1 s, then everything over.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Only ever goes up, such as packets received.
+class MetricCounter {
+public:
+  // A relaxed atomic add, a few ns.
+  void Add( const uint64_t amount = 1 ) {
+    m_value.fetch_add( amount, std::memory_order_relaxed );
+  };
+
+  uint64_t Get() const {
+    return m_value.load( std::memory_order_relaxed );
+  };
+
+private:
+  std::atomic<uint64_t> m_value{ 0 };
+};
+
+// A value as it is now, such as stage kits connected.
+class MetricGauge {
+public:
+  void Set( const int64_t value ) {
+    m_value.store( value, std::memory_order_relaxed );
+  };
+
+  int64_t Get() const {
+    return m_value.load( std::memory_order_relaxed );
+  };
+
+private:
+  std::atomic<int64_t> m_value{ 0 };
+};
+
+// How long things take.  Bucket n counts times up to 2^n us, the last everything longer.
+class MetricHistogram {
+public:
+  void Observe( const uint64_t time_us ) {
+    int bucket = 0;
+    if( time_us > 1 ) {
+      // Bits needed for time_us - 1, so exact powers of 2 land in their own bucket.
+      bucket = 64 - __builtin_clzll( time_us - 1 );
+      if( bucket > METRICS_HISTOGRAM_BUCKETS ) {
+        bucket = METRICS_HISTOGRAM_BUCKETS;
+      }
+    }
+    m_buckets[ bucket ].fetch_add( 1, std::memory_order_relaxed );
+    m_sum_us.fetch_add( time_us, std::memory_order_relaxed );
+  };
+
+  // Time since time_start.
+  void ObserveSince( const std::chrono::steady_clock::time_point time_start ) {
+    this->Observe( std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - time_start ).count() );
+  };
+
+  uint64_t GetBucket( const int bucket ) const {
+    return m_buckets[ bucket ].load( std::memory_order_relaxed );
+  };
+
+  uint64_t GetSumUs() const {
+    return m_sum_us.load( std::memory_order_relaxed );
+  };
+
+private:
+  std::atomic<uint64_t> m_buckets[ METRICS_HISTOGRAM_BUCKETS + 1 ] = {};
+  std::atomic<uint64_t> m_sum_us{ 0 };
+};
+
+// Every counter, gauge & histogram, exported by MetricsExporter.  Registering takes a lock & allocates, so is done
+// at start up, keeping the pointer.  Updating through it never locks or allocates.  Registering the same name &
+// labels again hands back the same one, so an object made twice keeps adding up.
+// labels are Prometheus style without the braces, such as source="rb3e".
+class Metrics {
+public:
+  static MetricCounter* Counter( const std::string& name, const std::string& help, const std::string& labels = "" );
+
+  static MetricGauge* Gauge( const std::string& name, const std::string& help, const std::string& labels = "" );
+
+  static MetricHistogram* Histogram( const std::string& name, const std::string& help, const std::string& labels = "" );
+
+  // Everything in Prometheus text format.  Histograms are in seconds.
+  static void Export( std::string& text );
+
+private:
+  enum MetricType {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM
+  };
+
+  struct Entry
+  {
+    std::string m_name;
+    std::string m_help;
+    std::string m_labels;
+    MetricType  m_type;
+    void*       m_ptr_metric;
+  };
+
+  // The same entry if it's registered, else NULL.
+  static Entry* Find( const std::string& name, const std::string& labels, const MetricType type );
+
+  static void Add( const std::string& name, const std::string& help, const std::string& labels, const MetricType type, void* ptr_metric );
+
+  // Deques, so the metrics never move once handed out.
+  static std::mutex                  s_mutex;
+  static std::vector<Entry>          s_entries;
+  static std::deque<MetricCounter>   s_counters;
+  static std::deque<MetricGauge>     s_gauges;
+  static std::deque<MetricHistogram> s_histograms;
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include "MetricsExporter.h"
+
+#include <algorithm>  // min
+#include <cerrno>
+#include <chrono>
+#include <cstdio>     // rename
+#include <cstring>    // strerror
+#include <system_error>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "helpers/Realtime.h"
+
+MetricsExporter::MetricsExporter() {
+  m_settings_generation = 0;
+  m_running             = false;
+  m_socket_descriptor   = -1;
+};
+
+MetricsExporter::~MetricsExporter() {
+  this->Stop();
+};
+
+bool MetricsExporter::Start( const MetricsSettings& settings ) {
+  MetricsSettings settings_new = settings;
+  if( settings_new.m_interval_ms < METRICSEXPORTER_INTERVAL_MS_MIN ) {
+    settings_new.m_interval_ms = METRICSEXPORTER_INTERVAL_MS_MIN;
+  }
+
+  {
+    // The thread only holds this long enough to copy the settings.
+    std::lock_guard<std::mutex> lock( m_settings_mutex );
+    if( m_thread.joinable() && settings_new == m_settings ) {
+      return true;
+    }
+    m_settings = settings_new;
+    m_settings_generation++;
+  }
+
+  // Already running, it picks them up on its next pass.
+  if( m_thread.joinable() || !settings_new.m_enabled ) {
+    return true;
+  }
+
+  m_running = true;
+  try {
+    m_thread = std::thread( &MetricsExporter::Run, this );
+  } catch( const std::system_error& error ) {
+    m_running = false;
+    return false;
+  }
+
+  return true;
+};
+
+void MetricsExporter::Stop() {
+  m_running = false;
+
+  if( m_thread.joinable() ) {
+    m_thread.join();
+  }
+};
+
+void MetricsExporter::Run() {
+  ALLOC_SCOPE( "metrics" );
+
+  std::string     text;
+  MetricsSettings settings;
+  uint32_t settings_generation = 0;
+  uint32_t realtime_generation = Realtime::GetGeneration();
+
+  Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+
+  std::chrono::steady_clock::time_point time_write = std::chrono::steady_clock::now();
+
+  while( m_running ) {
+    if( realtime_generation != Realtime::GetGeneration() ) {
+      realtime_generation = Realtime::GetGeneration();
+      Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+    }
+
+    if( settings_generation != m_settings_generation ) {
+      {
+        std::lock_guard<std::mutex> lock( m_settings_mutex );
+        settings            = m_settings;
+        settings_generation = m_settings_generation;
+      }
+
+      this->CloseSocket();
+      if( settings.m_enabled && !settings.m_socket.empty() ) {
+        this->OpenSocket( settings.m_socket );
+      }
+      time_write = std::chrono::steady_clock::now();
+
+      if( settings.m_enabled ) {
+        MSG_METRICSEXPORTER_INFO( "Exporting metrics" << ( settings.m_file.empty() ? "" : " to " + settings.m_file )
+                                  << ( settings.m_socket.empty() ? "" : " on " + settings.m_socket ) << "." );
+      } else {
+        MSG_METRICSEXPORTER_INFO( "Metrics export stopped." );
+      }
+    }
+
+    if( !settings.m_enabled ) {
+      std::this_thread::sleep_for( std::chrono::milliseconds( METRICSEXPORTER_INTERVAL_MS_MIN ) );
+      continue;
+    }
+
+    const std::chrono::steady_clock::time_point time_now = std::chrono::steady_clock::now();
+
+    if( !settings.m_file.empty() && time_now >= time_write ) {
+      Metrics::Export( text );
+      this->WriteFile( settings.m_file, text );
+      time_write = time_now + std::chrono::milliseconds( settings.m_interval_ms );
+    }
+
+    // Waits for a connection, the next file write or until it's time to check for new settings or stopping.
+    int wait_ms = METRICSEXPORTER_INTERVAL_MS_MIN;
+    if( !settings.m_file.empty() ) {
+      wait_ms = std::min<long>( wait_ms, std::chrono::duration_cast<std::chrono::milliseconds>( time_write - time_now ).count() + 1 );
+    }
+
+    if( m_socket_descriptor == -1 ) {
+      std::this_thread::sleep_for( std::chrono::milliseconds( wait_ms ) );
+      continue;
+    }
+
+    pollfd poll_fd = { m_socket_descriptor, POLLIN, 0 };
+    if( poll( &poll_fd, 1, wait_ms ) <= 0 ) {
+      continue;
+    }
+
+    const int client = accept( m_socket_descriptor, NULL, NULL );
+    if( client == -1 ) {
+      continue;
+    }
+
+    Metrics::Export( text );
+
+    // A reader that's stopped reading can't hold the thread up for long.
+    timeval timeout = { 1, 0 };
+    setsockopt( client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof( timeout ) );
+
+    size_t written = 0;
+    while( written < text.size() ) {
+      const ssize_t bytes = send( client, text.data() + written, text.size() - written, MSG_NOSIGNAL );
+      if( bytes <= 0 ) {
+        break;
+      }
+      written += bytes;
+    }
+
+    close( client );
+  }
+
+  this->CloseSocket();
+};
+
+bool MetricsExporter::OpenSocket( const std::string& socket_path ) {
+  sockaddr_un address;
+  memset( &address, 0, sizeof( address ) );
+  address.sun_family = AF_UNIX;
+
+  if( socket_path.size() >= sizeof( address.sun_path ) ) {
+    MSG_METRICSEXPORTER_ERROR( "Socket path too long : " << socket_path );
+    return false;
+  }
+  strcpy( address.sun_path, socket_path.c_str() );
+
+  m_socket_descriptor = socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+  if( m_socket_descriptor == -1 ) {
+    MSG_METRICSEXPORTER_ERROR( "Unable to create a socket : " << strerror( errno ) );
+    return false;
+  }
+
+  // Left over from a previous run.
+  unlink( address.sun_path );
+
+  if( bind( m_socket_descriptor, (sockaddr*)&address, sizeof( address ) ) == -1 || listen( m_socket_descriptor, 4 ) == -1 ) {
+    MSG_METRICSEXPORTER_ERROR( "Unable to listen on " << socket_path << " : " << strerror( errno ) );
+    close( m_socket_descriptor );
+    m_socket_descriptor = -1;
+    return false;
+  }
+
+  m_socket_path = socket_path;
+
+  return true;
+};
+
+void MetricsExporter::CloseSocket() {
+  if( m_socket_descriptor != -1 ) {
+    close( m_socket_descriptor );
+    m_socket_descriptor = -1;
+    unlink( m_socket_path.c_str() );
+  }
+};
+
+bool MetricsExporter::WriteFile( const std::string& file, const std::string& text ) {
+  const std::string file_temp = file + ".tmp";
+
+  const int file_descriptor = open( file_temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+  if( file_descriptor == -1 ) {
+    MSG_METRICSEXPORTER_ERROR( "Unable to write " << file_temp << " : " << strerror( errno ) );
+    return false;
+  }
+
+  const bool is_written = write( file_descriptor, text.data(), text.size() ) == (ssize_t)text.size();
+  close( file_descriptor );
+
+  if( !is_written || rename( file_temp.c_str(), file.c_str() ) == -1 ) {
+    MSG_METRICSEXPORTER_ERROR( "Unable to write " << file << " : " << strerror( errno ) );
+    unlink( file_temp.c_str() );
+    return false;
+  }
+
+  return true;
+};
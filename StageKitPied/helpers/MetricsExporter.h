@@ -0,0 +1,74 @@
+#ifndef _METRICSEXPORTER_H_
+#define _METRICSEXPORTER_H_
+
+#define MSG_METRICSEXPORTER_ERROR( str ) LOG_ERROR( "MetricsExporter", str )
+#define MSG_METRICSEXPORTER_INFO( str ) LOG_INFO( "MetricsExporter", str )
+
+#define METRICSEXPORTER_INTERVAL_MS_MIN 100
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "helpers/AllocTracker.h"
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
+
+struct MetricsSettings
+{
+  bool        m_enabled;
+  std::string m_file;         // Rewritten every interval, such as into node_exporter's textfile directory.  Empty for none.
+  std::string m_socket;       // Unix socket, each connection is sent the metrics then closed.  Empty for none.
+  int         m_interval_ms;
+
+  MetricsSettings() {
+    m_enabled     = false;
+    m_interval_ms = 5000;
+  };
+
+  bool operator==( const MetricsSettings& other ) const {
+    return m_enabled == other.m_enabled && m_file == other.m_file && m_socket == other.m_socket &&
+           m_interval_ms == other.m_interval_ms;
+  };
+};
+
+// Writes Metrics out on a housekeeping thread of its own, so exporting never holds up the lights.
+// New settings are handed to the thread, which rebinds its socket & file itself, so a reload never waits on it.
+class MetricsExporter {
+public:
+  MetricsExporter();
+
+  ~MetricsExporter();
+
+  // Takes on the settings if they've changed, starting the thread the first time they're enabled.  Never waits on
+  // the thread, so is safe from the main loop.  Socket & file errors are logged from the thread.
+  bool Start( const MetricsSettings& settings );
+
+  // Joins the thread, only at shut down.
+  void Stop();
+
+private:
+  void Run();
+
+  bool OpenSocket( const std::string& socket_path );
+
+  void CloseSocket();
+
+  // Written alongside & renamed over, so readers never see half a file.
+  bool WriteFile( const std::string& file, const std::string& text );
+
+  // Handed to the thread, m_settings_generation goes up each change.
+  std::mutex            m_settings_mutex;
+  MetricsSettings       m_settings;
+  std::atomic<uint32_t> m_settings_generation;
+
+  std::atomic<bool> m_running;
+  std::thread       m_thread;
+
+  // Only touched by the thread.
+  int               m_socket_descriptor;
+  std::string       m_socket_path;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "Realtime.h"
+
+std::mutex            Realtime::s_mutex;
+RealtimeSettings      Realtime::s_settings;
+std::mutex            Realtime::s_memory_mutex;
+bool                  Realtime::s_is_memory_locked = false;
+std::atomic<uint32_t> Realtime::s_generation( 0 );
+cpu_set_t             Realtime::s_startup_cpus = Realtime::GetCurrentCPUs();
+
+void Realtime::Set( const RealtimeSettings& settings ) {
+  std::lock_guard<std::mutex> lock( s_mutex );
+
+  if( settings == s_settings ) {
+    return;
+  }
+
+  s_settings = settings;
+  s_generation++;
+
+  if( settings.m_enabled ) {
+    MSG_REALTIME_INFO( "Realtime priorities " << settings.m_priority[ REALTIME_ROLE_MAIN ] << " main, "
+                       << settings.m_priority[ REALTIME_ROLE_RENDER ] << " render, "
+                       << settings.m_priority[ REALTIME_ROLE_HOUSEKEEPING ] << " housekeeping.  Output CPU "
+                       << settings.m_output_cpu << "." );
+  } else {
+    MSG_REALTIME_INFO( "Normal scheduling." );
+  }
+};
+
+void Realtime::UpdateMemoryLock() {
+  bool locked;
+  {
+    std::lock_guard<std::mutex> lock( s_mutex );
+    locked = s_settings.m_enabled && s_settings.m_lock_memory;
+  }
+
+  std::lock_guard<std::mutex> lock( s_memory_mutex );
+  SetMemoryLocked( locked );
+};
+
+uint32_t Realtime::GetGeneration() {
+  return s_generation;
+};
+
+bool Realtime::Apply( const int role, const int cpu ) {
+  RealtimeSettings settings;
+  {
+    std::lock_guard<std::mutex> lock( s_mutex );
+    settings = s_settings;
+  }
+
+  const int cpus       = GetAmountCPUs();
+  const int output_cpu = settings.m_enabled && settings.m_output_cpu < cpus ? settings.m_output_cpu : -1;
+  bool is_good = true;
+
+  // Priority, dropping back to normal scheduling is always allowed.
+  int priority = settings.m_enabled && role >= 0 && role < REALTIME_ROLES ? settings.m_priority[ role ] : 0;
+  priority = priority > REALTIME_PRIORITY_MAX ? REALTIME_PRIORITY_MAX : priority;
+
+  sched_param param;
+  std::memset( &param, 0, sizeof( param ) );
+  param.sched_priority = priority > 0 ? priority : 0;
+
+  if( pthread_setschedparam( pthread_self(), priority > 0 ? SCHED_FIFO : SCHED_OTHER, &param ) != 0 ) {
+    is_good = false;
+  }
+
+  // CPUs.  Everything but the main loop is kept off the output CPU, unless it's the only one started with.
+  cpu_set_t cpu_set = s_startup_cpus;
+
+  if( cpu >= 0 ) {
+    CPU_ZERO( &cpu_set );
+    CPU_SET( cpu % cpus, &cpu_set );
+  } else if( role == REALTIME_ROLE_MAIN && output_cpu >= 0 ) {
+    CPU_ZERO( &cpu_set );
+    CPU_SET( output_cpu, &cpu_set );
+  } else if( output_cpu >= 0 && CPU_COUNT( &cpu_set ) > 1 ) {
+    CPU_CLR( output_cpu, &cpu_set );
+  }
+
+  if( pthread_setaffinity_np( pthread_self(), sizeof( cpu_set ), &cpu_set ) != 0 ) {
+    is_good = false;
+  }
+
+  if( role == REALTIME_ROLE_HOUSEKEEPING ) {
+    UpdateMemoryLock();
+  }
+
+  if( settings.m_enabled && settings.m_lock_memory ) {
+    PrefaultStack();
+  }
+
+  return is_good;
+};
+
+int Realtime::GetWorkerCPU( const int worker ) {
+  int kept_cpu;
+  {
+    std::lock_guard<std::mutex> lock( s_mutex );
+    kept_cpu = s_settings.m_enabled && s_settings.m_output_cpu >= 0 ? s_settings.m_output_cpu : 0;
+  }
+
+  const int cpus = GetAmountCPUs();
+  if( kept_cpu >= cpus ) {
+    kept_cpu = 0;
+  }
+
+  // The CPUs started with after the kept one, wrapping round & skipping it.
+  int amount = 0;
+  for( int step = 1; step < cpus; step++ ) {
+    amount += CPU_ISSET( ( kept_cpu + step ) % cpus, &s_startup_cpus ) ? 1 : 0;
+  }
+
+  if( amount == 0 ) {
+    return kept_cpu;
+  }
+
+  for( int step = 1, turn = worker % amount; step < cpus; step++ ) {
+    const int cpu = ( kept_cpu + step ) % cpus;
+    if( CPU_ISSET( cpu, &s_startup_cpus ) && turn-- == 0 ) {
+      return cpu;
+    }
+  }
+
+  return kept_cpu;
+};
+
+int Realtime::GetAmountCPUs() {
+  return std::max( 1u, std::thread::hardware_concurrency() );
+};
+
+void Realtime::SetMemoryLocked( const bool locked ) {
+  if( locked == s_is_memory_locked ) {
+    return;
+  }
+
+  if( locked ) {
+    // Freed memory stays in the heap rather than going back to the system, so it's never faulted in again.
+    mallopt( M_TRIM_THRESHOLD, -1 );
+    mallopt( M_MMAP_MAX, 0 );
+
+    if( mlockall( MCL_CURRENT | MCL_FUTURE ) != 0 ) {
+      MSG_REALTIME_ERROR( "Unable to lock memory, it needs root or a higher memlock limit." );
+      return;
+    }
+  } else {
+    munlockall();
+
+    // glibc's defaults.
+    mallopt( M_TRIM_THRESHOLD, 128 * 1024 );
+    mallopt( M_MMAP_MAX, 65536 );
+  }
+
+  s_is_memory_locked = locked;
+};
+
+cpu_set_t Realtime::GetCurrentCPUs() {
+  cpu_set_t cpu_set;
+  CPU_ZERO( &cpu_set );
+
+  if( sched_getaffinity( 0, sizeof( cpu_set ), &cpu_set ) != 0 ) {
+    for( int cpu = 0; cpu < GetAmountCPUs(); cpu++ ) {
+      CPU_SET( cpu, &cpu_set );
+    }
+  }
+
+  return cpu_set;
+};
+
+void Realtime::PrefaultStack() {
+  volatile uint8_t stack[ REALTIME_STACK_PREFAULT_BYTES ];
+
+  // A write to each page is enough.
+  for( size_t offset = 0; offset < sizeof( stack ); offset += 4096 ) {
+    stack[ offset ] = 0;
+  }
+};
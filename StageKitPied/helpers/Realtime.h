@@ -0,0 +1,94 @@
+#ifndef _REALTIME_H_
+#define _REALTIME_H_
+
+#define MSG_REALTIME_ERROR( str ) LOG_ERROR( "Realtime", str )
+#define MSG_REALTIME_INFO( str ) LOG_INFO( "Realtime", str )
+
+// What a thread does, each role has its own priority.
+#define REALTIME_ROLE_MAIN         0  // Main loop : network & serial input, the USB pod & SPI output.
+#define REALTIME_ROLE_RENDER       1  // Render & zone worker threads.
+#define REALTIME_ROLE_HOUSEKEEPING 2  // Ini reloading & anything else that can wait.
+#define REALTIME_ROLES             3
+
+#define REALTIME_PRIORITY_MAX          99
+#define REALTIME_STACK_PREFAULT_BYTES  ( 256 * 1024 )  // Stack touched by each thread, so it's never faulted in mid frame.
+
+#include <algorithm>  // max
+#include <atomic>
+#include <cstdint>
+#include <cstring>   // memset
+#include <iostream>
+#include <malloc.h>  // mallopt
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <thread>
+
+#include "helpers/Log.h"
+
+struct RealtimeSettings
+{
+  bool m_enabled;
+  bool m_lock_memory;                  // mlockall, & the heap kept rather than given back.
+  int  m_output_cpu;                   // CPU kept for the main loop alone, -1 for none.
+  int  m_priority[ REALTIME_ROLES ];   // SCHED_FIFO 1 - 99, 0 for normal scheduling.
+
+  RealtimeSettings() {
+    m_enabled     = false;
+    m_lock_memory = true;
+    m_output_cpu  = -1;
+    m_priority[ REALTIME_ROLE_MAIN ]         = 80;
+    m_priority[ REALTIME_ROLE_RENDER ]       = 70;
+    m_priority[ REALTIME_ROLE_HOUSEKEEPING ] = 0;
+  };
+
+  bool operator==( const RealtimeSettings& other ) const {
+    return m_enabled == other.m_enabled && m_lock_memory == other.m_lock_memory && m_output_cpu == other.m_output_cpu &&
+           std::memcmp( m_priority, other.m_priority, sizeof( m_priority ) ) == 0;
+  };
+};
+
+// Scheduling for the whole process.  Set from the main thread, then every thread takes it up for its own role by
+// calling Apply, at start & again whenever GetGeneration changes.  New threads inherit whatever their creator has,
+// so they need to Apply before doing anything else.
+// With it off, threads keep the CPUs the process started with, such as from taskset or systemd's CPUAffinity.
+class Realtime {
+public:
+  // Quick, memory is locked later by UpdateMemoryLock.  Does nothing if the settings haven't changed.
+  static void Set( const RealtimeSettings& settings );
+
+  // Locks or unlocks memory to match the settings.  Slow, mlockall faults in every page, so only done at start up
+  // & by housekeeping threads as they Apply, never on the main loop mid show.
+  static void UpdateMemoryLock();
+
+  // Changes each time Set does.
+  static uint32_t GetGeneration();
+
+  // Calling thread's priority & CPUs for its role, & its stack faulted in.  cpu pins it to that CPU rather
+  // than the role's.  Housekeeping threads update the memory lock too.  False if the system wouldn't allow it,
+  // usually for needing root.
+  static bool Apply( const int role, const int cpu = -1 );
+
+  // CPU for pinned worker n, taking turns round the CPUs started with, other than the output CPU.
+  static int GetWorkerCPU( const int worker );
+
+  static int GetAmountCPUs();
+
+private:
+  static void SetMemoryLocked( const bool locked );
+
+  static void PrefaultStack();
+
+  // CPUs the calling thread may run on.
+  static cpu_set_t GetCurrentCPUs();
+
+  static std::mutex            s_mutex;
+  static RealtimeSettings      s_settings;
+  static std::mutex            s_memory_mutex;     // Held while locking, so Set never waits on it.
+  static bool                  s_is_memory_locked;
+  static std::atomic<uint32_t> s_generation;
+  static cpu_set_t             s_startup_cpus;     // Taken before main, as the process was started.
+};
+
+#endif
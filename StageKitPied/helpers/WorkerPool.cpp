@@ -0,0 +1,135 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool() {
+  m_pinned     = false;
+  m_ptr_job    = NULL;
+  m_amount     = 0;
+  m_generation = 0;
+  m_remaining  = 0;
+  m_active     = 0;
+  m_stopping   = false;
+  m_next       = 0;
+};
+
+WorkerPool::~WorkerPool() {
+  this->Stop();
+};
+
+bool WorkerPool::Start( const int threads, const bool pinned ) {
+  this->Stop();
+
+  m_stopping = false;
+  m_pinned   = pinned;
+
+  for( int thread = 0; thread < threads; thread++ ) {
+    try {
+      m_threads.push_back( std::thread( &WorkerPool::Work, this, thread ) );
+    } catch( const std::system_error& ) {
+      // Fewer threads only means less runs at once.
+      return false;
+    }
+  }
+
+  return true;
+};
+
+void WorkerPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+
+  for( std::thread& thread : m_threads ) {
+    thread.join();
+  }
+  m_threads.clear();
+};
+
+int WorkerPool::GetAmountThreads() {
+  return m_threads.size();
+};
+
+void WorkerPool::Run( const int amount, const std::function<void( const int )>& job ) {
+  if( amount <= 0 ) {
+    return;
+  }
+
+  if( m_threads.empty() || amount == 1 ) {
+    for( int index = 0; index < amount; index++ ) {
+      job( index );
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_ptr_job   = &job;
+    m_amount    = amount;
+    m_remaining = amount;
+    m_next      = 0;
+    m_generation++;
+  }
+  m_wake.notify_all();
+
+  this->TakeJobs( &job, amount );
+
+  // Workers are out of TakeJobs as well, so none can pick up a job number from the next Run with this job.
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_done.wait( lock, [ this ] { return m_remaining == 0 && m_active == 0; } );
+  m_ptr_job = NULL;
+};
+
+void WorkerPool::Work( const int worker ) {
+  uint64_t generation = 0;
+  uint32_t realtime_generation = Realtime::GetGeneration();
+
+  // Not whatever the thread that started the pool has.  Failing only leaves it at normal priority.
+  Realtime::Apply( REALTIME_ROLE_RENDER, m_pinned ? Realtime::GetWorkerCPU( worker ) : -1 );
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true ) {
+    m_wake.wait( lock, [ & ] { return m_stopping || ( m_ptr_job != NULL && m_generation != generation ); } );
+    if( m_stopping ) {
+      return;
+    }
+
+    if( realtime_generation != Realtime::GetGeneration() ) {
+      realtime_generation = Realtime::GetGeneration();
+      lock.unlock();
+      Realtime::Apply( REALTIME_ROLE_RENDER, m_pinned ? Realtime::GetWorkerCPU( worker ) : -1 );
+      lock.lock();
+    }
+
+    generation = m_generation;
+    const std::function<void( const int )>* ptr_job = m_ptr_job;
+    const int amount = m_amount;
+    m_active++;
+
+    lock.unlock();
+    this->TakeJobs( ptr_job, amount );
+    lock.lock();
+
+    if( --m_active == 0 && m_remaining == 0 ) {
+      m_done.notify_all();
+    }
+  }
+};
+
+void WorkerPool::TakeJobs( const std::function<void( const int )>* ptr_job, const int amount ) {
+  int index = m_next.fetch_add( 1 );
+
+  while( index < amount ) {
+    ( *ptr_job )( index );
+
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      if( --m_remaining == 0 && m_active == 0 ) {
+        m_done.notify_all();
+      }
+    }
+
+    index = m_next.fetch_add( 1 );
+  }
+};
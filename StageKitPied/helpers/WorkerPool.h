@@ -0,0 +1,60 @@
+#ifndef _WORKERPOOL_H_
+#define _WORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>  // NULL
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "helpers/Realtime.h"
+
+// A few threads kept waiting for work, so a frame's jobs can be spread out without starting threads each time.
+// Run hands out job numbers to the workers & the calling thread, & returns once every job has finished.
+// Workers take the REALTIME_ROLE_RENDER scheduling.
+class WorkerPool {
+public:
+  WorkerPool();
+
+  ~WorkerPool();
+
+  // Threads on top of the one calling Run.  0 runs everything on the caller.
+  // pinned keeps each thread on a CPU of its own, away from the caller's, see Realtime::GetWorkerCPU.
+  bool Start( const int threads, const bool pinned = false );
+
+  void Stop();
+
+  int GetAmountThreads();
+
+  // Calls job( 0 ) to job( amount - 1 ), each once, in no set order.  Only one Run at a time.
+  void Run( const int amount, const std::function<void( const int )>& job );
+
+private:
+  void Work( const int worker );
+
+  // Runs jobs until none are left.
+  void TakeJobs( const std::function<void( const int )>* ptr_job, const int amount );
+
+  std::vector<std::thread> m_threads;
+  bool                     m_pinned;
+
+  std::mutex              m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+
+  // The current Run, set under the mutex.
+  const std::function<void( const int )>* m_ptr_job;
+  int                     m_amount;
+  uint64_t                m_generation;
+  int                     m_remaining;  // Jobs not finished.
+  int                     m_active;     // Workers still taking jobs from this Run.
+  bool                    m_stopping;
+
+  std::atomic<int>        m_next;       // Next job number to hand out.
+};
+
+#endif
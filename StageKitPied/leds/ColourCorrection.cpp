@@ -0,0 +1,127 @@
+#include "ColourCorrection.h"
+
+ColourCorrection::ColourCorrection() {
+  const int16_t identity[ 3 ][ 3 ] = { { LEDLAYOUT_MATRIX_ONE, 0, 0 },
+                                       { 0, LEDLAYOUT_MATRIX_ONE, 0 },
+                                       { 0, 0, LEDLAYOUT_MATRIX_ONE } };
+  this->Set( GAMMA_LINEAR, identity );
+};
+
+ColourCorrection::~ColourCorrection() {
+};
+
+void ColourCorrection::Set( const int gamma_tenths, const int16_t matrix[ 3 ][ 3 ] ) {
+  const int gamma = GammaFindTable( gamma_tenths ) != NULL ? gamma_tenths : GAMMA_LINEAR;
+  m_ptr_gamma   = GammaFindTable( gamma );
+  m_ptr_gamma16 = GammaFindTable16( gamma );
+
+  m_is_active = m_ptr_gamma != GammaFindTable( GAMMA_LINEAR );
+  m_is_mixing = false;
+
+  for( int out = 0; out < 3; out++ ) {
+    for( int in = 0; in < 3; in++ ) {
+      if( in == out ) {
+        m_is_active = m_is_active || matrix[ out ][ in ] != LEDLAYOUT_MATRIX_ONE;
+      } else {
+        m_is_mixing = m_is_mixing || matrix[ out ][ in ] != 0;
+      }
+
+      for( int value = 0; value < 256; value++ ) {
+        m_mix[ out ][ in ][ value ] = ( value * matrix[ out ][ in ] ) / LEDLAYOUT_MATRIX_ONE;
+      }
+    }
+
+    for( int value = 0; value < 256; value++ ) {
+      const int scaled = std::clamp<int>( m_mix[ out ][ out ][ value ], 0, 255 );
+      m_channel[ out ][ value ]   = ( *m_ptr_gamma )[ scaled ];
+      m_channel16[ out ][ value ] = ( *m_ptr_gamma16 )[ scaled ];
+    }
+  }
+
+  m_is_active = m_is_active || m_is_mixing;
+};
+
+bool ColourCorrection::IsActive() {
+  return m_is_active;
+};
+
+void ColourCorrection::Apply( Pixel* ptr_frame, const uint32_t amount ) {
+  if( !m_is_active ) {
+    return;
+  }
+
+  // Groups light their LEDs one colour, so a frame is mostly runs of the same pixel.  Unlit LEDs stay unlit.
+  Pixel last_in  = 0;
+  Pixel last_out = 0;
+
+  for( uint32_t i = 0; i < amount; i++ ) {
+    const Pixel pixel = ptr_frame[ i ];
+    if( pixel == last_in || ( pixel & ~PIXEL_BRIGHTNESS ) == 0 ) {
+      ptr_frame[ i ] = pixel == last_in ? last_out : pixel;
+      continue;
+    }
+
+    last_in  = pixel;
+    last_out = this->Correct( pixel );
+    ptr_frame[ i ] = last_out;
+  }
+};
+
+Pixel ColourCorrection::Correct( const Pixel pixel ) {
+  const uint8_t red   = PixelRed( pixel );
+  const uint8_t green = PixelGreen( pixel );
+  const uint8_t blue  = PixelBlue( pixel );
+
+  if( !m_is_mixing ) {
+    return PixelPack( m_channel[ 0 ][ red ], m_channel[ 1 ][ green ], m_channel[ 2 ][ blue ], PixelBrightness( pixel ) );
+  }
+
+  const GammaTable& gamma = *m_ptr_gamma;
+  uint8_t colour[ 3 ];
+
+  for( int out = 0; out < 3; out++ ) {
+    const int value = m_mix[ out ][ 0 ][ red ] + m_mix[ out ][ 1 ][ green ] + m_mix[ out ][ 2 ][ blue ];
+    colour[ out ] = gamma[ std::clamp( value, 0, 255 ) ];
+  }
+
+  return PixelPack( colour[ 0 ], colour[ 1 ], colour[ 2 ], PixelBrightness( pixel ) );
+};
+
+void ColourCorrection::Expand( const Pixel* ptr_frame, uint16_t* ptr_colour, const uint32_t amount ) {
+  Pixel    last_in = 0;
+  uint16_t last_out[ 3 ] = { 0, 0, 0 };
+
+  for( uint32_t i = 0; i < amount; i++ ) {
+    const Pixel pixel = ptr_frame[ i ];
+    if( pixel != last_in ) {
+      last_in = pixel;
+      this->Correct16( pixel, last_out );
+    }
+
+    ptr_colour[ 0 ] = last_out[ 0 ];
+    ptr_colour[ 1 ] = last_out[ 1 ];
+    ptr_colour[ 2 ] = last_out[ 2 ];
+    ptr_colour += 3;
+  }
+};
+
+void ColourCorrection::Correct16( const Pixel pixel, uint16_t colour[ 3 ] ) {
+  const uint8_t  red   = PixelRed( pixel );
+  const uint8_t  green = PixelGreen( pixel );
+  const uint8_t  blue  = PixelBlue( pixel );
+  const uint32_t scale = ( PixelBrightness( pixel ) & 0x1F ) * COLOURCORRECTION_BRIGHTNESS_SCALE;
+
+  if( !m_is_mixing ) {
+    colour[ 0 ] = ( m_channel16[ 0 ][ red ] * scale ) >> 16;
+    colour[ 1 ] = ( m_channel16[ 1 ][ green ] * scale ) >> 16;
+    colour[ 2 ] = ( m_channel16[ 2 ][ blue ] * scale ) >> 16;
+    return;
+  }
+
+  const GammaTable16& gamma = *m_ptr_gamma16;
+
+  for( int out = 0; out < 3; out++ ) {
+    const int value = m_mix[ out ][ 0 ][ red ] + m_mix[ out ][ 1 ][ green ] + m_mix[ out ][ 2 ][ blue ];
+    colour[ out ] = ( gamma[ std::clamp( value, 0, 255 ) ] * scale ) >> 16;
+  }
+};
@@ -0,0 +1,49 @@
+#ifndef _COLOURCORRECTION_H_
+#define _COLOURCORRECTION_H_
+
+#define COLOURCORRECTION_BRIGHTNESS_SCALE 2114  // 65536 / 31, brightness 0 - 31 to 16 bit fraction.
+
+#include <algorithm>  // clamp
+#include <cstdint>
+
+#include "leds/GammaTables.h"
+#include "leds/LEDLayout.h"
+#include "leds/PixelKernels.h"
+
+// Gamma & colour matrix for a profile, applied to the finished frame as table lookups.
+// The tables are built once per profile, so correcting a frame is only lookups, adds & clamps.
+class ColourCorrection {
+public:
+  ColourCorrection();
+
+  ~ColourCorrection();
+
+  // Gamma in tenths, matrix in 1/LEDLAYOUT_MATRIX_ONE units.
+  void Set( const int gamma_tenths, const int16_t matrix[ 3 ][ 3 ] );
+
+  // False when it would leave every pixel as it is.
+  bool IsActive();
+
+  void Apply( Pixel* ptr_frame, const uint32_t amount );
+
+  // Corrects into 16 bit red, green & blue per LED with the pixel's brightness folded in, for LEDDither.
+  // 65535 is full colour at brightness 31.
+  void Expand( const Pixel* ptr_frame, uint16_t* ptr_colour, const uint32_t amount );
+
+private:
+  Pixel Correct( const Pixel pixel );
+
+  void Correct16( const Pixel pixel, uint16_t colour[ 3 ] );
+
+  bool m_is_active;
+  bool m_is_mixing;   // Matrix has entries off the diagonal.
+
+  const GammaTable*   m_ptr_gamma;
+  const GammaTable16* m_ptr_gamma16;
+
+  uint8_t  m_channel[ 3 ][ 256 ];    // No mixing : gamma of the scaled channel.
+  uint16_t m_channel16[ 3 ][ 256 ];
+  int16_t m_mix[ 3 ][ 3 ][ 256 ];   // Mixing : each input's share of each output.
+};
+
+#endif
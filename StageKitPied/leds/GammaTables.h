@@ -0,0 +1,138 @@
+#ifndef _GAMMATABLES_H_
+#define _GAMMATABLES_H_
+
+#include <array>
+#include <cstddef>  // NULL
+#include <cstdint>
+
+// 8 bit gamma tables, built by the compiler.  Gammas are in tenths, so 22 is 2.2.
+// Only the table build uses floating point, looking a value up is a plain index.
+
+#define GAMMA_LINEAR  10  // No correction.
+#define GAMMA_TABLES  7
+
+typedef std::array<uint8_t, 256>  GammaTable;
+typedef std::array<uint16_t, 256> GammaTable16;  // 0 - 65535, for high depth rendering.
+
+static constexpr int GAMMA_VALUES[ GAMMA_TABLES ] = { 10, 18, 20, 22, 24, 26, 28 };
+
+// std::log & std::exp aren't constexpr, so these are series with the range cut down first.
+constexpr double GammaLog( double x ) {
+  constexpr double ln2 = 0.69314718055994530942;
+
+  // x = m * 2^k, m 0.5 - 1.
+  int k = 0;
+  while( x < 0.5 ) {
+    x *= 2.0;
+    k--;
+  }
+  while( x >= 1.0 ) {
+    x /= 2.0;
+    k++;
+  }
+
+  // ln( m ) = 2 * atanh( ( m - 1 ) / ( m + 1 ) ), quick for m near 1.
+  const double y  = ( x - 1.0 ) / ( x + 1.0 );
+  const double y2 = y * y;
+  double term = y;
+  double sum  = 0.0;
+  for( int n = 1; n < 60; n += 2 ) {
+    sum  += term / n;
+    term *= y2;
+  }
+
+  return 2.0 * sum + k * ln2;
+};
+
+constexpr double GammaExp( const double x ) {
+  constexpr double ln2 = 0.69314718055994530942;
+
+  // e^x = 2^n * e^r, r under ln2.
+  const int n = (int)( x / ln2 );
+  const double r = x - n * ln2;
+
+  double term = 1.0;
+  double sum  = 1.0;
+  for( int i = 1; i < 30; i++ ) {
+    term *= r / i;
+    sum  += term;
+  }
+
+  for( int i = 0; i < n; i++ ) {
+    sum *= 2.0;
+  }
+  for( int i = 0; i > n; i-- ) {
+    sum /= 2.0;
+  }
+
+  return sum;
+};
+
+constexpr GammaTable GammaMakeTable( const int gamma_tenths ) {
+  GammaTable table = {};
+
+  for( int value = 1; value < 256; value++ ) {
+    const double corrected = GammaExp( GammaLog( value / 255.0 ) * gamma_tenths / 10.0 ) * 255.0 + 0.5;
+    table[ value ] = corrected >= 255.0 ? 255 : (uint8_t)corrected;
+  }
+
+  return table;
+};
+
+constexpr GammaTable16 GammaMakeTable16( const int gamma_tenths ) {
+  GammaTable16 table = {};
+
+  for( int value = 1; value < 256; value++ ) {
+    const double corrected = GammaExp( GammaLog( value / 255.0 ) * gamma_tenths / 10.0 ) * 65535.0 + 0.5;
+    table[ value ] = corrected >= 65535.0 ? 65535 : (uint16_t)corrected;
+  }
+
+  return table;
+};
+
+static constexpr GammaTable GAMMA_TABLE[ GAMMA_TABLES ] = {
+  GammaMakeTable( GAMMA_VALUES[ 0 ] ),
+  GammaMakeTable( GAMMA_VALUES[ 1 ] ),
+  GammaMakeTable( GAMMA_VALUES[ 2 ] ),
+  GammaMakeTable( GAMMA_VALUES[ 3 ] ),
+  GammaMakeTable( GAMMA_VALUES[ 4 ] ),
+  GammaMakeTable( GAMMA_VALUES[ 5 ] ),
+  GammaMakeTable( GAMMA_VALUES[ 6 ] ),
+};
+
+static constexpr GammaTable16 GAMMA_TABLE16[ GAMMA_TABLES ] = {
+  GammaMakeTable16( GAMMA_VALUES[ 0 ] ),
+  GammaMakeTable16( GAMMA_VALUES[ 1 ] ),
+  GammaMakeTable16( GAMMA_VALUES[ 2 ] ),
+  GammaMakeTable16( GAMMA_VALUES[ 3 ] ),
+  GammaMakeTable16( GAMMA_VALUES[ 4 ] ),
+  GammaMakeTable16( GAMMA_VALUES[ 5 ] ),
+  GammaMakeTable16( GAMMA_VALUES[ 6 ] ),
+};
+
+static_assert( GAMMA_TABLE[ 0 ][ 128 ] == 128, "Linear gamma table must be unchanged." );
+static_assert( GAMMA_TABLE[ 3 ][ 255 ] == 255 && GAMMA_TABLE[ 3 ][ 128 ] == 56, "Gamma 2.2 table is off." );
+static_assert( GAMMA_TABLE16[ 0 ][ 128 ] == 128 * 257 && GAMMA_TABLE16[ 3 ][ 255 ] == 65535, "16 bit gamma tables are off." );
+
+// Index of the tables for a gamma in tenths, -1 if there aren't any.
+inline int GammaFindIndex( const int gamma_tenths ) {
+  for( int index = 0; index < GAMMA_TABLES; index++ ) {
+    if( GAMMA_VALUES[ index ] == gamma_tenths ) {
+      return index;
+    }
+  }
+  return -1;
+};
+
+// Table for a gamma in tenths, NULL if there isn't one.
+inline const GammaTable* GammaFindTable( const int gamma_tenths ) {
+  const int index = GammaFindIndex( gamma_tenths );
+  return index < 0 ? NULL : &GAMMA_TABLE[ index ];
+};
+
+inline const GammaTable16* GammaFindTable16( const int gamma_tenths ) {
+  const int index = GammaFindIndex( gamma_tenths );
+  return index < 0 ? NULL : &GAMMA_TABLE16[ index ];
+};
+
+#endif
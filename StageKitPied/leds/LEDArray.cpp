@@ -3,38 +3,60 @@
 
 LEDArray::LEDArray() {
   m_is_init = false;
-  m_SK_LED_Number[ 0 ] = SK_LED_1;
-  m_SK_LED_Number[ 1 ] = SK_LED_2;
-  m_SK_LED_Number[ 2 ] = SK_LED_3;
-  m_SK_LED_Number[ 3 ] = SK_LED_4;
-  m_SK_LED_Number[ 4 ] = SK_LED_5;
-  m_SK_LED_Number[ 5 ] = SK_LED_6;
-  m_SK_LED_Number[ 6 ] = SK_LED_7;
-  m_SK_LED_Number[ 7 ] = SK_LED_8;
+  m_ptr_profile.store( NULL );
+  m_strobe_on = false;
+  m_is_dirty  = false;
+  m_frame_rate = LEDARRAY_FRAME_RATE_DEFAULT;
+  m_frame_interval_us = 1000000 / LEDARRAY_FRAME_RATE_DEFAULT;
+  m_is_high_depth = false;
+  m_is_dithering  = false;
+  m_render_threads = 1;
+  m_shard_amount   = 0;
+  m_shard_leds     = LEDARRAY_SHARD_LEDS;
+  m_ptr_draw_time  = Metrics::Histogram( "skp_frame_draw_seconds", "Time to draw & submit a frame." );
+  for( int layer = 0; layer < LEDLAYOUT_COLOURS; layer++ ) {
+    m_layers[ layer ] = 0;
+  }
 };
 
 LEDArray::~LEDArray() {
   this->TurnOff();
+  mRenderPool.Stop();
 };
 
 bool LEDArray::SetEnabled( const bool enabled ) {
-  return mSK9822.SetEnabled( enabled );
+  if( !m_is_init ) {
+    return false;
+  }
+  return mOutput->SetEnabled( enabled );
 };
 
 void LEDArray::TurnOff() {
   if( m_is_init ) {
-    mSK9822.AllOff();
-    mSK9822.Update();
+    mOutput->AllOff();
+    mOutput->Submit();
   }
+
+  mCompositor.Invalidate();
 };
 
-bool LEDArray::Init( const std::string& device_name, const int led_amount ) {
+bool LEDArray::Init( const std::string& type, const std::string& device_name, const int led_amount ) {
+  MSG_LEDARRAY_INFO( "Type   = " << ( type.empty() ? "SK9822" : type ) );
   MSG_LEDARRAY_INFO( "Device = " << device_name );
   MSG_LEDARRAY_INFO( "LEDS   = " << led_amount );
 
   this->TurnOff();
 
-  m_is_init = mSK9822.Init( led_amount, device_name );
+  mOutput = LEDOutput::Create( type );
+  m_is_init = mOutput != NULL && mOutput->Init( led_amount, device_name );
+  mCompositor.Init( m_is_init ? led_amount : 0 );
+  mDither.Init( m_is_init ? led_amount : 0 );
+  mDither.SetUseBrightness( m_is_init && mOutput->HasBrightness() );
+  m_colour.assign( m_is_init ? led_amount * 3 : 0, 0 );
+  m_dither_frame.assign( m_is_init ? led_amount : 0, 0 );
+  m_remap.clear();
+  mRemap.Clear();
+  this->UpdateShards();
   if( !m_is_init ) {
     this->TurnOff();
   }
@@ -42,288 +64,417 @@ bool LEDArray::Init( const std::string& device_name, const int led_amount ) {
   return m_is_init;
 };
 
-bool LEDArray::LoadSettingsSK( const std::string& ini_file ) {
+bool LEDArray::LoadProfiles( const std::vector<std::string>& ini_files ) {
+  bool loaded = false;
 
-  INI_Handler ini_handler;
+  m_ptr_profile.store( NULL );
+  m_profiles.clear();
+  m_profiles.resize( ini_files.size() );
 
-  if( !ini_handler.Load( ini_file ) ) {
-    MSG_LEDARRAY_ERROR( "SK INI file not loaded." << ini_file );
-    MSG_LEDARRAY_ERROR( "  - " << ini_handler.GetErrorMessage() );
-    return false;
+  for( size_t profile_id = 0; profile_id < ini_files.size(); profile_id++ ) {
+    std::unique_ptr<LEDProfile> profile( new LEDProfile( profile_id ) );
+
+    if( profile->Load( ini_files[ profile_id ], this->GetAmountLEDS() ) ) {
+      m_profiles[ profile_id ] = std::move( profile );
+      loaded = true;
+    } else {
+      MSG_LEDARRAY_ERROR( "Failed to load LED profile " << profile_id << " : " << ini_files[ profile_id ] );
+    }
   }
 
-  if( !ini_handler.SetSection( "SK_COLOURS" ) ) {
+  return loaded;
+};
+
+bool LEDArray::SelectProfile( const int profile_id ) {
+  if( !this->IsProfileLoaded( profile_id ) ) {
     return false;
   }
-  // **** COLOURS ****
-
-  std::stringstream rgb;   // Line from ini
-  std::string red;         // Red value string
-  std::string green;       // Green value string
-  std::string blue;        // Blue value string
-
-  // Load RGB values for red
-  rgb.str( ini_handler.GetTokenString( "RGB_RED" ) );
-
-  std::getline( rgb, red, ',' );
-  std::getline( rgb, green, ',' );
-  std::getline( rgb, blue, ',' );
-
-  int red_r = std::stoi( red );
-  int red_g = std::stoi( green );
-  int red_b = std::stoi( blue );
-
-
-  MSG_LEDARRAY_DEBUG("RGB_RED = " << red << "," << green << "," << blue );
-
-  // Load RGB values for green
-  rgb.clear();
-  rgb.str( ini_handler.GetTokenString( "RGB_GREEN" ) );
-
-  std::getline( rgb, red, ',' );
-  std::getline( rgb, green, ',' );
-  std::getline( rgb, blue, ',' );
-
-  int green_r = std::stoi( red );
-  int green_g = std::stoi( green );
-  int green_b = std::stoi( blue );
-
-  MSG_LEDARRAY_DEBUG("RGB_GREEN = " << red << "," << green << "," << blue );
-
-  // Load RGB values for blue
-  rgb.clear();
-  rgb.str( ini_handler.GetTokenString( "RGB_BLUE" ) );
-
-  std::getline( rgb, red, ',' );
-  std::getline( rgb, green, ',' );
-  std::getline( rgb, blue, ',' );
-
-  int blue_r = std::stoi( red );
-  int blue_g = std::stoi( green );
-  int blue_b = std::stoi( blue );
-
-  MSG_LEDARRAY_DEBUG("RGB_BLUE = " << red << "," << green << "," << blue );
-
-  // Load RGB values for yellow
-  rgb.clear();
-  rgb.str( ini_handler.GetTokenString( "RGB_YELLOW" ) );
-
-  std::getline( rgb, red, ',' );
-  std::getline( rgb, green, ',' );
-  std::getline( rgb, blue, ',' );
-
-  int yellow_r = std::stoi( red );
-  int yellow_g = std::stoi( green );
-  int yellow_b = std::stoi( blue );
-
-  MSG_LEDARRAY_DEBUG("RGB_YELLOW = " << red << "," << green << "," << blue );
-
-  // Load RGB values for strobe
-  rgb.clear();
-  rgb.str( ini_handler.GetTokenString( "RGB_STROBE" ) );
-
-  std::getline( rgb, red, ',' );
-  std::getline( rgb, green, ',' );
-  std::getline( rgb, blue, ',' );
-
-  int strobe_r = std::stoi( red );
-  int strobe_g = std::stoi( green );
-  int strobe_b = std::stoi( blue );
-
-   MSG_LEDARRAY_DEBUG("RGB_STROBE = " << red << "," << green << "," << blue );
-
-  // Load all 8 sections for each colour
-  std::string section_name;
-  for( int i = 0; i < 8; i++ ) {
-    section_name = "RED_GROUP_";
-    section_name += std::to_string(i + 1);
-    MSG_LEDARRAY_DEBUG("Loading RED Group = " << section_name);
-    this->LoadLEDData( &ini_handler, section_name, &m_LEDGroups_Red[ i ], red_r, red_g, red_b  );
-    section_name = "GREEN_GROUP_";
-    section_name += std::to_string(i + 1);
-    MSG_LEDARRAY_DEBUG("Loading GREEN Group = " << section_name);
-    this->LoadLEDData( &ini_handler, section_name, &m_LEDGroups_Green[ i ], green_r, green_g, green_b );
-    section_name = "BLUE_GROUP_";
-    section_name += std::to_string(i + 1);
-    MSG_LEDARRAY_DEBUG("Loading BLUE Group = " << section_name);
-    this->LoadLEDData( &ini_handler, section_name, &m_LEDGroups_Blue[ i ], blue_r, blue_g, blue_b );
-    section_name = "YELLOW_GROUP_";
-    section_name += std::to_string(i + 1);
-    MSG_LEDARRAY_DEBUG("Loading YELLOW Group = " << section_name);
-    this->LoadLEDData( &ini_handler, section_name, &m_LEDGroups_Yellow[ i ], yellow_r, yellow_g, yellow_b );
-  }
 
-  // **** STROBE ****
-  section_name = "STROBE";
+  m_ptr_profile.store( m_profiles[ profile_id ].get() );
 
-  if( ini_handler.SetSection( section_name ) ) {
-    int strobe_all = ini_handler.GetTokenValue( "LEDS_ALL" );
-    if( strobe_all == 1 ) {
-      // Build the strobe group
-      m_LEDGroup_Strobe.SetNumberOfLEDS( mSK9822.GetAmountLEDS() );
-      m_LEDGroup_Strobe.SetRGB( strobe_r, strobe_g, strobe_b );
-      m_LEDGroup_Strobe.SetBrightness( (uint8_t) ini_handler.GetTokenValue( "BRIGHTNESS" ) );
+  return true;
+};
 
-      for( int led_number = 1; led_number < mSK9822.GetAmountLEDS() + 1; led_number++ ) {
-        m_LEDGroup_Strobe.LoadLED( led_number );
-      }
+int LEDArray::GetProfile() {
+  LEDProfile* ptr_profile = m_ptr_profile.load();
 
-    } else {
-      int strobe_auto = ini_handler.GetTokenValue( "LEDS_AUTO" );
-      if( strobe_auto != 1 ) {
-        // Load strobe LED numbers from ini
-        this->LoadLEDData( &ini_handler, section_name, &m_LEDGroup_Strobe, strobe_r, strobe_g, strobe_b );
-      } else {
-        // Build strobe LED numbers from unassigned LEDs
-        int* strobe_leds = new int[ mSK9822.GetAmountLEDS() ];
-        int strobe_leds_amount = 0;
-        bool found;
-
-        for( int led_number = 1; led_number < mSK9822.GetAmountLEDS() + 1; led_number++ ) {
-          found = false;
-          for( int section_number = 0; section_number < 8 && !found; section_number++ ) {
-            if( !found && m_LEDGroups_Red[ section_number ].HasLED( led_number ) ) {
-              found = true;
-            } else if ( !found && m_LEDGroups_Green[ section_number ].HasLED( led_number ) ) {
-              found = true;
-            } else if ( !found && m_LEDGroups_Blue[ section_number ].HasLED( led_number ) ) {
-              found = true;
-            } else if ( !found && m_LEDGroups_Yellow[ section_number ].HasLED( led_number ) ) {
-              found = true;
-            }
-          }
-
-          if( !found ) {
-            strobe_leds[ strobe_leds_amount ] = led_number;
-            strobe_leds_amount++;
-          }
-        }
+  if( ptr_profile == NULL ) {
+    return -1;
+  }
 
-        // Build the strobe group
-        m_LEDGroup_Strobe.SetNumberOfLEDS( strobe_leds_amount );
-        m_LEDGroup_Strobe.SetRGB( strobe_r, strobe_g, strobe_b );
-        m_LEDGroup_Strobe.SetBrightness( (uint8_t) ini_handler.GetTokenValue( "BRIGHTNESS" ) );
+  return ptr_profile->GetID();
+};
 
-        for( int i = 0; i < strobe_leds_amount; i++ ) {
-          m_LEDGroup_Strobe.LoadLED( strobe_leds[ i ] );
-        }
+int LEDArray::GetAmountProfiles() {
+  return m_profiles.size();
+};
 
-        delete [] strobe_leds;
-      }
-    }
+bool LEDArray::IsProfileLoaded( const int profile_id ) {
+  if( profile_id < 0 || profile_id >= (int)m_profiles.size() ) {
+    return false;
   }
 
-  MSG_LEDARRAY_INFO( "Settings loaded from INI." );
-
-  return true;
+  return m_profiles[ profile_id ] != NULL;
 };
 
-void LEDArray::LoadLEDData( INI_Handler* ptrINI_Handler, const std::string& section_name, LEDGroup* ptr_led_group, const uint8_t red, const uint8_t green, const uint8_t blue ) {
-  if( !ptrINI_Handler->SetSection( section_name ) ) {
-    return;
-  }
-  uint8_t amount_of_leds = (uint8_t) ptrINI_Handler->GetTokenValue( "AMOUNT" );
-  std::stringstream leds;
-  leds.str( ptrINI_Handler->GetTokenString( "LEDS" ) );
+std::unique_ptr<LEDProfile> LEDArray::ReplaceProfile( std::unique_ptr<LEDProfile> profile ) {
+  const int profile_id = profile->GetID();
 
-  ptr_led_group->SetNumberOfLEDS( amount_of_leds );
-  ptr_led_group->SetRGB( red, green, blue );
+  if( profile_id < 0 || profile_id >= (int)m_profiles.size() ) {
+    return profile;
+  }
 
-  std::string tmp;
-  for( int i = 0; i < amount_of_leds; i++ ) {
-    std::getline( leds, tmp, ',' );
-    ptr_led_group->LoadLED( std::stoi( tmp ) );
+  if( m_profiles[ profile_id ] != NULL && m_ptr_profile.load() == m_profiles[ profile_id ].get() ) {
+    m_ptr_profile.store( profile.get() );
   }
 
-  ptr_led_group->SetBrightness( (uint8_t) ptrINI_Handler->GetTokenValue( "BRIGHTNESS" ) );
-}
+  m_profiles[ profile_id ].swap( profile );
+
+  return profile;
+};
 
 void LEDArray::SetLights( const uint8_t colour, const uint8_t leds ) {
   switch( colour ) {
     case SK_ALL_OFF:
-      mSK9822.AllOff();
+      for( int layer = 0; layer < LEDLAYOUT_COLOURS; layer++ ) {
+        m_layers[ layer ] = 0;
+      }
       break;
     case SK_LED_RED:
-      this->SetLEDS( leds, m_LEDGroups_Red );
+      m_layers[ LEDLAYOUT_RED ] = leds;
       break;
     case SK_LED_GREEN:
-      this->SetLEDS( leds, m_LEDGroups_Green );
+      m_layers[ LEDLAYOUT_GREEN ] = leds;
       break;
     case SK_LED_BLUE:
-      this->SetLEDS( leds, m_LEDGroups_Blue );
+      m_layers[ LEDLAYOUT_BLUE ] = leds;
       break;
     case SK_LED_YELLOW:
-      this->SetLEDS( leds, m_LEDGroups_Yellow );
+      m_layers[ LEDLAYOUT_YELLOW ] = leds;
       break;
     default:
       return;
   }
-  mSK9822.Update();
+  m_is_dirty = true;
 };
 
-void LEDArray::SetLEDS( const uint8_t leds, LEDGroup the_led_groups[] ) {
-  int     number_leds;
-  int*    led_numbers;
-  uint8_t red;
-  uint8_t green;
-  uint8_t blue;
-  uint8_t brightness;
+void LEDArray::Render( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t yellow ) {
+  m_layers[ LEDLAYOUT_RED ]    = red;
+  m_layers[ LEDLAYOUT_GREEN ]  = green;
+  m_layers[ LEDLAYOUT_BLUE ]   = blue;
+  m_layers[ LEDLAYOUT_YELLOW ] = yellow;
+  m_is_dirty = true;
 
-  for( uint8_t sk_led_number = 0; sk_led_number < 8; sk_led_number++ ) {
-    if( ( leds & m_SK_LED_Number[ sk_led_number ] ) == 0 ) {
-      brightness = 0;
-    } else {
-      brightness = the_led_groups[ sk_led_number ].GetBrightness();
+  this->Flush();
+};
+
+void LEDArray::Strobe( const bool on ) {
+  this->Strobe( on, std::chrono::steady_clock::now() );
+};
+
+bool LEDArray::Flush() {
+  return this->Flush( std::chrono::steady_clock::now() );
+};
+
+void LEDArray::Strobe( const bool on, const std::chrono::steady_clock::time_point time_now ) {
+  // Flash straight away, the strobe timing depends on it.
+  m_strobe_on = on;
+
+  this->Draw( time_now, true );
+};
+
+bool LEDArray::Flush( const std::chrono::steady_clock::time_point time_now ) {
+  if( m_is_dirty ) {
+    this->Draw( time_now, true );
+    return true;
+  }
+
+  // Only fades, the sweep & dithering need drawing, at the frame rate.
+  if( !this->IsAnimating() || time_now - m_frame_time < std::chrono::microseconds( m_frame_interval_us ) ) {
+    return false;
+  }
+
+  this->Draw( time_now, mCompositor.IsAnimating() );
+
+  return true;
+};
+
+void LEDArray::Draw( const std::chrono::steady_clock::time_point time_now, const bool recomposite ) {
+  ALLOC_SCOPE( "leds" );
+
+  LEDProfile* ptr_profile = m_ptr_profile.load();
+
+  if( recomposite ) {
+    // A fade starting now hasn't had any time yet.
+    long elapsed_us = 0;
+    if( mCompositor.IsAnimating() ) {
+      elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>( time_now - m_frame_time ).count();
     }
-    number_leds = the_led_groups[ sk_led_number ].GetNumberOfLEDS();
-    led_numbers = the_led_groups[ sk_led_number ].GetLEDs();
-    red         = the_led_groups[ sk_led_number ].GetRed();
-    green       = the_led_groups[ sk_led_number ].GetGreen();
-    blue        = the_led_groups[ sk_led_number ].GetBlue();
-
-    for( int i = 0; i < number_leds; i++ ) {
-      mSK9822.SetColour( *led_numbers, red, green, blue, brightness );
-      led_numbers++;
+
+    // Groups land anywhere in the frame, so blending stays on this thread.
+    mCompositor.Fade( m_layers, elapsed_us );
+    mCompositor.Composite( ptr_profile, m_strobe_on );
+  }
+
+  if( !m_is_init ) {
+    return;
+  }
+
+  const std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+
+  // Jobs capture this & one pointer, which std::function holds without allocating.  More & it would, every frame.
+  // While dithering every LED moves each frame, otherwise only the blocks the compositor redrew.
+  struct DrawJob {
+    LEDProfile*       ptr_profile;
+    bool              recomposite;
+    bool              is_whole;
+    bool              is_remapped;
+    std::atomic<bool> is_dithering;
+  } job = { ptr_profile, recomposite, !recomposite || m_is_dithering, mRemap.IsActive(), { false } };
+
+  // Run returns once every shard is done, so the whole frame is ready for Submit.
+  mRenderPool.Run( m_shard_amount, [ this, &job ]( const int shard ) {
+    if( this->DrawShard( shard, job.ptr_profile, job.recomposite, job.is_whole, !job.is_remapped ) ) {
+      job.is_dithering = true;
     }
+  } );
+
+  // A remap gathers from anywhere in the frame, so waits for all of it to be drawn.
+  if( job.is_remapped ) {
+    mRenderPool.Run( m_shard_amount, [ this, &job ]( const int shard ) {
+      this->SendShard( shard, job.recomposite, job.is_whole );
+    } );
   }
+
+  m_is_dithering = job.is_dithering;
+  mOutput->Submit();
+  m_ptr_draw_time->ObserveSince( time_start );
+
+  m_is_dirty   = false;
+  m_frame_time = time_now;
 };
 
-void LEDArray::Strobe( const bool on ) {
-  int     number_leds;
-  int*    led_numbers;
-  uint8_t red;
-  uint8_t green;
-  uint8_t blue;
-  uint8_t brightness;
-
-  if( on ) {
-    brightness = m_LEDGroup_Strobe.GetBrightness();
-  } else {
-    brightness = 0;
+bool LEDArray::DrawShard( const int shard, LEDProfile* ptr_profile, const bool recomposite, const bool is_whole, const bool send ) {
+  ALLOC_SCOPE( "leds" );
+
+  const uint32_t first  = shard * m_shard_leds;
+  const uint32_t last   = std::min<uint32_t>( first + m_shard_leds, mCompositor.GetAmountLEDS() );
+  const uint8_t* changed = mCompositor.GetChangedBlocks();
+  Pixel*         frame  = mCompositor.GetFrame();
+  bool is_dithering = false;
+
+  // Shards are whole blocks, the last block may be short.
+  for( uint32_t block_first = first; block_first < last; block_first += LEDCOMPOSITOR_BLOCK_LEDS ) {
+    const uint32_t amount     = std::min<uint32_t>( LEDCOMPOSITOR_BLOCK_LEDS, last - block_first );
+    const bool     is_changed = recomposite && changed[ block_first / LEDCOMPOSITOR_BLOCK_LEDS ];
+
+    // After blending, so mixed colours are corrected as they'll be seen.  Only once, the frame is corrected in place.
+    if( is_changed ) {
+      if( m_is_high_depth ) {
+        if( ptr_profile != NULL ) {
+          ptr_profile->GetColourCorrection()->Expand( frame + block_first, m_colour.data() + block_first * 3, amount );
+        } else {
+          std::fill( m_colour.begin() + block_first * 3, m_colour.begin() + ( block_first + amount ) * 3, 0 );
+        }
+      } else if( ptr_profile != NULL ) {
+        ptr_profile->GetColourCorrection()->Apply( frame + block_first, amount );
+      }
+    }
+
+    // LEDs with 16 bit colour take it as it is, nothing to dither.
+    if( m_is_high_depth && !mOutput->HasDepth16() && ( is_changed || is_whole ) ) {
+      is_dithering = mDither.Encode( m_colour.data(), m_dither_frame.data(), block_first, amount ) || is_dithering;
+    }
+  }
+
+  if( send ) {
+    this->SendShard( shard, recomposite, is_whole );
+  }
+
+  return is_dithering;
+};
+
+void LEDArray::SendShard( const int shard, const bool recomposite, const bool is_whole ) {
+  ALLOC_SCOPE( "leds" );
+
+  const uint32_t first   = shard * m_shard_leds;
+  const uint32_t last    = std::min<uint32_t>( first + m_shard_leds, mCompositor.GetAmountLEDS() );
+  const uint8_t* changed = mCompositor.GetChangedBlocks();
+
+  // 16 bit colour only changes when recomposited.
+  if( m_is_high_depth && mOutput->HasDepth16() && !recomposite ) {
+    return;
   }
 
-  number_leds = m_LEDGroup_Strobe.GetNumberOfLEDS();
-  led_numbers = m_LEDGroup_Strobe.GetLEDs();
-  red         = m_LEDGroup_Strobe.GetRed();
-  green       = m_LEDGroup_Strobe.GetGreen();
-  blue        = m_LEDGroup_Strobe.GetBlue();
+  for( uint32_t block_first = first; block_first < last; block_first += LEDCOMPOSITOR_BLOCK_LEDS ) {
+    const uint32_t amount = std::min<uint32_t>( LEDCOMPOSITOR_BLOCK_LEDS, last - block_first );
 
-  for( int i = 0; i < number_leds; i++ ) {
-    mSK9822.SetColour( *led_numbers, red, green, blue, brightness );
-    led_numbers++;
+    // Strip blocks take their colour from wherever the remap says.
+    if( !is_whole ) {
+      const bool is_changed = mRemap.IsActive() ? mRemap.IsChanged( changed, LEDCOMPOSITOR_BLOCK_LEDS, block_first, amount )
+                                                : changed[ block_first / LEDCOMPOSITOR_BLOCK_LEDS ] != 0;
+      if( !is_changed ) {
+        continue;
+      }
+    }
+
+    if( m_is_high_depth && mOutput->HasDepth16() ) {
+      mOutput->SetPixelRange16( this->Remap16( m_colour.data(), block_first, amount ), block_first, amount );
+    } else if( m_is_high_depth ) {
+      mOutput->SetPixelRange( this->Remap( m_dither_frame.data(), block_first, amount ), block_first, amount );
+    } else {
+      mOutput->SetPixelRange( this->Remap( mCompositor.GetFrame(), block_first, amount ), block_first, amount );
+    }
   }
+};
 
-  mSK9822.Update();
+void LEDArray::SetFade( const int frame_rate, const int fade_in_ms, const int fade_out_ms ) {
+  m_frame_rate = frame_rate > 0 ? frame_rate : LEDARRAY_FRAME_RATE_DEFAULT;
+  this->UpdateFrameInterval();
 
+  mCompositor.SetFadeTimes( fade_in_ms, fade_out_ms );
+};
+
+void LEDArray::SetHighDepth( const bool enabled ) {
+  if( m_is_high_depth == enabled ) {
+    return;
+  }
+
+  m_is_high_depth = enabled;
+  m_is_dithering  = false;
+  mDither.Reset();
+  this->UpdateFrameInterval();
+
+  // Redraw in the new mode.
+  mCompositor.Invalidate();
+  m_is_dirty = true;
+};
+
+void LEDArray::UpdateFrameInterval() {
+  int frame_rate = m_frame_rate;
+
+  if( m_is_high_depth && frame_rate < LEDARRAY_DITHER_FRAME_RATE_MIN ) {
+    MSG_LEDARRAY_INFO( "Frame rate raised to " << LEDARRAY_DITHER_FRAME_RATE_MIN << " for high depth dithering." );
+    frame_rate = LEDARRAY_DITHER_FRAME_RATE_MIN;
+  }
+
+  m_frame_interval_us = 1000000 / frame_rate;
+
+  // SPI sets the real limit, frames can't go out quicker than they clock out.
+  const long spi_frame_us = m_is_init ? mOutput->GetFrameTimeUs() : 0;
+  if( m_is_high_depth && spi_frame_us > 1000000 / LEDARRAY_DITHER_FRAME_RATE_MIN ) {
+    MSG_LEDARRAY_INFO( "SPI can only send " << 1000000 / spi_frame_us << " frames a second to these LEDs, dithering may flicker." );
+  }
+};
+
+bool LEDArray::SetRemap( const std::string& remap ) {
+  if( remap == m_remap ) {
+    return true;
+  }
+
+  m_remap = remap;
+
+  const bool is_good = mRemap.Set( remap, this->GetAmountLEDS() );
+  m_remap_frame.assign( mRemap.IsActive() ? this->GetAmountLEDS() : 0, 0 );
+  m_remap_colour.assign( mRemap.IsActive() ? this->GetAmountLEDS() * 3 : 0, 0 );
+
+  // Redraw in the new order.
+  mCompositor.Invalidate();
+  m_is_dirty = true;
+
+  return is_good;
+};
+
+void LEDArray::SetRenderThreads( const int threads ) {
+  const int render_threads = threads > 0 ? threads : std::max( 1u, std::thread::hardware_concurrency() );
+
+  if( render_threads == m_render_threads ) {
+    return;
+  }
+
+  m_render_threads = render_threads;
+
+  // The calling thread draws a shard too.
+  if( !mRenderPool.Start( render_threads - 1, true ) ) {
+    MSG_LEDARRAY_ERROR( "Only " << mRenderPool.GetAmountThreads() + 1 << " of " << render_threads << " render threads started." );
+  }
+
+  this->UpdateShards();
+};
+
+int LEDArray::GetAmountShards() {
+  return m_shard_amount;
+};
+
+void LEDArray::UpdateShards() {
+  const uint32_t led_amount = mCompositor.GetAmountLEDS();
+
+  // A shard for each thread, as long as it's worth one.
+  const uint32_t shards = std::max<uint32_t>( 1, std::min<uint32_t>( mRenderPool.GetAmountThreads() + 1, led_amount / LEDARRAY_SHARD_LEDS_MIN ) );
+  const uint32_t lines  = ( led_amount + LEDARRAY_SHARD_LEDS - 1 ) / LEDARRAY_SHARD_LEDS;
+
+  m_shard_leds   = std::max<uint32_t>( 1, ( lines + shards - 1 ) / shards ) * LEDARRAY_SHARD_LEDS;
+  m_shard_amount = ( led_amount + m_shard_leds - 1 ) / m_shard_leds;
+
+  MSG_LEDARRAY_DEBUG( "Drawing in " << m_shard_amount << " shards of " << m_shard_leds << " LEDs." );
+};
+
+Pixel* LEDArray::Remap( Pixel* ptr_frame, const uint32_t first, const uint32_t amount ) {
+  if( !mRemap.IsActive() ) {
+    return ptr_frame;
+  }
+
+  mRemap.Gather( ptr_frame, m_remap_frame.data(), first, amount );
+
+  return m_remap_frame.data();
+};
+
+uint16_t* LEDArray::Remap16( uint16_t* ptr_colour, const uint32_t first, const uint32_t amount ) {
+  if( !mRemap.IsActive() ) {
+    return ptr_colour;
+  }
+
+  mRemap.Gather16( ptr_colour, m_remap_colour.data(), first, amount );
+
+  return m_remap_colour.data();
+};
+
+bool LEDArray::IsAnimating() {
+  return mCompositor.IsAnimating() || m_is_dithering;
+};
+
+int LEDArray::GetFrameIntervalMs() {
+  return m_frame_interval_us / 1000;
 };
 
 void LEDArray::SetLED( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
-  mSK9822.SetColour( led_number, red, green, blue, brightness );
-  mSK9822.Update();
+  if( m_is_init ) {
+    mOutput->SetColour( led_number, red, green, blue, brightness );
+    mOutput->Submit();
+  }
+
+  // The next frame has to write over it.
+  mCompositor.Invalidate();
 };
 
 void LEDArray::SetAllLED( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
-  mSK9822.SetColourAll( red, green, blue, brightness );
-  mSK9822.Update();
+  // Hold the colour until the lights change, rather than the next dither frame.
+  m_is_dithering = false;
+  mDither.Reset();
+
+  if( m_is_init ) {
+    mOutput->SetColourAll( red, green, blue, brightness );
+    mOutput->Submit();
+  }
+
+  mCompositor.Invalidate();
+};
+
+int LEDArray::GetAmountLEDS() {
+  return m_is_init ? mOutput->GetAmountLEDS() : 0;
+};
+
+LEDOutput* LEDArray::GetOutput() {
+  return mOutput.get();
 };
 
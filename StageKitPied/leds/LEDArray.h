@@ -1,24 +1,40 @@
 #ifndef _LEDARRAY_H_
 #define _LEDARRAY_H_
 
-#ifdef DEBUG
-  #define MSG_LEDARRAY_DEBUG( str ) do { std::cout << "LEDArray : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_LEDARRAY_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_LEDARRAY_DEBUG( str ) LOG_DEBUG( "LEDArray", str )
+
+#define MSG_LEDARRAY_ERROR( str ) LOG_ERROR( "LEDArray", str )
+#define MSG_LEDARRAY_INFO( str ) LOG_INFO( "LEDArray", str )
 
-#define MSG_LEDARRAY_ERROR( str ) do { std::cout << "LEDArray : ERROR : " << str << std::endl; } while( false )
-#define MSG_LEDARRAY_INFO( str ) do { std::cout << "LEDArray : INFO : " << str << std::endl; } while( false )
+#define LEDARRAY_FRAME_RATE_DEFAULT    100  // Frames a second while fading.
+#define LEDARRAY_DITHER_FRAME_RATE_MIN 100  // Slower than this & dithering can be seen to flicker.
+#define LEDARRAY_SHARD_LEDS            64   // Shards are multiples of this, so each starts on a cache line in every frame buffer.
+#define LEDARRAY_SHARD_LEDS_MIN        1024 // Fewer LEDs a thread & handing the work out costs more than it saves.
 
 
+#include <algorithm>  // min, max, fill
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <string>
-#include <sstream>
-
-#include "helpers/INI_Handler.h"
+#include <thread>
+#include <vector>
+
+#include "helpers/AllocTracker.h"
+#include "helpers/CacheAligned.h"
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
+#include "helpers/WorkerPool.h"
+#include "leds/ColourCorrection.h"
+#include "leds/LEDCompositor.h"
+#include "leds/LEDDither.h"
 #include "leds/LEDGroup.h"
-#include "leds/SK9822.h"
+#include "leds/LEDLayout.h"
+#include "leds/LEDProfile.h"
+#include "leds/LEDOutput.h"
+#include "leds/LEDRemap.h"
 #include "stagekit/StageKitConsts.h"
 
 class LEDArray {
@@ -31,34 +47,138 @@ public:
   
   void TurnOff();
 
-  bool Init( const std::string& device_name, const int led_amount );
+  // type picks the LEDOutput, see LEDOutput::Create.
+  bool Init( const std::string& type, const std::string& device_name, const int led_amount );
+
+  // Loads every leds ini up front, profile ids follow the order given.  A profile that fails
+  // to load leaves a gap that can't be selected.  True if at least one loaded.
+  bool LoadProfiles( const std::vector<std::string>& ini_files );
+
+  // Makes a loaded profile the one rendered from.  Only swaps a pointer, no file access.
+  bool SelectProfile( const int profile_id );
+
+  // -1 when no profile is selected.
+  int GetProfile();
+
+  int GetAmountProfiles();
 
-  bool LoadSettingsSK( const std::string& ini_file );
+  bool IsProfileLoaded( const int profile_id );
 
+  // Puts a reloaded profile in place of the one with the same id, swapping it in if it's being rendered from.
+  // Gives back the old profile, or the new one if its id isn't known.  Call from the thread that renders.
+  std::unique_ptr<LEDProfile> ReplaceProfile( std::unique_ptr<LEDProfile> profile );
+
+  // Sets a colour's stage kit LEDs.  Nothing is drawn until Flush, so any amount of changes cost one frame.
   void SetLights( const uint8_t colour, const uint8_t leds );
 
+  // Sets all four colours & draws them, such as after a profile change.
+  void Render( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t yellow );
+
+  // Draws straight away.
   void Strobe( const bool on );
 
+  // Draws the frame if anything changed since the last one, or the next fade frame is due.  Returns true if it did.
+  bool Flush();
+
+  // Strobe & Flush as at time_now rather than now, for replaying cues on a clock of their own, see skp_framecheck.
+  void Strobe( const bool on, const std::chrono::steady_clock::time_point time_now );
+
+  bool Flush( const std::chrono::steady_clock::time_point time_now );
+
+  // Colour groups fade on & off over these times, drawn at frame_rate frames a second while fading.
+  void SetFade( const int frame_rate, const int fade_in_ms, const int fade_out_ms );
+
+  // Renders in 16 bit colour.  HD108s take it as it is, otherwise it's split into PWM & the LED brightness each
+  // frame, with what's left over dithered across frames.  Smooth in the dark, but dithering keeps drawing at the
+  // frame rate while anything is lit.
+  void SetHighDepth( const bool enabled );
+
+  // True while colour groups are part way through a fade, a sweep is running or dithering, Flush needs calling every GetFrameIntervalMs.
+  bool IsAnimating();
+
+  int GetFrameIntervalMs();
+
+  // Strip wiring, see LEDRemap.  The frame is gathered into this order as it's sent, so profiles number LEDs
+  // in the order they're seen.  Only rebuilt if it changed, an empty remap sends LEDs as numbered.
+  bool SetRemap( const std::string& remap );
+
+  // Threads drawing each frame, every one given a shard of the LEDs to colour correct, dither & encode.
+  // 1 draws on the calling thread alone, 0 uses every core.  Extra threads are pinned to a core each.
+  // Small arrays use fewer, see LEDARRAY_SHARD_LEDS_MIN.
+  void SetRenderThreads( const int threads );
+
+  // Shards each frame is split into, 1 when drawn on the calling thread alone.
+  int GetAmountShards();
+
   void SetLED( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness );
 
   void SetAllLED( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness );
 
+  int GetAmountLEDS();
+
+  // NULL until Init.
+  LEDOutput* GetOutput();
+
 private:
-  void LoadLEDData( INI_Handler* ptrINI_Handler, const std::string& section_name, LEDGroup* ptrLEDGroup, const uint8_t red, const uint8_t green, const uint8_t blue );
+  // recomposite is false for a dither only frame, the colours haven't changed.
+  void Draw( const std::chrono::steady_clock::time_point time_now, const bool recomposite );
 
-  void SetLEDS( const uint8_t leds, LEDGroup theLEDGroups[] );
+  void UpdateFrameInterval();
 
-  SK9822 mSK9822;
+  void UpdateShards();
 
-  bool m_is_init;
+  // Colour corrects & dithers the changed blocks of one shard, or dithers all of it if is_whole, then sends it if send.
+  // Returns true if it's still dithering.
+  bool DrawShard( const int shard, LEDProfile* ptr_profile, const bool recomposite, const bool is_whole, const bool send );
+
+  // Sets the changed blocks of one shard of the output, or all of it if is_whole, in strip order.
+  void SendShard( const int shard, const bool recomposite, const bool is_whole );
+
+  // Strip LEDs first + 1 to first + amount, ptr_frame itself when there's no remap.
+  Pixel* Remap( Pixel* ptr_frame, const uint32_t first, const uint32_t amount );
 
-  LEDGroup m_LEDGroups_Red[ 8 ];
-  LEDGroup m_LEDGroups_Green[ 8 ];
-  LEDGroup m_LEDGroups_Blue[ 8 ];
-  LEDGroup m_LEDGroups_Yellow[ 8 ];
-  LEDGroup m_LEDGroup_Strobe;
+  uint16_t* Remap16( uint16_t* ptr_colour, const uint32_t first, const uint32_t amount );
+
+  std::unique_ptr<LEDOutput> mOutput;
+
+  bool m_is_init;
 
-  uint8_t m_SK_LED_Number[ 8 ];
+  // Indexed by profile id, NULL where a profile failed to load.
+  std::vector< std::unique_ptr<LEDProfile> > m_profiles;
+
+  // Profile being rendered from.  Can be swapped from another thread.
+  std::atomic<LEDProfile*> m_ptr_profile;
+
+  LEDCompositor mCompositor;
+
+  // Stage kit LED bits for each LEDLAYOUT_ colour.
+  uint8_t m_layers[ LEDLAYOUT_COLOURS ];
+  bool    m_strobe_on;
+  bool    m_is_dirty;
+
+  int     m_frame_rate;
+  long    m_frame_interval_us;
+  std::chrono::steady_clock::time_point m_frame_time;  // Last frame drawn.
+  MetricHistogram* m_ptr_draw_time;
+
+  // High depth
+  bool    m_is_high_depth;
+  bool    m_is_dithering;
+  LEDDither mDither;
+  CacheAlignedVector<uint16_t> m_colour;        // Red, green & blue per LED.
+  CacheAlignedVector<Pixel>    m_dither_frame;
+
+  // Wiring
+  LEDRemap                     mRemap;
+  std::string                  m_remap;
+  CacheAlignedVector<Pixel>    m_remap_frame;
+  CacheAlignedVector<uint16_t> m_remap_colour;
+
+  // Shards
+  WorkerPool mRenderPool;
+  int        m_render_threads;
+  int        m_shard_amount;
+  uint32_t   m_shard_leds;    // LEDs in each shard, the last may have fewer.
 
 };
 
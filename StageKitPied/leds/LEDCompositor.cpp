@@ -0,0 +1,302 @@
+#include "LEDCompositor.h"
+
+LEDCompositor::LEDCompositor() {
+  m_fade_in_us  = 0;
+  m_fade_out_us = 0;
+  m_is_fading   = false;
+  m_changed_groups = 0;
+  m_is_redraw_all  = true;
+  m_ptr_profile    = NULL;
+  m_strobe_on      = false;
+  m_is_sweeping    = false;
+  m_sweep_us       = 0;
+  m_sweep_axis     = LEDLAYOUT_AXIS_X;
+  m_sweep_low      = 0;
+  m_sweep_high     = 0;
+  m_sweep_pixel    = 0;
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    m_targets[ colour ] = 0;
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      m_levels[ colour ][ group ] = 0;
+    }
+  }
+};
+
+LEDCompositor::~LEDCompositor() {
+};
+
+void LEDCompositor::Init( const int led_amount ) {
+  m_frame.assign( led_amount > 0 ? led_amount : 0, 0 );
+  m_changed.assign( ( m_frame.size() + LEDCOMPOSITOR_BLOCK_LEDS - 1 ) / LEDCOMPOSITOR_BLOCK_LEDS, 0 );
+  m_sweep_bits.assign( ( m_frame.size() + 1 + 63 ) / 64, 0 );
+  m_is_sweeping   = false;
+  m_is_redraw_all = true;
+};
+
+void LEDCompositor::SetFadeTimes( const int fade_in_ms, const int fade_out_ms ) {
+  m_fade_in_us  = fade_in_ms > 0 ? fade_in_ms * 1000L : 0;
+  m_fade_out_us = fade_out_ms > 0 ? fade_out_ms * 1000L : 0;
+};
+
+bool LEDCompositor::Fade( const uint8_t layers[ LEDLAYOUT_COLOURS ], const long elapsed_us ) {
+  bool is_changed = false;
+
+  // The sweep starts from the edge each time the lights come on.
+  m_sweep_us = m_is_sweeping ? m_sweep_us + elapsed_us : 0;
+
+  // Nothing to do unless a target moved or a group is part way.
+  if( !m_is_fading ) {
+    for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+      is_changed = is_changed || layers[ colour ] != m_targets[ colour ];
+    }
+    if( !is_changed ) {
+      return false;
+    }
+    is_changed = false;
+  }
+
+  m_is_fading = false;
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    m_targets[ colour ] = layers[ colour ];
+
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      const uint16_t target = ( ( layers[ colour ] >> group ) & 1 ) ? LEDCOMPOSITOR_LEVEL_MAX : 0;
+      uint16_t& level = m_levels[ colour ][ group ];
+
+      if( level == target ) {
+        continue;
+      }
+
+      level = Step( level, target, elapsed_us, level < target ? m_fade_in_us : m_fade_out_us );
+      is_changed = true;
+      m_changed_groups |= (uint32_t)1 << LEDOwnerIndex::GroupIndex( colour, group );
+      m_is_fading = m_is_fading || level != target;
+    }
+  }
+
+  return is_changed;
+};
+
+uint16_t LEDCompositor::Step( const uint16_t level, const uint16_t target, const long elapsed_us, const long fade_us ) {
+  if( fade_us == 0 ) {
+    return target;
+  }
+
+  // At least 1, so a fade always gets somewhere.
+  long step = elapsed_us * LEDCOMPOSITOR_LEVEL_MAX / fade_us;
+  if( step < 1 ) {
+    step = 1;
+  }
+
+  if( level < target ) {
+    return level + step >= target ? target : level + step;
+  }
+  return level <= target + step ? target : level - step;
+};
+
+bool LEDCompositor::IsFading() {
+  return m_is_fading;
+};
+
+bool LEDCompositor::IsAnimating() {
+  return m_is_fading || m_is_sweeping;
+};
+
+void LEDCompositor::Composite( LEDProfile* ptr_profile, const bool strobe_on ) {
+  std::fill( m_changed.begin(), m_changed.end(), 0 );
+
+  const bool is_redraw_all = m_is_redraw_all || ptr_profile != m_ptr_profile;
+
+  m_is_redraw_all = false;
+  m_ptr_profile   = ptr_profile;
+
+  if( ptr_profile == NULL ) {
+    if( is_redraw_all ) {
+      std::fill( m_frame.begin(), m_frame.end(), 0 );
+      std::fill( m_changed.begin(), m_changed.end(), 1 );
+      std::fill( m_sweep_bits.begin(), m_sweep_bits.end(), 0 );
+    }
+    m_is_sweeping    = false;
+    m_changed_groups = 0;
+    m_strobe_on      = strobe_on;
+    return;
+  }
+
+  LEDOwnerIndex* ptr_owner_index = ptr_profile->GetOwnerIndex();
+  const int      words           = ptr_owner_index->GetWords();
+
+  if( is_redraw_all ) {
+    std::fill( m_changed.begin(), m_changed.end(), 1 );
+  } else {
+    for( uint32_t groups = m_changed_groups; groups != 0; groups &= groups - 1 ) {
+      this->MarkChanged( ptr_owner_index->GetBits( __builtin_ctz( groups ) ), words );
+    }
+    if( strobe_on != m_strobe_on ) {
+      this->MarkChanged( ptr_owner_index->GetBits( LEDOWNERINDEX_STROBE ), words );
+    }
+  }
+
+  m_changed_groups = 0;
+  m_strobe_on      = strobe_on;
+
+  this->UpdateSweep( ptr_profile, is_redraw_all );
+
+  // Each group's colour once, rather than per LED.
+  uint32_t lit_groups = 0;
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    // Group n is stage kit LED n + 1, SK_LED_1 to SK_LED_8.
+    LEDGroup* ptr_groups = ptr_profile->GetGroups( colour );
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      const uint32_t level = m_levels[ colour ][ group ];
+      if( level == 0 ) {
+        continue;
+      }
+
+      LEDGroup* ptr_group = &ptr_groups[ group ];
+      const int group_index = LEDOwnerIndex::GroupIndex( colour, group );
+      m_pixels[ group_index ] = PixelPack( ptr_group->GetRed(), ptr_group->GetGreen(), ptr_group->GetBlue(), ptr_group->GetBrightness() );
+      if( level < LEDCOMPOSITOR_LEVEL_MAX ) {
+        m_pixels[ group_index ] = PixelScale( m_pixels[ group_index ], level );
+      }
+      lit_groups |= (uint32_t)1 << group_index;
+    }
+  }
+
+  LEDGroup* ptr_strobe = ptr_profile->GetStrobe();
+  m_pixels[ LEDOWNERINDEX_STROBE ] = PixelPack( ptr_strobe->GetRed(), ptr_strobe->GetGreen(), ptr_strobe->GetBlue(), ptr_strobe->GetBrightness() );
+
+  const uint32_t led_amount = m_frame.size();
+  for( uint32_t block = 0; block < m_changed.size(); block++ ) {
+    if( m_changed[ block ] ) {
+      const uint32_t first = block * LEDCOMPOSITOR_BLOCK_LEDS;
+      this->DrawBlock( ptr_profile, lit_groups, strobe_on, first, std::min<uint32_t>( LEDCOMPOSITOR_BLOCK_LEDS, led_amount - first ) );
+    }
+  }
+};
+
+void LEDCompositor::Invalidate() {
+  m_is_redraw_all = true;
+};
+
+Pixel* LEDCompositor::GetFrame() {
+  return m_frame.data();
+};
+
+int LEDCompositor::GetAmountLEDS() {
+  return m_frame.size();
+};
+
+const uint8_t* LEDCompositor::GetChangedBlocks() {
+  return m_changed.data();
+};
+
+void LEDCompositor::MarkChanged( const uint64_t* ptr_bits, const int words ) {
+  // Bits are by LED number, so word n holds LEDs 64n to 64n + 63, one off from the blocks.
+  const uint32_t blocks = m_changed.size();
+
+  for( int word_number = 0; word_number < words; word_number++ ) {
+    const uint64_t word = ptr_bits[ word_number ];
+    if( word == 0 ) {
+      continue;
+    }
+
+    // LED 64n is the last of block n - 1.
+    if( ( word & 1 ) && word_number > 0 ) {
+      m_changed[ word_number - 1 ] = 1;
+    }
+    if( ( word >> 1 ) != 0 && (uint32_t)word_number < blocks ) {
+      m_changed[ word_number ] = 1;
+    }
+  }
+};
+
+void LEDCompositor::UpdateSweep( LEDProfile* ptr_profile, const bool is_redraw_all ) {
+  LEDSpatialIndex*      ptr_spatial_index = ptr_profile->GetSpatialIndex();
+  const LEDLayoutSweep& sweep             = ptr_profile->GetSweep();
+  const int32_t*        leds              = NULL;
+
+  // Last frame's band goes.  A new profile's index may not have the same LEDs, so all of it then.
+  if( is_redraw_all ) {
+    std::fill( m_sweep_bits.begin(), m_sweep_bits.end(), 0 );
+  } else if( m_is_sweeping ) {
+    const uint32_t amount = ptr_spatial_index->Band( m_sweep_axis, m_sweep_low, m_sweep_high, &leds );
+    this->MarkSweep( leds, amount, false );
+  }
+
+  bool is_lit = false;
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    is_lit = is_lit || m_targets[ colour ] != 0;
+  }
+
+  m_is_sweeping = is_lit && sweep.m_time_ms > 0 && !ptr_spatial_index->IsEmpty();
+  if( !m_is_sweeping ) {
+    return;
+  }
+
+  // From just off the low end to just off the high end, then round again.
+  const float     low     = ptr_spatial_index->GetLow( sweep.m_axis );
+  const float     high    = ptr_spatial_index->GetHigh( sweep.m_axis );
+  const long long time_us = sweep.m_time_ms * 1000LL;
+
+  m_sweep_axis  = sweep.m_axis;
+  m_sweep_low   = low - sweep.m_width + ( high - low + sweep.m_width ) * (float)( m_sweep_us % time_us ) / time_us;
+  m_sweep_high  = m_sweep_low + sweep.m_width;
+  m_sweep_pixel = PixelPack( sweep.m_red, sweep.m_green, sweep.m_blue, sweep.m_brightness );
+
+  const uint32_t amount = ptr_spatial_index->Band( m_sweep_axis, m_sweep_low, m_sweep_high, &leds );
+  this->MarkSweep( leds, amount, true );
+};
+
+void LEDCompositor::MarkSweep( const int32_t* leds, const uint32_t amount, const bool is_in_band ) {
+  for( uint32_t i = 0; i < amount; i++ ) {
+    const uint32_t led_number = leds[ i ];
+    const uint64_t bit        = (uint64_t)1 << ( led_number & 63 );
+
+    if( is_in_band ) {
+      m_sweep_bits[ led_number >> 6 ] |= bit;
+    } else {
+      m_sweep_bits[ led_number >> 6 ] &= ~bit;
+    }
+    m_changed[ ( led_number - 1 ) / LEDCOMPOSITOR_BLOCK_LEDS ] = 1;
+  }
+};
+
+void LEDCompositor::DrawBlock( LEDProfile* ptr_profile, const uint32_t lit_groups, const bool strobe_on, const uint32_t first, const uint32_t amount ) {
+  LEDOwnerIndex* ptr_owner_index = ptr_profile->GetOwnerIndex();
+  const uint64_t* strobe_bits    = ptr_owner_index->GetBits( LEDOWNERINDEX_STROBE );
+  const int       blend_mode     = ptr_profile->GetBlendMode();
+  Pixel*          frame          = m_frame.data();
+
+  for( uint32_t led_index = first; led_index < first + amount; led_index++ ) {
+    const uint32_t led_number = led_index + 1;
+    Pixel pixel = 0;
+
+    // Lowest group index first, the same red, green, blue, yellow order whichever groups changed.
+    for( uint32_t groups = ptr_owner_index->GetOwners( led_number ) & lit_groups; groups != 0; groups &= groups - 1 ) {
+      pixel = Blend( blend_mode, pixel, m_pixels[ __builtin_ctz( groups ) ] );
+    }
+
+    if( ( m_sweep_bits[ led_number >> 6 ] >> ( led_number & 63 ) ) & 1 ) {
+      pixel = Blend( blend_mode, pixel, m_sweep_pixel );
+    }
+
+    if( strobe_on && ( ( strobe_bits[ led_number >> 6 ] >> ( led_number & 63 ) ) & 1 ) ) {
+      pixel = Blend( blend_mode, pixel, m_pixels[ LEDOWNERINDEX_STROBE ] );
+    }
+
+    frame[ led_index ] = pixel;
+  }
+};
+
+Pixel LEDCompositor::Blend( const int blend_mode, const Pixel below, const Pixel pixel ) {
+  switch( blend_mode ) {
+    case LEDLAYOUT_BLEND_ADD:
+      return PixelAddSaturate( below, pixel );
+    case LEDLAYOUT_BLEND_MAX:
+      return PixelMax( below, pixel );
+    default:
+      return pixel;
+  }
+};
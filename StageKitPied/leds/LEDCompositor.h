@@ -0,0 +1,101 @@
+#ifndef _LEDCOMPOSITOR_H_
+#define _LEDCOMPOSITOR_H_
+
+#include <algorithm>  // fill, min
+#include <cstdint>
+#include <vector>
+
+#include "helpers/CacheAligned.h"
+#include "leds/LEDGroup.h"
+#include "leds/LEDLayout.h"
+#include "leds/LEDProfile.h"
+#include "leds/PixelKernels.h"
+
+#define LEDCOMPOSITOR_LEVEL_MAX  256  // Group fully on.
+#define LEDCOMPOSITOR_BLOCK_LEDS 64   // LEDs are redrawn in blocks of this many, LED 1 starting the first.
+
+// Builds the output frame from the lit groups of each colour, plus the strobe.
+// Layers are drawn in a fixed order with the profile's blend mode, so overlapping groups always mix the same way.
+// Each colour group has a level that fades toward on or off, the strobe is always instant.
+// Only the blocks holding LEDs of groups that changed are redrawn, found from the profile's LEDOwnerIndex,
+// so a fade costs the LEDs it touches rather than the whole array.
+// A profile's [SWEEP] band is drawn over the groups & under the strobe.  Its LEDs come from the spatial index each
+// frame, so it costs the LEDs in the band as it leaves & as it arrives.
+class LEDCompositor {
+public:
+  LEDCompositor();
+
+  ~LEDCompositor();
+
+  void Init( const int led_amount );
+
+  // Time for a group to go from off to fully on & back.  0 switches straight away.
+  void SetFadeTimes( const int fade_in_ms, const int fade_out_ms );
+
+  // Moves each group's level toward the layers, stage kit LED bits for each LEDLAYOUT_ colour.
+  // Returns true if any level changed.
+  bool Fade( const uint8_t layers[ LEDLAYOUT_COLOURS ], const long elapsed_us );
+
+  // True while any group hasn't reached its target.
+  bool IsFading();
+
+  // True while fading or sweeping, so frames need drawing at the frame rate.
+  bool IsAnimating();
+
+  // Redraws the blocks changed since the last Composite, or all of them for a new profile or after Invalidate.
+  void Composite( LEDProfile* ptr_profile, const bool strobe_on );
+
+  // Redraws every block next Composite, such as when something else has written the LEDs.
+  void Invalidate();
+
+  // Pixel per LED, LED 1 first.  Not colour corrected, that's done in place after, to the changed blocks only.
+  Pixel* GetFrame();
+
+  // Non zero for each block the last Composite redrew, LEDs block * LEDCOMPOSITOR_BLOCK_LEDS + 1 onwards.
+  const uint8_t* GetChangedBlocks();
+
+  int GetAmountLEDS();
+
+private:
+  // Marks the blocks holding any LED in the owner index bitset.
+  void MarkChanged( const uint64_t* ptr_bits, const int words );
+
+  // Moves the sweep band on, marking the blocks it leaves & arrives in.
+  void UpdateSweep( LEDProfile* ptr_profile, const bool is_redraw_all );
+
+  // Sets or clears the LEDs' sweep bits.
+  void MarkSweep( const int32_t* leds, const uint32_t amount, const bool is_in_band );
+
+  // Redraws LEDs from first + 1 on, from the groups lit in lit_groups.
+  void DrawBlock( LEDProfile* ptr_profile, const uint32_t lit_groups, const bool strobe_on, const uint32_t first, const uint32_t amount );
+
+  static Pixel Blend( const int blend_mode, const Pixel below, const Pixel pixel );
+
+  static uint16_t Step( const uint16_t level, const uint16_t target, const long elapsed_us, const long fade_us );
+
+  CacheAlignedVector<Pixel> m_frame;  // Index 0 is LED 1.
+
+  long     m_fade_in_us;
+  long     m_fade_out_us;
+  uint8_t  m_targets[ LEDLAYOUT_COLOURS ];
+  uint16_t m_levels[ LEDLAYOUT_COLOURS ][ LEDLAYOUT_GROUPS ];
+  bool     m_is_fading;
+
+  CacheAlignedVector<uint8_t> m_changed;        // Per block.
+  uint32_t    m_changed_groups;  // Colour groups whose level moved since the last Composite.
+  bool        m_is_redraw_all;
+  LEDProfile* m_ptr_profile;     // Drawn last time, only compared.
+  bool        m_strobe_on;
+  Pixel       m_pixels[ LEDOWNERINDEX_GROUPS ];  // Each group's colour at its level, for this Composite.
+
+  // Sweep
+  bool        m_is_sweeping;
+  long long   m_sweep_us;      // Since the lights came on.
+  int         m_sweep_axis;
+  float       m_sweep_low;     // Band drawn last.
+  float       m_sweep_high;
+  Pixel       m_sweep_pixel;
+  std::vector<uint64_t> m_sweep_bits;  // Bit n = LED n is in the band.
+};
+
+#endif
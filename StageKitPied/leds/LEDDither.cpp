@@ -0,0 +1,82 @@
+#include "LEDDither.h"
+
+LEDDither::LEDDither() {
+  m_led_amount = 0;
+  m_use_brightness = true;
+
+  // PWM = colour * 255 * 31 / ( brightness * 65535 ), kept as 8.8 fixed point after a >> 16.
+  m_pwm_scale[ 0 ] = 0;
+  for( uint32_t brightness = 1; brightness <= LEDDITHER_BRIGHTNESS; brightness++ ) {
+    const uint64_t divisor = (uint64_t)LEDDITHER_FULL * brightness;
+    m_pwm_scale[ brightness ] = ( 255ull * LEDDITHER_BRIGHTNESS * 256 * 65536 + divisor - 1 ) / divisor;
+  }
+};
+
+LEDDither::~LEDDither() {
+};
+
+void LEDDither::Init( const int led_amount ) {
+  m_led_amount = led_amount > 0 ? led_amount : 0;
+  m_residual.assign( m_led_amount * 3, 0 );
+};
+
+void LEDDither::SetUseBrightness( const bool use_brightness ) {
+  m_use_brightness = use_brightness;
+};
+
+void LEDDither::Reset() {
+  std::fill( m_residual.begin(), m_residual.end(), 0 );
+};
+
+bool LEDDither::Encode( const uint16_t* ptr_colour, Pixel* ptr_frame ) {
+  return this->Encode( ptr_colour, ptr_frame, 0, m_led_amount );
+};
+
+bool LEDDither::Encode( const uint16_t* ptr_colour, Pixel* ptr_frame, const uint32_t first, const uint32_t amount ) {
+  uint8_t* residual = m_residual.data() + first * 3;
+  uint32_t carried  = 0;
+  const uint32_t last = first + amount;
+
+  ptr_colour += first * 3;
+
+  for( uint32_t i = first; i < last; i++ ) {
+    const uint32_t red   = ptr_colour[ 0 ];
+    const uint32_t green = ptr_colour[ 1 ];
+    const uint32_t blue  = ptr_colour[ 2 ];
+    ptr_colour += 3;
+
+    uint32_t brightest = red > green ? red : green;
+    brightest = brightest > blue ? brightest : blue;
+
+    if( brightest == 0 ) {
+      ptr_frame[ i ] = 0;
+      residual[ 0 ] = residual[ 1 ] = residual[ 2 ] = 0;
+      residual += 3;
+      continue;
+    }
+
+    // Lowest brightness that still fits the brightest channel in PWM 255.  A shift, the Pi Zero has no divide.
+    const uint32_t brightness = m_use_brightness ? ( brightest * LEDDITHER_BRIGHTNESS + 0xFFFF ) >> 16 : LEDDITHER_BRIGHTNESS;
+    const uint64_t scale = m_pwm_scale[ brightness ];
+
+    uint8_t pwm[ 3 ];
+    const uint32_t colour[ 3 ] = { red, green, blue };
+    for( int channel = 0; channel < 3; channel++ ) {
+      // Any fraction needs frames to show, even on the frame its carry comes back round to 0.
+      const uint32_t exact = ( colour[ channel ] * scale ) >> 16;
+      carried |= exact;
+
+      uint32_t value = exact + residual[ channel ];
+      if( value > 0xFFFF ) {
+        value = 0xFFFF;
+      }
+      pwm[ channel ]      = value >> 8;
+      residual[ channel ] = value & 0xFF;
+    }
+    residual += 3;
+
+    ptr_frame[ i ] = PixelPack( pwm[ 0 ], pwm[ 1 ], pwm[ 2 ], brightness );
+  }
+
+  return ( carried & 0xFF ) != 0;
+};
@@ -0,0 +1,46 @@
+#ifndef _LEDDITHER_H_
+#define _LEDDITHER_H_
+
+#include <algorithm>  // fill
+#include <cstdint>
+#include <vector>
+
+#include "helpers/CacheAligned.h"
+#include "leds/PixelKernels.h"
+
+#define LEDDITHER_FULL       65535  // 16 bit colour for PWM 255 at brightness 31.
+#define LEDDITHER_BRIGHTNESS 31
+
+// Turns 16 bit colour into the SK9822's 8 bit PWM & 5 bit brightness.
+// Each LED gets the lowest brightness its brightest channel fits in, so PWM has the most steps left for it.
+// What PWM can't show is carried to the next frame, so over a few frames the LED averages the exact colour.
+class LEDDither {
+public:
+  LEDDither();
+
+  ~LEDDither();
+
+  void Init( const int led_amount );
+
+  // Forgets any carried error.
+  void Reset();
+
+  // LEDs without a brightness of their own stay at 31, only the PWM steps are dithered.
+  void SetUseBrightness( const bool use_brightness );
+
+  // ptr_colour is red, green & blue per LED.  Returns true if any LED sits between PWM steps, so keeps needing frames.
+  bool Encode( const uint16_t* ptr_colour, Pixel* ptr_frame );
+
+  // As Encode for LEDs first + 1 to first + amount only, so separate ranges can be encoded on separate threads.
+  bool Encode( const uint16_t* ptr_colour, Pixel* ptr_frame, const uint32_t first, const uint32_t amount );
+
+private:
+  uint32_t m_led_amount;
+  bool     m_use_brightness;
+
+  CacheAlignedVector<uint8_t> m_residual;  // Carried PWM fraction, 1/256ths, 3 per LED.
+
+  uint32_t m_pwm_scale[ LEDDITHER_BRIGHTNESS + 1 ];  // 16 bit colour to 8.8 PWM at each brightness.
+};
+
+#endif
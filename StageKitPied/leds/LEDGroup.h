@@ -1,28 +1,24 @@
 #ifndef _LEDGROUP_H_
 #define _LEDGROUP_H_
 
-#ifdef DEBUG
-  #define MSG_LEDGROUP_DEBUG( str ) do { std::cout << "LEDGroup : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_LEDGROUP_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_LEDGROUP_DEBUG( str ) LOG_DEBUG( "LEDGroup", str )
 
-#define MSG_LEDGROUP_ERROR( str ) do { std::cout << "LEDGroup : ERROR : " << str << std::endl; } while( false )
-#define MSG_LEDGROUP_INFO( str ) do { std::cout << "LEDGroup : INFO : " << str << std::endl; } while( false )
+#define MSG_LEDGROUP_ERROR( str ) LOG_ERROR( "LEDGroup", str )
+#define MSG_LEDGROUP_INFO( str ) LOG_INFO( "LEDGroup", str )
 
 #include <cstdint>
 #include <iostream>
 
+#include "helpers/Log.h"
+
 class LEDGroup {
 public:
   LEDGroup();
 
   ~LEDGroup();
 
-  // Resets number of loaded LEDs to zero.
-  void SetNumberOfLEDS( const int number_of_leds );
-
-  void LoadLED( const int led_number );
+  // Views a run of the layout's LED list, which all groups share.  The group doesn't own or free it.
+  void SetLEDs( int* leds, const int number_of_leds );
 
   void SetRGB( const uint8_t red, const uint8_t green, const uint8_t blue );
 
@@ -33,9 +29,6 @@ public:
   // Gets the LED at the group position number
   int GetLED( const int led_position_number );
 
-  // Checks to see if the led_numbers is in this group
-  bool HasLED( const int led_number );
-
   int* GetLEDs();
 
   uint8_t GetRed();
@@ -49,9 +42,6 @@ public:
   void Dump();
 
 private:
-  void Free();
-
-  int     m_number_of_leds_max;
   int     m_number_of_leds_loaded;
   int*    m_leds;
   uint8_t m_red;
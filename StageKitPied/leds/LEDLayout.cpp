@@ -0,0 +1,669 @@
+#include "LEDLayout.h"
+#include "LEDOwnerIndex.h"
+#include "LEDSpatialIndex.h"
+
+LEDLayout::LEDLayout() {
+  m_header   = NULL;
+  m_leds     = NULL;
+  m_ptr_positions = NULL;
+  m_size     = 0;
+  m_ptr_map  = NULL;
+  m_map_size = 0;
+};
+
+LEDLayout::~LEDLayout() {
+  this->Close();
+};
+
+bool LEDLayout::IsLoaded() {
+  return m_header != NULL;
+};
+
+const LEDLayoutSpan& LEDLayout::GetGroup( const int colour, const int group ) {
+  return m_header->m_groups[ colour ][ group ];
+};
+
+const LEDLayoutSpan& LEDLayout::GetStrobe() {
+  return m_header->m_strobe;
+};
+
+const LEDLayoutSweep& LEDLayout::GetSweep() {
+  return m_header->m_sweep;
+};
+
+int LEDLayout::GetBlendMode() {
+  return m_header->m_blend_mode;
+};
+
+int LEDLayout::GetGamma() {
+  return m_header->m_gamma;
+};
+
+const int16_t ( *LEDLayout::GetColourMatrix() )[ 3 ] {
+  return m_header->m_colour_matrix;
+};
+
+int32_t* LEDLayout::GetLEDs() {
+  return m_leds;
+};
+
+const LEDLayoutPosition* LEDLayout::GetPositions() {
+  return m_ptr_positions;
+};
+
+uint32_t LEDLayout::GetSize() {
+  return m_size;
+};
+
+void LEDLayout::Close() {
+  if( m_ptr_map != NULL ) {
+    munmap( m_ptr_map, m_map_size );
+    m_ptr_map  = NULL;
+    m_map_size = 0;
+  }
+
+  m_compiled.clear();
+  m_led_list.clear();
+  m_positions.clear();
+
+  m_header = NULL;
+  m_leds   = NULL;
+  m_ptr_positions = NULL;
+  m_size   = 0;
+};
+
+bool LEDLayout::Compile( const std::string& ini_file, const int led_amount ) {
+  this->Close();
+
+  INI_Handler ini_handler;
+
+  if( !ini_handler.Load( ini_file ) ) {
+    MSG_LEDLAYOUT_ERROR( "SK INI file not loaded." << ini_file );
+    MSG_LEDLAYOUT_ERROR( "  - " << ini_handler.GetErrorMessage() );
+    return false;
+  }
+
+  LEDLayoutHeader header;
+  memset( &header, 0, sizeof( header ) );
+
+  if( !ReadIniStat( ini_file, &header.m_ini_size, &header.m_ini_mtime ) ) {
+    return false;
+  }
+
+  if( !ini_handler.SetSection( "SK_COLOURS" ) ) {
+    MSG_LEDLAYOUT_ERROR( "No SK_COLOURS section in " << ini_file );
+    return false;
+  }
+
+  // **** COLOURS ****
+  static const char* colour_tokens[ LEDLAYOUT_COLOURS + 1 ] = { "RGB_RED", "RGB_GREEN", "RGB_BLUE", "RGB_YELLOW", "RGB_STROBE" };
+  int colours[ LEDLAYOUT_COLOURS + 1 ][ 3 ];
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS + 1; colour++ ) {
+    colours[ colour ][ 0 ] = 0;
+    colours[ colour ][ 1 ] = 0;
+    colours[ colour ][ 2 ] = 0;
+    ParseNumbers( ini_handler.GetTokenView( colour_tokens[ colour ] ), colours[ colour ], 3 );
+    MSG_LEDLAYOUT_DEBUG( colour_tokens[ colour ] << " = " << colours[ colour ][ 0 ] << "," << colours[ colour ][ 1 ] << "," << colours[ colour ][ 2 ] );
+  }
+
+  header.m_blend_mode = ParseBlendMode( ini_handler.GetTokenView( "BLEND_MODE" ) );
+  header.m_gamma      = ParseGamma( ini_handler.GetTokenView( "GAMMA" ) );
+  ParseColourMatrix( ini_handler.GetTokenView( "WHITE_BALANCE" ), ini_handler.GetTokenView( "COLOUR_MATRIX" ), header.m_colour_matrix );
+
+  // **** POSITIONS ****
+  // Optional, colour groups can then take LEDs by area as well as number.
+  LEDSpatialIndex spatial_index;
+  if( this->ReadPositions( &ini_handler, led_amount ) ) {
+    spatial_index.Build( m_positions.data(), led_amount );
+    MSG_LEDLAYOUT_DEBUG( "Positions for " << spatial_index.GetAmountLEDS() << " LEDs." );
+  }
+
+  // Load all 8 sections for each colour
+  static const char* colour_names[ LEDLAYOUT_COLOURS ] = { "RED", "GREEN", "BLUE", "YELLOW" };
+  std::string section_name;
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      section_name = colour_names[ colour ];
+      section_name += "_GROUP_";
+      section_name += std::to_string( group + 1 );
+
+      if( !ini_handler.SetSection( section_name ) ) {
+        // The supplied layouts name them RED_1 etc.
+        section_name = colour_names[ colour ];
+        section_name += "_";
+        section_name += std::to_string( group + 1 );
+        if( !ini_handler.SetSection( section_name ) ) {
+          continue;
+        }
+      }
+
+      MSG_LEDLAYOUT_DEBUG( "Loading group = " << section_name );
+      this->ReadSpan( &ini_handler, &header.m_groups[ colour ][ group ], colours[ colour ], led_amount, &spatial_index );
+    }
+  }
+
+  // **** STROBE ****
+  if( ini_handler.SetSection( "STROBE" ) ) {
+    LEDLayoutSpan* ptr_strobe = &header.m_strobe;
+
+    if( ini_handler.GetTokenValue( "LEDS_ALL" ) == 1 ) {
+      ptr_strobe->m_offset = m_led_list.size();
+      for( int led_number = 1; led_number < led_amount + 1; led_number++ ) {
+        m_led_list.push_back( led_number );
+      }
+    } else if( ini_handler.GetTokenValue( "LEDS_AUTO" ) != 1 ) {
+      // Load strobe LED numbers from ini
+      this->ReadSpan( &ini_handler, ptr_strobe, colours[ LEDLAYOUT_COLOURS ], led_amount, &spatial_index );
+    } else {
+      // Build strobe LED numbers from unassigned LEDs
+      LEDOwnerIndex owners;
+      owners.Clear( led_amount );
+      for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+        for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+          const LEDLayoutSpan& span = header.m_groups[ colour ][ group ];
+          owners.Add( LEDOwnerIndex::GroupIndex( colour, group ), m_led_list.data() + span.m_offset, span.m_amount );
+        }
+      }
+
+      ptr_strobe->m_offset = m_led_list.size();
+      owners.GetUnassigned( &m_led_list );
+    }
+
+    ptr_strobe->m_amount     = m_led_list.size() - ptr_strobe->m_offset;
+    ptr_strobe->m_red        = colours[ LEDLAYOUT_COLOURS ][ 0 ];
+    ptr_strobe->m_green      = colours[ LEDLAYOUT_COLOURS ][ 1 ];
+    ptr_strobe->m_blue       = colours[ LEDLAYOUT_COLOURS ][ 2 ];
+    ptr_strobe->m_brightness = (uint8_t) ini_handler.GetTokenValue( "BRIGHTNESS" );
+  }
+
+  // **** SWEEP ****
+  if( ini_handler.SetSection( "SWEEP" ) ) {
+    this->ReadSweep( &ini_handler, &header.m_sweep, &spatial_index );
+  }
+
+  // Build the file image.
+  header.m_magic           = LEDLAYOUT_MAGIC;
+  header.m_version         = LEDLAYOUT_VERSION;
+  header.m_header_size     = sizeof( LEDLayoutHeader );
+  header.m_led_amount      = led_amount;
+  header.m_led_list_amount = m_led_list.size();
+  header.m_position_amount = m_positions.size();
+
+  const uint32_t positions_offset = sizeof( LEDLayoutHeader ) + m_led_list.size() * sizeof( int32_t );
+
+  m_size = positions_offset + m_positions.size() * sizeof( LEDLayoutPosition );
+  m_compiled.resize( m_size );
+
+  memcpy( m_compiled.data(), &header, sizeof( LEDLayoutHeader ) );
+  if( !m_led_list.empty() ) {
+    memcpy( m_compiled.data() + sizeof( LEDLayoutHeader ), m_led_list.data(), m_led_list.size() * sizeof( int32_t ) );
+  }
+  if( !m_positions.empty() ) {
+    memcpy( m_compiled.data() + positions_offset, m_positions.data(), m_positions.size() * sizeof( LEDLayoutPosition ) );
+  }
+  m_led_list.clear();
+  m_positions.clear();
+
+  m_header = reinterpret_cast<LEDLayoutHeader*>( m_compiled.data() );
+  m_leds   = reinterpret_cast<int32_t*>( m_compiled.data() + sizeof( LEDLayoutHeader ) );
+  m_ptr_positions = header.m_position_amount > 0 ? reinterpret_cast<LEDLayoutPosition*>( m_compiled.data() + positions_offset ) : NULL;
+
+  m_header->m_checksum = Checksum( m_compiled.data(), m_size );
+
+  return true;
+};
+
+void LEDLayout::ReadSpan( INI_Handler* ptrINI_Handler, LEDLayoutSpan* ptr_span, const int colour[ 3 ], const int led_amount, LEDSpatialIndex* ptr_spatial_index ) {
+  // AMOUNT is optional now, the list says how many.  When given it still limits the list.
+  int amount_of_leds = ptrINI_Handler->GetTokenValue( "AMOUNT" );
+  if( amount_of_leds <= 0 ) {
+    amount_of_leds = INT32_MAX;
+  }
+
+  ptr_span->m_offset = m_led_list.size();
+
+  this->ReadLEDList( ptrINI_Handler->GetTokenView( "LEDS" ), amount_of_leds, led_amount, &m_led_list );
+  this->ReadArea( ptrINI_Handler, ptr_spatial_index );
+
+  ptr_span->m_amount     = m_led_list.size() - ptr_span->m_offset;
+  ptr_span->m_red        = colour[ 0 ];
+  ptr_span->m_green      = colour[ 1 ];
+  ptr_span->m_blue       = colour[ 2 ];
+  ptr_span->m_brightness = (uint8_t) ptrINI_Handler->GetTokenValue( "BRIGHTNESS" );
+};
+
+// LED numbers & ranges, e.g. "1-400,520-610,700".  A range can count down.
+void LEDLayout::ReadLEDList( std::string_view leds, const int amount_max, const int led_amount, std::vector<int32_t>* ptr_list ) {
+  int amount = 0;
+
+  while( amount < amount_max && !leds.empty() ) {
+    size_t comma = leds.find( ',' );
+    std::string_view item = leds.substr( 0, comma );
+
+    int range[ 2 ];
+    int numbers = ParseNumbers( item, range, 1 );
+
+    // Numbers outside the array are reported rather than quietly left out at draw time.
+    const int range_min = led_amount > 0 ? 1 : INT32_MIN;
+    const int range_max = led_amount > 0 ? led_amount : INT32_MAX;
+
+    if( numbers == 1 ) {
+      size_t dash = item.find( '-', item.find_first_not_of( ' ' ) + 1 );
+      if( dash == std::string_view::npos ) {
+        if( range[ 0 ] < range_min || range[ 0 ] > range_max ) {
+          MSG_LEDLAYOUT_ERROR( "LED " << range[ 0 ] << " is outside 1 - " << led_amount << ", skipped." );
+        } else {
+          ptr_list->push_back( range[ 0 ] );
+          amount++;
+        }
+      } else if( ParseNumbers( item.substr( dash + 1 ), &range[ 1 ], 1 ) == 1 ) {
+        // Ranges are clipped to the array, so a typo can't add millions of LEDs.
+        if( range[ 0 ] < range_min || range[ 0 ] > range_max || range[ 1 ] < range_min || range[ 1 ] > range_max ) {
+          MSG_LEDLAYOUT_ERROR( "LED range " << range[ 0 ] << "-" << range[ 1 ] << " is outside 1 - " << led_amount << ", clipped." );
+          range[ 0 ] = std::clamp( range[ 0 ], range_min, range_max );
+          range[ 1 ] = std::clamp( range[ 1 ], range_min, range_max );
+        }
+
+        const int step = range[ 0 ] <= range[ 1 ] ? 1 : -1;
+        for( int64_t led_number = range[ 0 ]; amount < amount_max; led_number += step ) {
+          ptr_list->push_back( led_number );
+          amount++;
+          if( led_number == range[ 1 ] ) {
+            break;
+          }
+        }
+      } else {
+        numbers = 0;
+      }
+    }
+
+    if( numbers == 0 ) {
+      MSG_LEDLAYOUT_ERROR( "Bad LED number '" << item << "'" );
+    }
+
+    if( comma == std::string_view::npos ) {
+      break;
+    }
+    leds.remove_prefix( comma + 1 );
+  }
+};
+
+// [POSITION_1], [POSITION_2]... each spread the LEDs in their LEDS list evenly along a line, from FROM=x,y,z
+// to TO=x,y,z.  Any unit will do as long as the groups use the same.  False if there aren't any.
+bool LEDLayout::ReadPositions( INI_Handler* ptrINI_Handler, const int led_amount ) {
+  std::vector<int32_t> leds;
+  std::string section_name;
+
+  for( int line = 1; led_amount > 0; line++ ) {
+    section_name = "POSITION_";
+    section_name += std::to_string( line );
+
+    if( !ptrINI_Handler->SetSection( section_name ) ) {
+      break;
+    }
+
+    if( m_positions.empty() ) {
+      LEDLayoutPosition unplaced;
+      std::fill( unplaced.m_axis, unplaced.m_axis + LEDLAYOUT_AXES, std::numeric_limits<float>::quiet_NaN() );
+      m_positions.assign( led_amount, unplaced );
+    }
+
+    int from[ LEDLAYOUT_AXES ] = { 0, 0, 0 };
+    ParseNumbers( ptrINI_Handler->GetTokenView( "FROM" ), from, LEDLAYOUT_AXES );
+
+    int to[ LEDLAYOUT_AXES ] = { from[ 0 ], from[ 1 ], from[ 2 ] };
+    ParseNumbers( ptrINI_Handler->GetTokenView( "TO" ), to, LEDLAYOUT_AXES );
+
+    leds.clear();
+    this->ReadLEDList( ptrINI_Handler->GetTokenView( "LEDS" ), INT32_MAX, led_amount, &leds );
+
+    // Multiplied before dividing, so whole positions come out exact.
+    const double steps = leds.size() > 1 ? leds.size() - 1 : 1;
+    for( size_t i = 0; i < leds.size(); i++ ) {
+      if( leds[ i ] < 1 || leds[ i ] > led_amount ) {
+        continue;
+      }
+      for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+        m_positions[ leds[ i ] - 1 ].m_axis[ axis ] = from[ axis ] + ( to[ axis ] - from[ axis ] ) * (double)i / steps;
+      }
+    }
+  }
+
+  return !m_positions.empty();
+};
+
+// Adds positioned LEDs by area to the span being read, after any it lists by number.
+// X=low,high  Y=  Z=  keep to a box, any axis left out is unlimited.  SPHERE=x,y,z,radius  keeps to a ball.
+void LEDLayout::ReadArea( INI_Handler* ptrINI_Handler, LEDSpatialIndex* ptr_spatial_index ) {
+  static const char* axis_tokens[ LEDLAYOUT_AXES ] = { "X", "Y", "Z" };
+
+  float low[ LEDLAYOUT_AXES ];
+  float high[ LEDLAYOUT_AXES ];
+  bool  is_box = false;
+
+  for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+    int range[ 2 ];
+    low[ axis ]  = -std::numeric_limits<float>::infinity();
+    high[ axis ] = std::numeric_limits<float>::infinity();
+    if( ptrINI_Handler->TokenExists( axis_tokens[ axis ] ) ) {
+      if( ParseNumbers( ptrINI_Handler->GetTokenView( axis_tokens[ axis ] ), range, 2 ) == 2 ) {
+        low[ axis ]  = std::min( range[ 0 ], range[ 1 ] );
+        high[ axis ] = std::max( range[ 0 ], range[ 1 ] );
+        is_box = true;
+      } else {
+        MSG_LEDLAYOUT_ERROR( axis_tokens[ axis ] << " needs low,high." );
+      }
+    }
+  }
+
+  int sphere[ 4 ];
+  const bool is_sphere = ptrINI_Handler->TokenExists( "SPHERE" ) && ParseNumbers( ptrINI_Handler->GetTokenView( "SPHERE" ), sphere, 4 ) == 4;
+
+  if( !is_box && !is_sphere ) {
+    return;
+  }
+
+  if( ptr_spatial_index->IsEmpty() ) {
+    MSG_LEDLAYOUT_ERROR( "X, Y, Z & SPHERE need POSITION sections, ignored." );
+    return;
+  }
+
+  std::vector<int32_t> leds;
+
+  if( is_sphere ) {
+    const float centre[ LEDLAYOUT_AXES ] = { (float)sphere[ 0 ], (float)sphere[ 1 ], (float)sphere[ 2 ] };
+    ptr_spatial_index->Sphere( centre, sphere[ 3 ], &leds );
+
+    // Both given, the ball is cut to the box.
+    if( is_box ) {
+      leds.erase( std::remove_if( leds.begin(), leds.end(), [ & ]( const int32_t led_number ) {
+        const LEDLayoutPosition* ptr_position = ptr_spatial_index->GetPosition( led_number );
+        for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+          if( ptr_position->m_axis[ axis ] < low[ axis ] || ptr_position->m_axis[ axis ] > high[ axis ] ) {
+            return true;
+          }
+        }
+        return false;
+      } ), leds.end() );
+    }
+  } else {
+    ptr_spatial_index->Box( low, high, &leds );
+  }
+
+  // LED order draws in memory order.
+  std::sort( leds.begin(), leds.end() );
+  m_led_list.insert( m_led_list.end(), leds.begin(), leds.end() );
+};
+
+// AXIS=X, Y or Z  WIDTH=  TIME_MS=  RGB=r,g,b  BRIGHTNESS=
+void LEDLayout::ReadSweep( INI_Handler* ptrINI_Handler, LEDLayoutSweep* ptr_sweep, LEDSpatialIndex* ptr_spatial_index ) {
+  if( ptr_spatial_index->IsEmpty() ) {
+    MSG_LEDLAYOUT_ERROR( "SWEEP needs POSITION sections, ignored." );
+    return;
+  }
+
+  const std::string_view axis = ptrINI_Handler->GetTokenView( "AXIS" );
+  if( axis == "Y" ) {
+    ptr_sweep->m_axis = LEDLAYOUT_AXIS_Y;
+  } else if( axis == "Z" ) {
+    ptr_sweep->m_axis = LEDLAYOUT_AXIS_Z;
+  } else {
+    if( !axis.empty() && axis != "X" ) {
+      MSG_LEDLAYOUT_ERROR( "Unknown SWEEP AXIS '" << axis << "', using X." );
+    }
+    ptr_sweep->m_axis = LEDLAYOUT_AXIS_X;
+  }
+
+  const int width   = ptrINI_Handler->GetTokenValue( "WIDTH" );
+  const int time_ms = ptrINI_Handler->GetTokenValue( "TIME_MS" );
+  if( width <= 0 || time_ms <= 0 ) {
+    MSG_LEDLAYOUT_ERROR( "SWEEP needs a WIDTH & TIME_MS above 0, ignored." );
+    return;
+  }
+
+  int rgb[ 3 ] = { 255, 255, 255 };
+  ParseNumbers( ptrINI_Handler->GetTokenView( "RGB" ), rgb, 3 );
+
+  ptr_sweep->m_width      = width;
+  ptr_sweep->m_time_ms    = time_ms;
+  ptr_sweep->m_red        = std::clamp( rgb[ 0 ], 0, 255 );
+  ptr_sweep->m_green      = std::clamp( rgb[ 1 ], 0, 255 );
+  ptr_sweep->m_blue       = std::clamp( rgb[ 2 ], 0, 255 );
+  ptr_sweep->m_brightness = (uint8_t) ptrINI_Handler->GetTokenValue( "BRIGHTNESS" );
+};
+
+// REPLACE, ADD or MAX.  Defaults to REPLACE.
+int LEDLayout::ParseBlendMode( std::string_view text ) {
+  if( text == "ADD" ) {
+    return LEDLAYOUT_BLEND_ADD;
+  } else if( text == "MAX" ) {
+    return LEDLAYOUT_BLEND_MAX;
+  } else if( !text.empty() && text != "REPLACE" ) {
+    MSG_LEDLAYOUT_ERROR( "Unknown BLEND_MODE '" << text << "', using REPLACE." );
+  }
+
+  return LEDLAYOUT_BLEND_REPLACE;
+};
+
+// 1.0 to 2.8, e.g. 2.2.  Defaults to 1.0, no correction.
+int LEDLayout::ParseGamma( std::string_view text ) {
+  if( text.empty() ) {
+    return GAMMA_LINEAR;
+  }
+
+  double gamma = 0;
+  std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), gamma );
+  const int gamma_tenths = result.ec == std::errc() ? (int)( gamma * 10.0 + 0.5 ) : 0;
+
+  if( GammaFindTable( gamma_tenths ) == NULL ) {
+    MSG_LEDLAYOUT_ERROR( "Unsupported GAMMA '" << text << "', using 1.0.  Use 1.0, 1.8, 2.0, 2.2, 2.4, 2.6 or 2.8." );
+    return GAMMA_LINEAR;
+  }
+
+  return gamma_tenths;
+};
+
+// WHITE_BALANCE=r,g,b scales each colour, COLOUR_MATRIX=9 values also mixes them & wins if both are set.
+// Values are percent, 100 leaves a colour as it is.
+void LEDLayout::ParseColourMatrix( std::string_view white_balance, std::string_view colour_matrix, int16_t matrix[ 3 ][ 3 ] ) {
+  int percent[ 9 ] = { 100, 0, 0,
+                       0, 100, 0,
+                       0, 0, 100 };
+
+  if( !colour_matrix.empty() ) {
+    if( ParseNumbers( colour_matrix, percent, 9 ) != 9 ) {
+      MSG_LEDLAYOUT_ERROR( "COLOUR_MATRIX needs 9 values, red out from r,g,b then green then blue." );
+    }
+  } else if( !white_balance.empty() ) {
+    int balance[ 3 ] = { 100, 100, 100 };
+    ParseNumbers( white_balance, balance, 3 );
+    percent[ 0 ] = balance[ 0 ];
+    percent[ 4 ] = balance[ 1 ];
+    percent[ 8 ] = balance[ 2 ];
+  }
+
+  for( int row = 0; row < 3; row++ ) {
+    for( int column = 0; column < 3; column++ ) {
+      const int value = std::clamp( percent[ row * 3 + column ], -LEDLAYOUT_MATRIX_MAX_PCT, LEDLAYOUT_MATRIX_MAX_PCT );
+      matrix[ row ][ column ] = value * LEDLAYOUT_MATRIX_ONE / 100;
+    }
+  }
+};
+
+// Reads up to amount_max comma separated numbers, returns how many were read.
+int LEDLayout::ParseNumbers( std::string_view text, int numbers[], const int amount_max ) {
+  int amount = 0;
+
+  while( amount < amount_max && !text.empty() ) {
+    while( !text.empty() && text.front() == ' ' ) {
+      text.remove_prefix( 1 );
+    }
+
+    std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), numbers[ amount ] );
+    if( result.ec != std::errc() ) {
+      break;
+    }
+    amount++;
+
+    size_t comma = text.find( ',' );
+    if( comma == std::string_view::npos ) {
+      break;
+    }
+    text.remove_prefix( comma + 1 );
+  }
+
+  return amount;
+};
+
+bool LEDLayout::Save( const std::string& layout_file ) {
+  if( !this->IsLoaded() ) {
+    return false;
+  }
+
+  const std::string temporary_file = layout_file + ".tmp";
+
+  int file_descriptor = open( temporary_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if( file_descriptor < 0 ) {
+    MSG_LEDLAYOUT_DEBUG( "Unable to create " << temporary_file );
+    return false;
+  }
+
+  const uint8_t* ptr_data = reinterpret_cast<const uint8_t*>( m_header );
+  uint32_t written = 0;
+
+  while( written < m_size ) {
+    ssize_t result = write( file_descriptor, ptr_data + written, m_size - written );
+    if( result <= 0 ) {
+      if( result < 0 && errno == EINTR ) {
+        continue;
+      }
+      break;
+    }
+    written += result;
+  }
+
+  close( file_descriptor );
+
+  if( written != m_size || rename( temporary_file.c_str(), layout_file.c_str() ) != 0 ) {
+    MSG_LEDLAYOUT_ERROR( "Unable to write " << layout_file );
+    unlink( temporary_file.c_str() );
+    return false;
+  }
+
+  return true;
+};
+
+bool LEDLayout::Map( const std::string& layout_file, const std::string& ini_file, const int led_amount ) {
+  this->Close();
+
+  uint32_t ini_size;
+  int64_t  ini_mtime;
+
+  if( !ReadIniStat( ini_file, &ini_size, &ini_mtime ) ) {
+    return false;
+  }
+
+  int file_descriptor = open( layout_file.c_str(), O_RDONLY );
+  if( file_descriptor < 0 ) {
+    return false;
+  }
+
+  struct stat layout_stat;
+  if( fstat( file_descriptor, &layout_stat ) != 0 || layout_stat.st_size < (off_t) sizeof( LEDLayoutHeader ) ) {
+    close( file_descriptor );
+    return false;
+  }
+
+  // Private & writable, so the LED list can be handed out without const.  Pages are only copied if written to.
+  m_map_size = layout_stat.st_size;
+  m_ptr_map  = mmap( NULL, m_map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0 );
+  close( file_descriptor );
+
+  if( m_ptr_map == MAP_FAILED ) {
+    m_ptr_map  = NULL;
+    m_map_size = 0;
+    return false;
+  }
+
+  LEDLayoutHeader* ptr_header = static_cast<LEDLayoutHeader*>( m_ptr_map );
+  const char* reason = NULL;
+
+  if( ptr_header->m_magic != LEDLAYOUT_MAGIC ) {
+    reason = "not a layout file";
+  } else if( ptr_header->m_version != LEDLAYOUT_VERSION || ptr_header->m_header_size != sizeof( LEDLayoutHeader ) ) {
+    reason = "old version";
+  } else if( ptr_header->m_position_amount != 0 && ptr_header->m_position_amount != ptr_header->m_led_amount ) {
+    reason = "positions don't match the LEDs";
+  } else if( m_map_size != sizeof( LEDLayoutHeader ) + (size_t) ptr_header->m_led_list_amount * sizeof( int32_t )
+                           + (size_t) ptr_header->m_position_amount * sizeof( LEDLayoutPosition ) ) {
+    reason = "wrong size";
+  } else if( ptr_header->m_ini_size != ini_size || ptr_header->m_ini_mtime != ini_mtime ) {
+    reason = "ini has changed";
+  } else if( ptr_header->m_led_amount != (uint32_t) led_amount ) {
+    reason = "built for a different amount of LEDs";
+  } else if( ptr_header->m_checksum != Checksum( static_cast<uint8_t*>( m_ptr_map ), m_map_size ) ) {
+    reason = "checksum failed";
+  } else if( ptr_header->m_blend_mode > LEDLAYOUT_BLEND_MAX ) {
+    reason = "unknown blend mode";
+  } else if( GammaFindTable( ptr_header->m_gamma ) == NULL ) {
+    reason = "unknown gamma";
+  } else {
+    const uint64_t list_amount = ptr_header->m_led_list_amount;
+    bool spans_valid = (uint64_t) ptr_header->m_strobe.m_offset + ptr_header->m_strobe.m_amount <= list_amount;
+    for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+      for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+        const LEDLayoutSpan& span = ptr_header->m_groups[ colour ][ group ];
+        spans_valid = spans_valid && (uint64_t) span.m_offset + span.m_amount <= list_amount;
+      }
+    }
+    if( !spans_valid ) {
+      reason = "group out of range";
+    }
+  }
+
+  if( reason != NULL ) {
+    MSG_LEDLAYOUT_INFO( "Not using " << layout_file << " : " << reason );
+    this->Close();
+    return false;
+  }
+
+  m_header = ptr_header;
+  m_leds   = reinterpret_cast<int32_t*>( static_cast<uint8_t*>( m_ptr_map ) + sizeof( LEDLayoutHeader ) );
+  m_size   = m_map_size;
+  if( ptr_header->m_position_amount > 0 ) {
+    m_ptr_positions = reinterpret_cast<LEDLayoutPosition*>( m_leds + ptr_header->m_led_list_amount );
+  }
+
+  return true;
+};
+
+// FNV-1a, skipping the checksum field itself.
+uint32_t LEDLayout::Checksum( const uint8_t* data, const uint32_t size ) {
+  const uint32_t checksum_start = offsetof( LEDLayoutHeader, m_checksum );
+  const uint32_t checksum_end   = checksum_start + sizeof( uint32_t );
+
+  uint32_t hash = 2166136261u;
+
+  for( uint32_t i = 0; i < size; i++ ) {
+    const uint8_t value = ( i >= checksum_start && i < checksum_end ) ? 0 : data[ i ];
+    hash = ( hash ^ value ) * 16777619u;
+  }
+
+  return hash;
+};
+
+bool LEDLayout::ReadIniStat( const std::string& ini_file, uint32_t* ptr_size, int64_t* ptr_mtime ) {
+  struct stat ini_stat;
+
+  if( stat( ini_file.c_str(), &ini_stat ) != 0 ) {
+    MSG_LEDLAYOUT_ERROR( "Unable to find " << ini_file );
+    return false;
+  }
+
+  *ptr_size  = ini_stat.st_size;
+  *ptr_mtime = (int64_t) ini_stat.st_mtim.tv_sec * 1000000000 + ini_stat.st_mtim.tv_nsec;
+
+  return true;
+};
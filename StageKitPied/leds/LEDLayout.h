@@ -0,0 +1,190 @@
+#ifndef _LEDLAYOUT_H_
+#define _LEDLAYOUT_H_
+
+#define MSG_LEDLAYOUT_DEBUG( str ) LOG_DEBUG( "LEDLayout", str )
+
+#define MSG_LEDLAYOUT_ERROR( str ) LOG_ERROR( "LEDLayout", str )
+#define MSG_LEDLAYOUT_INFO( str ) LOG_INFO( "LEDLayout", str )
+
+#include <algorithm> // clamp, remove_if, sort
+#include <cstddef>   // offsetof
+#include <cstdint>   // INT32_MAX
+#include <cerrno>
+#include <cstdio>    // rename
+#include <cstring>   // memcpy
+#include <iostream>
+#include <limits>    // NaN
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>  // from_chars
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // stat
+
+#include "helpers/INI_Handler.h"
+#include "helpers/Log.h"
+#include "leds/GammaTables.h"
+
+// Compiled layout file, written next to the LED ini with this appended to the name.
+#define LEDLAYOUT_EXTENSION ".layout"
+
+#define LEDLAYOUT_MAGIC   0x4c504b53  // "SKPL"
+#define LEDLAYOUT_VERSION 6  // 2 = AMOUNT no longer cut to 255, LED ranges.  3 = Blend mode.  4 = Gamma & colour matrix.  5 = Positions.  6 = Sweep.
+
+#define LEDLAYOUT_COLOURS 4  // Red, green, blue, yellow
+#define LEDLAYOUT_GROUPS  8  // One per stage kit LED
+
+#define LEDLAYOUT_RED    0
+#define LEDLAYOUT_GREEN  1
+#define LEDLAYOUT_BLUE   2
+#define LEDLAYOUT_YELLOW 3
+
+// How a colour group is drawn over LEDs that earlier groups have lit.  Groups are drawn red, green, blue,
+// yellow then strobe, so the result doesn't depend on the order the stage kit data arrived in.
+#define LEDLAYOUT_BLEND_REPLACE 0  // Later group wins.
+#define LEDLAYOUT_BLEND_ADD     1  // Colours add, stopping at full.
+#define LEDLAYOUT_BLEND_MAX     2  // Brightest of each colour channel.
+
+#define LEDLAYOUT_MATRIX_ONE     256  // 1.0 in the colour matrix.
+#define LEDLAYOUT_MATRIX_MAX_PCT 400  // Matrix entries are given in percent, up to this either way.
+
+#define LEDLAYOUT_AXIS_X 0  // Across the stage.
+#define LEDLAYOUT_AXIS_Y 1  // Up.
+#define LEDLAYOUT_AXIS_Z 2  // Towards the audience.
+#define LEDLAYOUT_AXES   3
+
+class LEDSpatialIndex;
+
+// A run of LED numbers in the layout's LED list, with the colour it lights them.
+struct LEDLayoutSpan
+{
+  uint32_t m_offset;  // Into the LED list.
+  uint32_t m_amount;
+  uint8_t  m_red;
+  uint8_t  m_green;
+  uint8_t  m_blue;
+  uint8_t  m_brightness;
+};
+
+// Where an LED is, in whatever unit the ini uses.  NaN for an LED no POSITION section placed.
+struct LEDLayoutPosition
+{
+  float m_axis[ LEDLAYOUT_AXES ];
+};
+
+// A band of light moved across the stage along one axis while any colour group is lit.  m_time_ms 0 is off.
+struct LEDLayoutSweep
+{
+  float    m_width;    // In position units.
+  uint32_t m_time_ms;  // To cross the stage once.
+  uint8_t  m_axis;     // LEDLAYOUT_AXIS_
+  uint8_t  m_red;
+  uint8_t  m_green;
+  uint8_t  m_blue;
+  uint8_t  m_brightness;
+  uint8_t  m_reserved[ 3 ];
+};
+
+// Start of the layout file, followed by m_led_list_amount int32 LED numbers, then m_position_amount positions.
+struct LEDLayoutHeader
+{
+  uint32_t m_magic;
+  uint16_t m_version;
+  uint16_t m_header_size;
+  uint32_t m_checksum;          // Of the whole file, with this set to 0.
+  uint32_t m_ini_size;          // Size & time of the ini it was built from.
+  int64_t  m_ini_mtime;
+  uint32_t m_led_amount;        // LEDS_ALL & LEDS_AUTO strobes depend on the amount of LEDs.
+  uint32_t m_led_list_amount;
+  uint32_t m_position_amount;   // 0 or m_led_amount, LED 1 first.
+  uint32_t m_blend_mode;        // LEDLAYOUT_BLEND_
+  uint32_t m_gamma;             // In tenths, one of GAMMA_VALUES.
+  int16_t  m_colour_matrix[ 3 ][ 3 ];  // Row per output red, green, blue, 1/LEDLAYOUT_MATRIX_ONE units.
+  uint16_t m_reserved;
+  LEDLayoutSpan m_groups[ LEDLAYOUT_COLOURS ][ LEDLAYOUT_GROUPS ];
+  LEDLayoutSpan m_strobe;
+  LEDLayoutSweep m_sweep;
+};
+
+// LED layout from a leds ini, in a form that can be written out & mapped straight back in.
+class LEDLayout {
+public:
+  LEDLayout();
+
+  ~LEDLayout();
+
+  // Reads the layout from a leds ini.
+  bool Compile( const std::string& ini_file, const int led_amount );
+
+  // Writes the layout out.  Written to a temporary file first, so a reader never sees half a file.
+  bool Save( const std::string& layout_file );
+
+  // Maps a saved layout.  Fails if it doesn't match the ini it was built from, or the LED amount.
+  bool Map( const std::string& layout_file, const std::string& ini_file, const int led_amount );
+
+  // Releases the layout.  Anything using its LED list must be done with it.
+  void Close();
+
+  bool IsLoaded();
+
+  const LEDLayoutSpan& GetGroup( const int colour, const int group );
+
+  const LEDLayoutSpan& GetStrobe();
+
+  const LEDLayoutSweep& GetSweep();
+
+  int GetBlendMode();
+
+  // Gamma in tenths.
+  int GetGamma();
+
+  // Red, green & blue out from red, green & blue in.
+  const int16_t ( *GetColourMatrix() )[ 3 ];
+
+  // LED numbers, indexed by the spans.
+  int32_t* GetLEDs();
+
+  // Position of each LED, LED 1 first.  NULL if the ini has no POSITION sections.
+  const LEDLayoutPosition* GetPositions();
+
+  uint32_t GetSize();
+
+private:
+  void ReadSpan( INI_Handler* ptrINI_Handler, LEDLayoutSpan* ptr_span, const int colour[ 3 ], const int led_amount, LEDSpatialIndex* ptr_spatial_index );
+
+  void ReadLEDList( std::string_view leds, const int amount_max, const int led_amount, std::vector<int32_t>* ptr_list );
+
+  bool ReadPositions( INI_Handler* ptrINI_Handler, const int led_amount );
+
+  void ReadArea( INI_Handler* ptrINI_Handler, LEDSpatialIndex* ptr_spatial_index );
+
+  void ReadSweep( INI_Handler* ptrINI_Handler, LEDLayoutSweep* ptr_sweep, LEDSpatialIndex* ptr_spatial_index );
+
+  static int ParseBlendMode( std::string_view text );
+
+  static int ParseGamma( std::string_view text );
+
+  static void ParseColourMatrix( std::string_view white_balance, std::string_view colour_matrix, int16_t matrix[ 3 ][ 3 ] );
+
+  static int ParseNumbers( std::string_view text, int numbers[], const int amount_max );
+
+  static uint32_t Checksum( const uint8_t* data, const uint32_t size );
+
+  static bool ReadIniStat( const std::string& ini_file, uint32_t* ptr_size, int64_t* ptr_mtime );
+
+  std::vector<int32_t> m_led_list;   // While compiling.
+  std::vector<LEDLayoutPosition> m_positions;
+  std::vector<uint8_t> m_compiled;   // Compiled file image.
+
+  LEDLayoutHeader* m_header;
+  int32_t*         m_leds;
+  LEDLayoutPosition* m_ptr_positions;
+  uint32_t         m_size;
+
+  void*            m_ptr_map;
+  size_t           m_map_size;
+};
+
+#endif
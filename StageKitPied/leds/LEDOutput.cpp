@@ -0,0 +1,60 @@
+#include "LEDOutput.h"
+
+#include "leds/LEDOutputMemory.h"
+#include "leds/PixelFormats.h"
+#include "leds/SPIPixelOutput.h"
+#include "leds/WS2812.h"
+
+// One SPIPixelOutput for each colour order, so the order is fixed at compile time.
+template< template< int > class Format >
+static std::unique_ptr<LEDOutput> CreateOrdered( const int order ) {
+  switch( order ) {
+    case PIXEL_ORDER_RGB: return std::unique_ptr<LEDOutput>( new SPIPixelOutput< Format< PIXEL_ORDER_RGB > >() );
+    case PIXEL_ORDER_RBG: return std::unique_ptr<LEDOutput>( new SPIPixelOutput< Format< PIXEL_ORDER_RBG > >() );
+    case PIXEL_ORDER_GRB: return std::unique_ptr<LEDOutput>( new SPIPixelOutput< Format< PIXEL_ORDER_GRB > >() );
+    case PIXEL_ORDER_GBR: return std::unique_ptr<LEDOutput>( new SPIPixelOutput< Format< PIXEL_ORDER_GBR > >() );
+    case PIXEL_ORDER_BRG: return std::unique_ptr<LEDOutput>( new SPIPixelOutput< Format< PIXEL_ORDER_BRG > >() );
+    default:              return std::unique_ptr<LEDOutput>( new SPIPixelOutput< Format< PIXEL_ORDER_BGR > >() );
+  }
+};
+
+// "NAME" gives default_order, "NAME_GRB" etc. the order named.  -1 if type isn't this LED.
+static int ParseOrder( const std::string& type, const std::string& name, const int default_order ) {
+  if( type == name ) {
+    return default_order;
+  }
+  if( type.size() != name.size() + 4 || type.compare( 0, name.size() + 1, name + "_" ) != 0 ) {
+    return -1;
+  }
+  for( int order = 0; order < PIXEL_ORDERS; order++ ) {
+    if( type.compare( name.size() + 1, 3, PIXEL_ORDER_NAMES[ order ] ) == 0 ) {
+      return order;
+    }
+  }
+  return -1;
+};
+
+std::unique_ptr<LEDOutput> LEDOutput::Create( const std::string& type ) {
+  if( type == "WS2812" || type == "SK6812" ) {
+    return std::unique_ptr<LEDOutput>( new WS2812( false ) );
+  } else if( type == "SK6812_RGBW" ) {
+    return std::unique_ptr<LEDOutput>( new WS2812( true ) );
+  } else if( type == "MEMORY" ) {
+    return std::unique_ptr<LEDOutput>( new LEDOutputMemory() );
+  }
+
+  const int sk9822_order = ParseOrder( type.empty() ? "SK9822" : type, "SK9822", PIXEL_ORDER_BGR );
+  const int apa102_order = ParseOrder( type, "APA102", PIXEL_ORDER_BGR );
+  const int hd108_order  = ParseOrder( type, "HD108", PIXEL_ORDER_RGB );
+
+  if( sk9822_order >= 0 ) {
+    return CreateOrdered< PixelFormatSK9822 >( sk9822_order );
+  } else if( apa102_order >= 0 ) {
+    return CreateOrdered< PixelFormatAPA102 >( apa102_order );
+  } else if( hd108_order >= 0 ) {
+    return CreateOrdered< PixelFormatHD108 >( hd108_order );
+  }
+
+  MSG_LEDOUTPUT_ERROR( "Unknown LED TYPE '" << type << "'.  Use SK9822, APA102, HD108, WS2812, SK6812, SK6812_RGBW or MEMORY." );
+  return NULL;
+};
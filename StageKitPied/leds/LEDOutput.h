@@ -0,0 +1,91 @@
+#ifndef _LEDOUTPUT_H_
+#define _LEDOUTPUT_H_
+
+#define MSG_LEDOUTPUT_ERROR( str ) LOG_ERROR( "LEDOutput", str )
+
+// How each LED is sent on the wire.
+#define LEDOUTPUT_FORMAT_BRIGHTNESS_8  0  // SK9822 & APA102 : 0xE0 | 5 bit brightness, 8 bit colours.
+#define LEDOUTPUT_FORMAT_GRB           1  // WS2812 & SK6812, SPI bit encoded.
+#define LEDOUTPUT_FORMAT_GRBW          2  // SK6812 RGBW, SPI bit encoded.
+#define LEDOUTPUT_FORMAT_HD108         3  // 5 bit gain for each colour, 16 bit colours.
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "helpers/Log.h"
+#include "leds/PixelKernels.h"
+
+// Something LED frames can be sent to.  Frames are set as packed Pixels (see PixelKernels.h), then each
+// output turns them into whatever its LEDs take.
+class LEDOutput {
+public:
+  virtual ~LEDOutput() {};
+
+  // Makes an output by its lights.ini TYPE, SK9822, APA102, HD108, WS2812, SK6812, SK6812_RGBW or MEMORY.
+  // SK9822, APA102 & HD108 can end in a colour order for strips wired differently, e.g. APA102_RGB.
+  // NULL if the type isn't known.
+  static std::unique_ptr<LEDOutput> Create( const std::string& type );
+
+  // device_name is what the output writes to, such as /dev/spidev0.0.  Nothing is opened until enabled.
+  virtual bool Init( const int led_amount, const std::string& device_name ) = 0;
+
+  virtual bool SetEnabled( const bool enabled ) = 0;
+
+  virtual bool IsEnabled() = 0;
+
+  virtual int GetAmountLEDS() = 0;
+
+  // LEDOUTPUT_FORMAT_ for each LED.
+  virtual int GetPixelFormat() = 0;
+
+  // True if the LEDs take the pixel brightness as well as colour.
+  virtual bool HasBrightness() = 0;
+
+  // True if the LEDs take 16 bit colour, through SetPixels16.
+  virtual bool HasDepth16() {
+    return false;
+  };
+
+  // Bytes sent for one frame, including any start & end frames.
+  virtual size_t GetFrameSize() = 0;
+
+  // Time to send one frame.
+  virtual long GetFrameTimeUs() = 0;
+
+  // pixels[ 0 ] is LED 1.  Nothing is sent until Submit.
+  void SetPixels( const Pixel* pixels ) {
+    this->SetPixelRange( pixels, 0, this->GetAmountLEDS() );
+  };
+
+  // Red, green & blue per LED, 65535 full at brightness 31.  Only used when HasDepth16.
+  void SetPixels16( const uint16_t* ptr_colour ) {
+    this->SetPixelRange16( ptr_colour, 0, this->GetAmountLEDS() );
+  };
+
+  // Sets LEDs first + 1 to first + amount from pixels[ first ] on.  Ranges that don't overlap can be set from
+  // separate threads at the same time.
+  virtual void SetPixelRange( const Pixel* pixels, const int first, const int amount ) = 0;
+
+  virtual void SetPixelRange16( const uint16_t* ptr_colour, const int first, const int amount ) {
+  };
+
+  // led_number has range 1 to GetAmountLEDS().  Brightness is 0-31.
+  virtual void SetColour( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) = 0;
+
+  virtual void SetColourAll( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) = 0;
+
+  void AllOff() {
+    this->SetColourAll( 0, 0, 0, 0 );
+  };
+
+  // Sends the frame.
+  virtual bool Submit() = 0;
+
+  // Returns once the last frame has been sent.  spidev writes block, so SPI outputs are already done.
+  virtual bool WaitComplete() = 0;
+};
+
+#endif
@@ -0,0 +1,183 @@
+#include "LEDOutputMemory.h"
+
+LEDOutputMemory::LEDOutputMemory() {
+  m_enabled          = false;
+  m_file_descriptor  = -1;
+  m_frames_max       = LEDOUTPUTMEMORY_FRAMES_DEFAULT;
+  m_frame_first      = 0;
+  m_frames_submitted = 0;
+};
+
+LEDOutputMemory::~LEDOutputMemory() {
+  this->SetEnabled( false );
+};
+
+bool LEDOutputMemory::Init( const int led_amount, const std::string& device_name ) {
+  if( led_amount <= 0 ) {
+    return false;
+  }
+
+  m_file_name = device_name;
+  m_pixels.assign( led_amount, 0 );
+  this->ClearFrames();
+
+  return true;
+};
+
+bool LEDOutputMemory::SetEnabled( const bool enabled ) {
+  if( m_enabled == enabled ) {
+    return true;
+  }
+
+  if( !enabled ) {
+    if( m_file_descriptor != -1 ) {
+      close( m_file_descriptor );
+      m_file_descriptor = -1;
+    }
+    m_enabled = false;
+    return true;
+  }
+
+  if( !m_file_name.empty() ) {
+    m_file_descriptor = open( m_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( m_file_descriptor < 0 ) {
+      MSG_LEDOUTPUTMEMORY_ERROR( "Unable to create " << m_file_name );
+      return false;
+    }
+
+    LEDOutputMemoryHeader header;
+    header.m_magic       = LEDOUTPUTMEMORY_MAGIC;
+    header.m_version     = LEDOUTPUTMEMORY_VERSION;
+    header.m_header_size = sizeof( LEDOutputMemoryHeader );
+    header.m_led_amount  = m_pixels.size();
+    header.m_reserved    = 0;
+
+    if( !this->WriteAll( &header, sizeof( header ) ) ) {
+      close( m_file_descriptor );
+      m_file_descriptor = -1;
+      return false;
+    }
+  }
+
+  m_time_start       = std::chrono::steady_clock::now();
+  m_frames_submitted = 0;
+  m_enabled          = true;
+
+  return true;
+};
+
+bool LEDOutputMemory::IsEnabled() {
+  return m_enabled;
+};
+
+int LEDOutputMemory::GetAmountLEDS() {
+  return m_pixels.size();
+};
+
+int LEDOutputMemory::GetPixelFormat() {
+  return LEDOUTPUT_FORMAT_BRIGHTNESS_8;
+};
+
+bool LEDOutputMemory::HasBrightness() {
+  return true;
+};
+
+size_t LEDOutputMemory::GetFrameSize() {
+  return m_pixels.size() * sizeof( Pixel );
+};
+
+long LEDOutputMemory::GetFrameTimeUs() {
+  return 0;
+};
+
+void LEDOutputMemory::SetPixelRange( const Pixel* pixels, const int first, const int amount ) {
+  std::copy( pixels + first, pixels + first + amount, m_pixels.begin() + first );
+};
+
+void LEDOutputMemory::SetColour( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
+  if( led_number > 0 && led_number <= (int)m_pixels.size() ) {
+    m_pixels[ led_number - 1 ] = PixelPack( red, green, blue, brightness & 0x1F );
+  }
+};
+
+void LEDOutputMemory::SetColourAll( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
+  std::fill( m_pixels.begin(), m_pixels.end(), PixelPack( red, green, blue, brightness & 0x1F ) );
+};
+
+bool LEDOutputMemory::Submit() {
+  if( !m_enabled || m_pixels.empty() ) {
+    return false;
+  }
+
+  const int64_t time_us = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - m_time_start ).count();
+  m_frames_submitted++;
+
+  if( m_frames_max > 0 ) {
+    // Slots are reused once the ring is full, so recording doesn't allocate.
+    LEDOutputFrame* ptr_frame;
+    if( m_frames.size() < m_frames_max ) {
+      m_frames.emplace_back();
+      ptr_frame = &m_frames.back();
+    } else {
+      ptr_frame = &m_frames[ m_frame_first ];
+      m_frame_first = ( m_frame_first + 1 ) % m_frames_max;
+    }
+    ptr_frame->m_time_us = time_us;
+    ptr_frame->m_pixels  = m_pixels;
+  }
+
+  if( m_file_descriptor != -1 ) {
+    if( !this->WriteAll( &time_us, sizeof( time_us ) ) || !this->WriteAll( m_pixels.data(), this->GetFrameSize() ) ) {
+      MSG_LEDOUTPUTMEMORY_ERROR( "Writing to " << m_file_name << " failed, recording stopped." );
+      close( m_file_descriptor );
+      m_file_descriptor = -1;
+      return false;
+    }
+  }
+
+  return true;
+};
+
+bool LEDOutputMemory::WaitComplete() {
+  return true;
+};
+
+void LEDOutputMemory::SetFramesMax( const uint32_t frames_max ) {
+  m_frames_max = frames_max;
+  this->ClearFrames();
+};
+
+uint64_t LEDOutputMemory::GetFramesSubmitted() {
+  return m_frames_submitted;
+};
+
+uint32_t LEDOutputMemory::GetAmountFrames() {
+  return m_frames.size();
+};
+
+const LEDOutputFrame& LEDOutputMemory::GetFrame( const uint32_t index ) {
+  return m_frames[ ( m_frame_first + index ) % m_frames.size() ];
+};
+
+void LEDOutputMemory::ClearFrames() {
+  m_frames.clear();
+  m_frame_first = 0;
+};
+
+bool LEDOutputMemory::WriteAll( const void* ptr_data, const size_t size ) {
+  const uint8_t* ptr_bytes = static_cast<const uint8_t*>( ptr_data );
+  size_t written = 0;
+
+  while( written < size ) {
+    ssize_t result = write( m_file_descriptor, ptr_bytes + written, size - written );
+    if( result <= 0 ) {
+      if( result < 0 && errno == EINTR ) {
+        continue;
+      }
+      return false;
+    }
+    written += result;
+  }
+
+  return true;
+};
@@ -0,0 +1,108 @@
+#ifndef _LEDOUTPUTMEMORY_H_
+#define _LEDOUTPUTMEMORY_H_
+
+#define MSG_LEDOUTPUTMEMORY_DEBUG( str ) LOG_DEBUG( "LEDOutputMemory", str )
+
+#define MSG_LEDOUTPUTMEMORY_ERROR( str ) LOG_ERROR( "LEDOutputMemory", str )
+
+#define LEDOUTPUTMEMORY_FRAMES_DEFAULT 1024        // Frames kept in memory, oldest dropped first.
+#define LEDOUTPUTMEMORY_MAGIC          0x46504b53  // "SKPF"
+#define LEDOUTPUTMEMORY_VERSION        1
+
+#include <algorithm>  // copy, fill
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "helpers/Log.h"
+#include "leds/LEDOutput.h"
+
+// Start of a recording file.  Each frame follows as an int64 time in microseconds since the
+// recording started, then led_amount Pixels.
+struct LEDOutputMemoryHeader
+{
+  uint32_t m_magic;
+  uint16_t m_version;
+  uint16_t m_header_size;
+  uint32_t m_led_amount;
+  uint32_t m_reserved;
+};
+
+// A frame as it was submitted.
+struct LEDOutputFrame
+{
+  int64_t            m_time_us;  // Since the output was enabled.
+  std::vector<Pixel> m_pixels;   // LED 1 first.
+};
+
+// Keeps the frames it's sent, with when they were sent, & can write them to a file as well.
+// For benchmarks & comparing frames against known good ones, on machines without LEDs.
+class LEDOutputMemory : public LEDOutput {
+public:
+  LEDOutputMemory();
+
+  ~LEDOutputMemory();
+
+  // device_name is a file to record to, or empty to only keep frames in memory.
+  bool Init( const int led_amount, const std::string& device_name ) override;
+
+  bool SetEnabled( const bool enabled ) override;
+
+  bool IsEnabled() override;
+
+  int GetAmountLEDS() override;
+
+  int GetPixelFormat() override;
+
+  bool HasBrightness() override;
+
+  size_t GetFrameSize() override;
+
+  long GetFrameTimeUs() override;
+
+  void SetPixelRange( const Pixel* pixels, const int first, const int amount ) override;
+
+  void SetColour( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) override;
+
+  void SetColourAll( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) override;
+
+  bool Submit() override;
+
+  bool WaitComplete() override;
+
+  // Frames kept in memory, 0 keeps none.
+  void SetFramesMax( const uint32_t frames_max );
+
+  // Frames submitted since enabled, including any no longer kept.
+  uint64_t GetFramesSubmitted();
+
+  uint32_t GetAmountFrames();
+
+  // 0 is the oldest frame kept.
+  const LEDOutputFrame& GetFrame( const uint32_t index );
+
+  void ClearFrames();
+
+private:
+  bool WriteAll( const void* ptr_data, const size_t size );
+
+  bool        m_enabled;
+  std::string m_file_name;
+  int         m_file_descriptor;
+
+  std::vector<Pixel> m_pixels;   // Frame being set.
+
+  std::vector<LEDOutputFrame> m_frames;  // Ring, m_frame_first is the oldest.
+  uint32_t    m_frames_max;
+  uint32_t    m_frame_first;
+  uint64_t    m_frames_submitted;
+
+  std::chrono::steady_clock::time_point m_time_start;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "LEDOwnerIndex.h"
+
+LEDOwnerIndex::LEDOwnerIndex() {
+  m_led_amount = 0;
+  m_words      = 0;
+};
+
+LEDOwnerIndex::~LEDOwnerIndex() {
+};
+
+void LEDOwnerIndex::Clear( const int led_amount ) {
+  m_led_amount = led_amount > 0 ? led_amount : 0;
+
+  // LED numbers start at 1, bit 0 is never set.
+  m_words = ( m_led_amount + 1 + 63 ) / 64;
+
+  m_bits.assign( (size_t)m_words * LEDOWNERINDEX_GROUPS, 0 );
+  m_owners.assign( m_led_amount + 1, 0 );
+};
+
+void LEDOwnerIndex::Add( const int group_index, const int32_t* leds, const uint32_t amount ) {
+  if( group_index < 0 || group_index >= LEDOWNERINDEX_GROUPS ) {
+    return;
+  }
+
+  uint64_t* ptr_bits = &m_bits[ (size_t)group_index * m_words ];
+
+  for( uint32_t i = 0; i < amount; i++ ) {
+    const int32_t led_number = leds[ i ];
+    if( led_number < 1 || led_number > m_led_amount ) {
+      continue;
+    }
+
+    ptr_bits[ led_number >> 6 ] |= (uint64_t)1 << ( led_number & 63 );
+
+    if( group_index < LEDOWNERINDEX_COLOUR_GROUPS ) {
+      m_owners[ led_number ] |= (uint32_t)1 << group_index;
+    }
+  }
+};
+
+int LEDOwnerIndex::GroupIndex( const int colour, const int group ) {
+  return colour * LEDLAYOUT_GROUPS + group;
+};
+
+uint32_t LEDOwnerIndex::GetOwners( const int led_number ) {
+  if( led_number < 1 || led_number > m_led_amount ) {
+    return 0;
+  }
+
+  return m_owners[ led_number ];
+};
+
+bool LEDOwnerIndex::IsInGroup( const int group_index, const int led_number ) {
+  if( group_index < 0 || group_index >= LEDOWNERINDEX_GROUPS || led_number < 1 || led_number > m_led_amount ) {
+    return false;
+  }
+
+  return ( m_bits[ (size_t)group_index * m_words + ( led_number >> 6 ) ] >> ( led_number & 63 ) ) & 1;
+};
+
+const uint64_t* LEDOwnerIndex::GetBits( const int group_index ) {
+  return &m_bits[ (size_t)group_index * m_words ];
+};
+
+int LEDOwnerIndex::GetWords() {
+  return m_words;
+};
+
+int LEDOwnerIndex::GetAmountLEDS() {
+  return m_led_amount;
+};
+
+void LEDOwnerIndex::GetUnassigned( std::vector<int32_t>* ptr_leds ) {
+  for( int word_number = 0; word_number < m_words; word_number++ ) {
+    uint64_t assigned = 0;
+    for( int group_index = 0; group_index < LEDOWNERINDEX_COLOUR_GROUPS; group_index++ ) {
+      assigned |= m_bits[ (size_t)group_index * m_words + word_number ];
+    }
+
+    this->AppendLEDs( ~assigned, word_number, ptr_leds );
+  }
+};
+
+void LEDOwnerIndex::GetOverlaps( std::vector<int32_t>* ptr_leds ) {
+  for( int word_number = 0; word_number < m_words; word_number++ ) {
+    // Bits seen once, and bits seen again.
+    uint64_t once  = 0;
+    uint64_t twice = 0;
+    for( int group_index = 0; group_index < LEDOWNERINDEX_COLOUR_GROUPS; group_index++ ) {
+      const uint64_t bits = m_bits[ (size_t)group_index * m_words + word_number ];
+      twice |= once & bits;
+      once  |= bits;
+    }
+
+    this->AppendLEDs( twice, word_number, ptr_leds );
+  }
+};
+
+uint32_t LEDOwnerIndex::CountOverlaps() {
+  uint32_t amount = 0;
+
+  for( int word_number = 0; word_number < m_words; word_number++ ) {
+    uint64_t once  = 0;
+    uint64_t twice = 0;
+    for( int group_index = 0; group_index < LEDOWNERINDEX_COLOUR_GROUPS; group_index++ ) {
+      const uint64_t bits = m_bits[ (size_t)group_index * m_words + word_number ];
+      twice |= once & bits;
+      once  |= bits;
+    }
+
+    amount += __builtin_popcountll( twice );
+  }
+
+  return amount;
+};
+
+// Adds the LED numbers for the set bits, skipping bit 0 & anything past the last LED.
+void LEDOwnerIndex::AppendLEDs( uint64_t word, const int word_number, std::vector<int32_t>* ptr_leds ) {
+  if( word_number == 0 ) {
+    word &= ~(uint64_t)1;
+  }
+
+  while( word != 0 ) {
+    const int led_number = word_number * 64 + __builtin_ctzll( word );
+    if( led_number > m_led_amount ) {
+      break;
+    }
+    ptr_leds->push_back( led_number );
+    word &= word - 1;
+  }
+};
@@ -0,0 +1,61 @@
+#ifndef _LEDOWNERINDEX_H_
+#define _LEDOWNERINDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "leds/LEDLayout.h"
+
+// Colour groups are numbered colour * LEDLAYOUT_GROUPS + group, the strobe comes after them.
+#define LEDOWNERINDEX_COLOUR_GROUPS ( LEDLAYOUT_COLOURS * LEDLAYOUT_GROUPS )
+#define LEDOWNERINDEX_STROBE        LEDOWNERINDEX_COLOUR_GROUPS
+#define LEDOWNERINDEX_GROUPS        ( LEDOWNERINDEX_COLOUR_GROUPS + 1 )
+
+static_assert( LEDOWNERINDEX_COLOUR_GROUPS <= 32, "Owner table holds one bit per colour group." );
+
+// Which groups each LED belongs to.  A bitset over the LEDs per group, plus a table of owner bits per LED,
+// so set queries work a word at a time rather than searching group lists.
+class LEDOwnerIndex {
+public:
+  LEDOwnerIndex();
+
+  ~LEDOwnerIndex();
+
+  // Empties the index, sized for LEDs 1 to led_amount.
+  void Clear( const int led_amount );
+
+  // Adds LEDs to a group.  Numbers outside 1 to led_amount are ignored.
+  void Add( const int group_index, const int32_t* leds, const uint32_t amount );
+
+  static int GroupIndex( const int colour, const int group );
+
+  // Colour group bits for the LED, bit n = group index n.
+  uint32_t GetOwners( const int led_number );
+
+  bool IsInGroup( const int group_index, const int led_number );
+
+  // Bitset for a group, GetWords() long.  Bit n = LED n.
+  const uint64_t* GetBits( const int group_index );
+
+  int GetWords();
+
+  int GetAmountLEDS();
+
+  // LEDs in none of the colour groups, in order.
+  void GetUnassigned( std::vector<int32_t>* ptr_leds );
+
+  // LEDs in more than one colour group, in order.
+  void GetOverlaps( std::vector<int32_t>* ptr_leds );
+
+  uint32_t CountOverlaps();
+
+private:
+  void AppendLEDs( uint64_t word, const int word_number, std::vector<int32_t>* ptr_leds );
+
+  int                    m_led_amount;
+  int                    m_words;
+  std::vector<uint64_t>  m_bits;    // LEDOWNERINDEX_GROUPS bitsets of m_words.
+  std::vector<uint32_t>  m_owners;  // Indexed by LED number.
+};
+
+#endif
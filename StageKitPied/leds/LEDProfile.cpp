@@ -0,0 +1,121 @@
+#include "LEDProfile.h"
+
+LEDProfile::LEDProfile( const int profile_id ) {
+  m_id = profile_id;
+};
+
+LEDProfile::~LEDProfile() {
+  this->ClearGroups();
+};
+
+bool LEDProfile::Load( const std::string& ini_file, const int led_amount ) {
+  // The groups view the layout's LED list, so let go of them first.
+  this->ClearGroups();
+
+  m_file = ini_file;
+
+  const std::string layout_file = ini_file + LEDLAYOUT_EXTENSION;
+
+  if( m_layout.Map( layout_file, ini_file, led_amount ) ) {
+    MSG_LEDPROFILE_INFO( "Profile " << m_id << " loaded from compiled layout." );
+  } else {
+    if( !m_layout.Compile( ini_file, led_amount ) ) {
+      return false;
+    }
+    MSG_LEDPROFILE_INFO( "Profile " << m_id << " loaded from INI." );
+
+    // Next start can skip the ini.
+    if( m_layout.Save( layout_file ) ) {
+      MSG_LEDPROFILE_DEBUG( "Compiled layout saved to " << layout_file );
+    }
+  }
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      this->SetGroup( &m_groups[ colour ][ group ], m_layout.GetGroup( colour, group ) );
+    }
+  }
+
+  this->SetGroup( &m_strobe, m_layout.GetStrobe() );
+
+  this->BuildOwnerIndex( led_amount );
+
+  m_colour_correction.Set( m_layout.GetGamma(), m_layout.GetColourMatrix() );
+
+  m_spatial_index.Build( m_layout.GetPositions(), led_amount );
+
+  return true;
+};
+
+int LEDProfile::GetID() {
+  return m_id;
+};
+
+const std::string& LEDProfile::GetFile() {
+  return m_file;
+};
+
+LEDGroup* LEDProfile::GetGroups( const int colour ) {
+  return m_groups[ colour ];
+};
+
+LEDGroup* LEDProfile::GetStrobe() {
+  return &m_strobe;
+};
+
+int LEDProfile::GetBlendMode() {
+  return m_layout.GetBlendMode();
+};
+
+LEDOwnerIndex* LEDProfile::GetOwnerIndex() {
+  return &m_owner_index;
+};
+
+ColourCorrection* LEDProfile::GetColourCorrection() {
+  return &m_colour_correction;
+};
+
+LEDSpatialIndex* LEDProfile::GetSpatialIndex() {
+  return &m_spatial_index;
+};
+
+const LEDLayoutSweep& LEDProfile::GetSweep() {
+  return m_layout.GetSweep();
+};
+
+void LEDProfile::BuildOwnerIndex( const int led_amount ) {
+  m_owner_index.Clear( led_amount );
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      const LEDLayoutSpan& span = m_layout.GetGroup( colour, group );
+      m_owner_index.Add( LEDOwnerIndex::GroupIndex( colour, group ), m_layout.GetLEDs() + span.m_offset, span.m_amount );
+    }
+  }
+
+  const LEDLayoutSpan& strobe = m_layout.GetStrobe();
+  m_owner_index.Add( LEDOWNERINDEX_STROBE, m_layout.GetLEDs() + strobe.m_offset, strobe.m_amount );
+
+  const uint32_t overlaps = m_owner_index.CountOverlaps();
+  if( overlaps > 0 ) {
+    static const char* blend_modes[] = { "REPLACE", "ADD", "MAX" };
+    MSG_LEDPROFILE_INFO( "Profile " << m_id << " has " << overlaps << " LEDs in more than one colour group, blended with " << blend_modes[ this->GetBlendMode() ] << "." );
+  }
+};
+
+void LEDProfile::SetGroup( LEDGroup* ptr_led_group, const LEDLayoutSpan& span ) {
+  ptr_led_group->SetLEDs( m_layout.GetLEDs() + span.m_offset, span.m_amount );
+  ptr_led_group->SetRGB( span.m_red, span.m_green, span.m_blue );
+  ptr_led_group->SetBrightness( span.m_brightness );
+};
+
+void LEDProfile::ClearGroups() {
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      m_groups[ colour ][ group ].SetLEDs( NULL, 0 );
+    }
+  }
+  m_strobe.SetLEDs( NULL, 0 );
+
+  m_layout.Close();
+};
@@ -0,0 +1,78 @@
+#ifndef _LEDPROFILE_H_
+#define _LEDPROFILE_H_
+
+#define MSG_LEDPROFILE_DEBUG( str ) LOG_DEBUG( "LEDProfile", str )
+
+#define MSG_LEDPROFILE_ERROR( str ) LOG_ERROR( "LEDProfile", str )
+#define MSG_LEDPROFILE_INFO( str ) LOG_INFO( "LEDProfile", str )
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "helpers/Log.h"
+#include "leds/ColourCorrection.h"
+#include "leds/LEDGroup.h"
+#include "leds/LEDLayout.h"
+#include "leds/LEDOwnerIndex.h"
+#include "leds/LEDSpatialIndex.h"
+
+// One leds ini, loaded & ready to render.  The groups view the layout's LED list.
+class LEDProfile {
+public:
+  LEDProfile( const int profile_id );
+
+  ~LEDProfile();
+
+  LEDProfile( const LEDProfile& ) = delete;
+  LEDProfile& operator=( const LEDProfile& ) = delete;
+
+  // Maps the compiled layout for the ini, compiling & saving it first if it's missing or stale.
+  bool Load( const std::string& ini_file, const int led_amount );
+
+  int GetID();
+
+  const std::string& GetFile();
+
+  // The 8 groups for one of the LEDLAYOUT_ colours.
+  LEDGroup* GetGroups( const int colour );
+
+  LEDGroup* GetStrobe();
+
+  // LEDLAYOUT_BLEND_ mode for overlapping groups.
+  int GetBlendMode();
+
+  // Which groups each LED is in.
+  LEDOwnerIndex* GetOwnerIndex();
+
+  // Gamma & white balance for the finished frame.
+  ColourCorrection* GetColourCorrection();
+
+  // Where the LEDs are, for effects that work by area.  Empty if the ini has no POSITION sections.
+  LEDSpatialIndex* GetSpatialIndex();
+
+  // The [SWEEP] band, drawn through the spatial index each frame.  m_time_ms is 0 without one.
+  const LEDLayoutSweep& GetSweep();
+
+private:
+  void SetGroup( LEDGroup* ptr_led_group, const LEDLayoutSpan& span );
+
+  void ClearGroups();
+
+  void BuildOwnerIndex( const int led_amount );
+
+  int         m_id;
+  std::string m_file;
+
+  LEDGroup  m_groups[ LEDLAYOUT_COLOURS ][ LEDLAYOUT_GROUPS ];
+  LEDGroup  m_strobe;
+
+  LEDLayout m_layout;
+
+  LEDOwnerIndex m_owner_index;
+
+  ColourCorrection m_colour_correction;
+  LEDSpatialIndex m_spatial_index;
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include "LEDRemap.h"
+
+LEDRemap::LEDRemap() {
+  m_led_amount = 0;
+};
+
+LEDRemap::~LEDRemap() {
+};
+
+bool LEDRemap::Set( std::string_view text, const int led_amount ) {
+  this->Clear();
+
+  if( text.empty() || led_amount <= 0 ) {
+    return true;
+  }
+
+  m_led_amount = led_amount;
+
+  while( !text.empty() ) {
+    const size_t comma = text.find( ',' );
+
+    if( !this->AddItem( text.substr( 0, comma ), led_amount ) ) {
+      this->Clear();
+      return false;
+    }
+
+    if( comma == std::string_view::npos ) {
+      break;
+    }
+    text.remove_prefix( comma + 1 );
+  }
+
+  if( m_table.size() > m_led_amount ) {
+    MSG_LEDREMAP_ERROR( "REMAP lists " << m_table.size() << " LEDs, the strip only has " << m_led_amount << ".  The rest are ignored." );
+    m_table.resize( m_led_amount );
+  } else if( m_table.size() < m_led_amount ) {
+    MSG_LEDREMAP_INFO( "REMAP lists " << m_table.size() << " of the " << m_led_amount << " strip LEDs, the rest are left off." );
+    m_table.resize( m_led_amount, m_led_amount );
+  }
+
+  return true;
+};
+
+void LEDRemap::Clear() {
+  m_led_amount = 0;
+  m_table.clear();
+};
+
+bool LEDRemap::IsActive() {
+  return !m_table.empty();
+};
+
+void LEDRemap::Gather( const Pixel* ptr_frame, Pixel* ptr_out ) {
+  this->Gather( ptr_frame, ptr_out, 0, m_led_amount );
+};
+
+void LEDRemap::Gather16( const uint16_t* ptr_colour, uint16_t* ptr_out ) {
+  this->Gather16( ptr_colour, ptr_out, 0, m_led_amount );
+};
+
+void LEDRemap::Gather( const Pixel* ptr_frame, Pixel* ptr_out, const uint32_t first, const uint32_t amount ) {
+  const uint32_t  led_amount = m_led_amount;
+  const uint32_t* table      = m_table.data();
+  const uint32_t  last       = first + amount;
+
+  for( uint32_t led = first; led < last; led++ ) {
+    const uint32_t index = table[ led ];
+    ptr_out[ led ] = index < led_amount ? ptr_frame[ index ] : 0;
+  }
+};
+
+void LEDRemap::Gather16( const uint16_t* ptr_colour, uint16_t* ptr_out, const uint32_t first, const uint32_t amount ) {
+  const uint32_t  led_amount = m_led_amount;
+  const uint32_t* table      = m_table.data();
+  const uint32_t  last       = first + amount;
+
+  ptr_out += first * 3;
+
+  for( uint32_t led = first; led < last; led++, ptr_out += 3 ) {
+    const uint32_t index = table[ led ];
+    if( index < led_amount ) {
+      const uint16_t* ptr_in = ptr_colour + index * 3;
+      ptr_out[ 0 ] = ptr_in[ 0 ];
+      ptr_out[ 1 ] = ptr_in[ 1 ];
+      ptr_out[ 2 ] = ptr_in[ 2 ];
+    } else {
+      ptr_out[ 0 ] = 0;
+      ptr_out[ 1 ] = 0;
+      ptr_out[ 2 ] = 0;
+    }
+  }
+};
+
+bool LEDRemap::IsChanged( const uint8_t* ptr_changed, const uint32_t block_leds, const uint32_t first, const uint32_t amount ) {
+  const uint32_t  led_amount = m_led_amount;
+  const uint32_t* table      = m_table.data();
+  const uint32_t  last       = first + amount;
+
+  for( uint32_t led = first; led < last; led++ ) {
+    const uint32_t index = table[ led ];
+    if( index < led_amount && ptr_changed[ index / block_leds ] ) {
+      return true;
+    }
+  }
+
+  return false;
+};
+
+bool LEDRemap::AddItem( std::string_view item, const int led_amount ) {
+  const size_t start = item.find_first_not_of( ' ' );
+  item = start == std::string_view::npos ? std::string_view() : item.substr( start, item.find_last_not_of( ' ' ) + 1 - start );
+
+  if( item.substr( 0, 3 ) == "GAP" ) {
+    int gap = 1;
+    if( item.size() > 3 && ( !ParseNumber( item.substr( 3 ), &gap ) || gap < 1 || gap > led_amount ) ) {
+      MSG_LEDREMAP_ERROR( "Bad REMAP gap '" << item << "'" );
+      return false;
+    }
+    m_table.insert( m_table.end(), gap, m_led_amount );
+    return true;
+  }
+
+  // a, a-b or a-b/n.  The dash is looked for after the first digit, in case of a stray minus.
+  int first = 0;
+  int last  = 0;
+  int row_length = 0;
+
+  const size_t dash  = item.find( '-', 1 );
+  const size_t slash = item.find( '/' );
+
+  bool is_good = ParseNumber( item.substr( 0, dash ), &first );
+  if( is_good && dash != std::string_view::npos ) {
+    is_good = ParseNumber( item.substr( dash + 1, slash == std::string_view::npos ? slash : slash - dash - 1 ), &last );
+    if( is_good && slash != std::string_view::npos ) {
+      is_good = ParseNumber( item.substr( slash + 1 ), &row_length ) && row_length > 0;
+    }
+  } else {
+    last = first;
+    is_good = is_good && slash == std::string_view::npos;
+  }
+
+  if( !is_good ) {
+    MSG_LEDREMAP_ERROR( "Bad REMAP item '" << item << "'" );
+    return false;
+  }
+
+  if( first < 1 || first > led_amount || last < 1 || last > led_amount ) {
+    MSG_LEDREMAP_ERROR( "REMAP item '" << item << "' is outside LEDs 1 - " << led_amount << "." );
+    return false;
+  }
+
+  this->AddRange( first, last, row_length );
+
+  return true;
+};
+
+void LEDRemap::AddRange( const int first, const int last, const int row_length ) {
+  const size_t range_start = m_table.size();
+  const int    step        = first <= last ? 1 : -1;
+
+  for( int led_number = first; ; led_number += step ) {
+    m_table.push_back( led_number - 1 );
+    if( led_number == last ) {
+      break;
+    }
+  }
+
+  // Serpentine, every second row runs back the other way.
+  if( row_length > 0 ) {
+    for( size_t row_start = range_start + row_length; row_start < m_table.size(); row_start += row_length * 2 ) {
+      const size_t row_end = std::min( row_start + row_length, m_table.size() );
+      std::reverse( m_table.begin() + row_start, m_table.begin() + row_end );
+    }
+  }
+};
+
+bool LEDRemap::ParseNumber( std::string_view text, int* ptr_number ) {
+  std::from_chars_result result = std::from_chars( text.data(), text.data() + text.size(), *ptr_number );
+  return result.ec == std::errc() && result.ptr == text.data() + text.size();
+};
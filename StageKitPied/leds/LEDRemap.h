@@ -0,0 +1,69 @@
+#ifndef _LEDREMAP_H_
+#define _LEDREMAP_H_
+
+#define MSG_LEDREMAP_DEBUG( str ) LOG_DEBUG( "LEDRemap", str )
+
+#define MSG_LEDREMAP_ERROR( str ) LOG_ERROR( "LEDRemap", str )
+#define MSG_LEDREMAP_INFO( str ) LOG_INFO( "LEDRemap", str )
+
+#include <algorithm>  // min, reverse
+#include <charconv>  // from_chars
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "helpers/Log.h"
+#include "leds/PixelKernels.h"
+
+// Where each LED on the strip takes its colour from, so leds inis can number LEDs in the order they're seen
+// rather than the order they're wired.  The frame is rendered in that logical order & gathered into wiring
+// order in one pass as it's sent, reading a table of logical indexes that walks the strip front to back.
+//
+// The list runs along the strip, e.g. "1-30,60-31,GAP2,61-90" :
+//   a-b    logical LEDs a to b, counting down if b is lower, so a reversed segment is just "30-1".
+//   a-b/n  a serpentine, a to b in rows of n with every second row reversed.
+//   GAPn   n strip LEDs left off, such as where a strip turns a corner.  GAP on its own is one.
+// Strip LEDs after the end of the list are left off.
+class LEDRemap {
+public:
+  LEDRemap();
+
+  ~LEDRemap();
+
+  // Builds the table for a strip of led_amount LEDs.  An empty list is no remap.
+  // Returns false & leaves no remap if the list is bad.
+  bool Set( std::string_view text, const int led_amount );
+
+  void Clear();
+
+  // False when LEDs are sent in the order they're rendered.
+  bool IsActive();
+
+  // ptr_out[ strip LED ] = ptr_frame[ logical LED ], off for gaps.  Both are led_amount long & mustn't overlap.
+  void Gather( const Pixel* ptr_frame, Pixel* ptr_out );
+
+  // As Gather, for red, green & blue per LED.
+  void Gather16( const uint16_t* ptr_colour, uint16_t* ptr_out );
+
+  // Gathers strip LEDs first + 1 to first + amount only, so separate ranges can be gathered on separate threads.
+  void Gather( const Pixel* ptr_frame, Pixel* ptr_out, const uint32_t first, const uint32_t amount );
+
+  void Gather16( const uint16_t* ptr_colour, uint16_t* ptr_out, const uint32_t first, const uint32_t amount );
+
+  // True if any of strip LEDs first + 1 to first + amount takes its colour from a changed block of logical LEDs,
+  // ptr_changed being non zero for each changed block of block_leds.
+  bool IsChanged( const uint8_t* ptr_changed, const uint32_t block_leds, const uint32_t first, const uint32_t amount );
+
+private:
+  bool AddItem( std::string_view item, const int led_amount );
+
+  void AddRange( const int first, const int last, const int row_length );
+
+  static bool ParseNumber( std::string_view text, int* ptr_number );
+
+  uint32_t              m_led_amount;
+  std::vector<uint32_t> m_table;  // Logical index for each strip LED, m_led_amount for a gap.
+};
+
+#endif
@@ -0,0 +1,208 @@
+#include "LEDSpatialIndex.h"
+
+LEDSpatialIndex::LEDSpatialIndex() {
+  this->Clear();
+};
+
+LEDSpatialIndex::~LEDSpatialIndex() {
+};
+
+void LEDSpatialIndex::Clear() {
+  m_led_amount = 0;
+  m_positions.clear();
+  m_cell_start.clear();
+  m_cell_leds.clear();
+
+  for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+    m_sorted[ axis ].clear();
+    m_keys[ axis ].clear();
+    m_min[ axis ]        = 0;
+    m_cell_scale[ axis ] = 0;
+    m_cells[ axis ]      = 1;
+  }
+};
+
+void LEDSpatialIndex::Build( const LEDLayoutPosition* positions, const int led_amount ) {
+  this->Clear();
+
+  if( positions == NULL || led_amount <= 0 ) {
+    return;
+  }
+
+  m_led_amount = led_amount;
+  m_positions.assign( positions, positions + led_amount );
+
+  std::vector<int32_t> placed;
+  for( int led = 0; led < led_amount; led++ ) {
+    if( !std::isnan( positions[ led ].m_axis[ LEDLAYOUT_AXIS_X ] ) ) {
+      placed.push_back( led + 1 );
+    }
+  }
+
+  if( placed.empty() ) {
+    return;
+  }
+
+  // Sorted projections.
+  int used_axes = 0;
+  float extent[ LEDLAYOUT_AXES ];
+
+  for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+    std::vector<int32_t>& sorted = m_sorted[ axis ];
+    sorted = placed;
+    std::sort( sorted.begin(), sorted.end(), [ & ]( const int32_t a, const int32_t b ) {
+      return positions[ a - 1 ].m_axis[ axis ] < positions[ b - 1 ].m_axis[ axis ];
+    } );
+
+    m_keys[ axis ].resize( sorted.size() );
+    for( size_t i = 0; i < sorted.size(); i++ ) {
+      m_keys[ axis ][ i ] = positions[ sorted[ i ] - 1 ].m_axis[ axis ];
+    }
+
+    m_min[ axis ] = m_keys[ axis ].front();
+    extent[ axis ] = m_keys[ axis ].back() - m_min[ axis ];
+    used_axes += extent[ axis ] > 0 ? 1 : 0;
+  }
+
+  // Grid.  Flat & straight layouts only split the axes they spread along.
+  const double cells_wanted = std::max<double>( 1.0, (double)placed.size() / LEDSPATIALINDEX_CELL_LEDS );
+  const int    axis_cells   = used_axes > 0 ? std::max( 1, (int)std::pow( cells_wanted, 1.0 / used_axes ) ) : 1;
+  uint32_t     cell_amount  = 1;
+
+  for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+    m_cells[ axis ]      = extent[ axis ] > 0 ? axis_cells : 1;
+    m_cell_scale[ axis ] = extent[ axis ] > 0 ? m_cells[ axis ] / extent[ axis ] : 0;
+    cell_amount *= m_cells[ axis ];
+  }
+
+  // Counted into place, so each cell's LEDs are together & in LED order.
+  std::vector<uint32_t> led_cell( placed.size() );
+  m_cell_start.assign( cell_amount + 1, 0 );
+
+  for( size_t i = 0; i < placed.size(); i++ ) {
+    const LEDLayoutPosition& position = positions[ placed[ i ] - 1 ];
+    led_cell[ i ] = ( this->Cell( LEDLAYOUT_AXIS_Z, position.m_axis[ LEDLAYOUT_AXIS_Z ] ) * m_cells[ LEDLAYOUT_AXIS_Y ]
+                    + this->Cell( LEDLAYOUT_AXIS_Y, position.m_axis[ LEDLAYOUT_AXIS_Y ] ) ) * m_cells[ LEDLAYOUT_AXIS_X ]
+                    + this->Cell( LEDLAYOUT_AXIS_X, position.m_axis[ LEDLAYOUT_AXIS_X ] );
+    m_cell_start[ led_cell[ i ] + 1 ]++;
+  }
+
+  for( uint32_t cell = 0; cell < cell_amount; cell++ ) {
+    m_cell_start[ cell + 1 ] += m_cell_start[ cell ];
+  }
+
+  std::vector<uint32_t> cell_fill( m_cell_start.begin(), m_cell_start.end() - 1 );
+  m_cell_leds.resize( placed.size() );
+
+  for( size_t i = 0; i < placed.size(); i++ ) {
+    m_cell_leds[ cell_fill[ led_cell[ i ] ]++ ] = placed[ i ];
+  }
+};
+
+bool LEDSpatialIndex::IsEmpty() {
+  return m_cell_leds.empty();
+};
+
+int LEDSpatialIndex::GetAmountLEDS() {
+  return m_cell_leds.size();
+};
+
+float LEDSpatialIndex::GetLow( const int axis ) {
+  return m_keys[ axis ].empty() ? 0 : m_keys[ axis ].front();
+};
+
+float LEDSpatialIndex::GetHigh( const int axis ) {
+  return m_keys[ axis ].empty() ? 0 : m_keys[ axis ].back();
+};
+
+const LEDLayoutPosition* LEDSpatialIndex::GetPosition( const int led_number ) {
+  if( led_number < 1 || led_number > m_led_amount || std::isnan( m_positions[ led_number - 1 ].m_axis[ LEDLAYOUT_AXIS_X ] ) ) {
+    return NULL;
+  }
+
+  return &m_positions[ led_number - 1 ];
+};
+
+uint32_t LEDSpatialIndex::Band( const int axis, const float low, const float high, const int32_t** ptr_leds ) {
+  const std::vector<float>& keys = m_keys[ axis ];
+
+  const size_t first = std::lower_bound( keys.begin(), keys.end(), low ) - keys.begin();
+  const size_t last  = std::upper_bound( keys.begin() + first, keys.end(), high ) - keys.begin();
+
+  *ptr_leds = m_sorted[ axis ].data() + first;
+
+  return last > first ? last - first : 0;
+};
+
+void LEDSpatialIndex::Box( const float low[ LEDLAYOUT_AXES ], const float high[ LEDLAYOUT_AXES ], std::vector<int32_t>* ptr_leds ) {
+  const int32_t* leds = NULL;
+  uint32_t amount = UINT32_MAX;
+  int band_axis = 0;
+
+  for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+    const int32_t* axis_leds;
+    const uint32_t axis_amount = this->Band( axis, low[ axis ], high[ axis ], &axis_leds );
+    if( axis_amount < amount ) {
+      leds      = axis_leds;
+      amount    = axis_amount;
+      band_axis = axis;
+    }
+  }
+
+  for( uint32_t i = 0; i < amount; i++ ) {
+    const LEDLayoutPosition& position = m_positions[ leds[ i ] - 1 ];
+    bool is_inside = true;
+    for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+      is_inside = is_inside && ( axis == band_axis || ( position.m_axis[ axis ] >= low[ axis ] && position.m_axis[ axis ] <= high[ axis ] ) );
+    }
+    if( is_inside ) {
+      ptr_leds->push_back( leds[ i ] );
+    }
+  }
+};
+
+void LEDSpatialIndex::Sphere( const float centre[ LEDLAYOUT_AXES ], const float radius, std::vector<int32_t>* ptr_leds ) {
+  if( this->IsEmpty() || radius < 0 ) {
+    return;
+  }
+
+  int cell_low[ LEDLAYOUT_AXES ];
+  int cell_high[ LEDLAYOUT_AXES ];
+  for( int axis = 0; axis < LEDLAYOUT_AXES; axis++ ) {
+    cell_low[ axis ]  = this->Cell( axis, centre[ axis ] - radius );
+    cell_high[ axis ] = this->Cell( axis, centre[ axis ] + radius );
+  }
+
+  const float radius_squared = radius * radius;
+
+  for( int z = cell_low[ LEDLAYOUT_AXIS_Z ]; z <= cell_high[ LEDLAYOUT_AXIS_Z ]; z++ ) {
+    for( int y = cell_low[ LEDLAYOUT_AXIS_Y ]; y <= cell_high[ LEDLAYOUT_AXIS_Y ]; y++ ) {
+      const uint32_t row = ( z * m_cells[ LEDLAYOUT_AXIS_Y ] + y ) * m_cells[ LEDLAYOUT_AXIS_X ];
+
+      // Cells along a row are next to each other, so the row is one run of LEDs.
+      const uint32_t first = m_cell_start[ row + cell_low[ LEDLAYOUT_AXIS_X ] ];
+      const uint32_t last  = m_cell_start[ row + cell_high[ LEDLAYOUT_AXIS_X ] + 1 ];
+
+      for( uint32_t i = first; i < last; i++ ) {
+        const LEDLayoutPosition& position = m_positions[ m_cell_leds[ i ] - 1 ];
+        const float dx = position.m_axis[ LEDLAYOUT_AXIS_X ] - centre[ LEDLAYOUT_AXIS_X ];
+        const float dy = position.m_axis[ LEDLAYOUT_AXIS_Y ] - centre[ LEDLAYOUT_AXIS_Y ];
+        const float dz = position.m_axis[ LEDLAYOUT_AXIS_Z ] - centre[ LEDLAYOUT_AXIS_Z ];
+        if( dx * dx + dy * dy + dz * dz <= radius_squared ) {
+          ptr_leds->push_back( m_cell_leds[ i ] );
+        }
+      }
+    }
+  }
+};
+
+// Cell along one axis, clamped to the grid so areas past the edge still find the edge cells.
+int LEDSpatialIndex::Cell( const int axis, const float value ) {
+  const float cell = ( value - m_min[ axis ] ) * m_cell_scale[ axis ];
+
+  if( !( cell > 0 ) ) {
+    return 0;
+  }
+
+  return (int)std::min( cell, (float)( m_cells[ axis ] - 1 ) );
+};
@@ -0,0 +1,66 @@
+#ifndef _LEDSPATIALINDEX_H_
+#define _LEDSPATIALINDEX_H_
+
+#define LEDSPATIALINDEX_CELL_LEDS 4  // Grid cells are sized for about this many LEDs each.
+
+#include <algorithm>  // clamp, lower_bound, min, sort, upper_bound
+#include <cmath>      // isnan, pow
+#include <cstdint>
+#include <vector>
+
+#include "leds/LEDLayout.h"
+
+// Where the LEDs are, indexed so an effect can find the LEDs in an area without looking at every LED.
+// Each axis keeps the LEDs sorted by that coordinate, so a band across the stage is one contiguous run found
+// by binary search.  A uniform grid over the LEDs buckets them for round areas, such as a pulse from the drum riser.
+class LEDSpatialIndex {
+public:
+  LEDSpatialIndex();
+
+  ~LEDSpatialIndex();
+
+  // Indexes LEDs 1 to led_amount, positions[ 0 ] being LED 1.  LEDs without a position are left out.
+  void Build( const LEDLayoutPosition* positions, const int led_amount );
+
+  void Clear();
+
+  bool IsEmpty();
+
+  // LEDs with a position.
+  int GetAmountLEDS();
+
+  // Lowest & highest LEDLAYOUT_AXIS_ coordinate of any LED, 0 when empty.
+  float GetLow( const int axis );
+
+  float GetHigh( const int axis );
+
+  // NULL if the LED has no position.
+  const LEDLayoutPosition* GetPosition( const int led_number );
+
+  // LED numbers with the LEDLAYOUT_AXIS_ coordinate from low to high, in coordinate order.
+  // Points into the index, so it's only good until the next Build.  Returns how many.
+  uint32_t Band( const int axis, const float low, const float high, const int32_t** ptr_leds );
+
+  // Adds the LEDs inside the box to ptr_leds.  Walks the axis with the fewest LEDs in range.
+  void Box( const float low[ LEDLAYOUT_AXES ], const float high[ LEDLAYOUT_AXES ], std::vector<int32_t>* ptr_leds );
+
+  // Adds the LEDs within radius of the centre to ptr_leds, only looking in the grid cells it covers.
+  void Sphere( const float centre[ LEDLAYOUT_AXES ], const float radius, std::vector<int32_t>* ptr_leds );
+
+private:
+  int Cell( const int axis, const float value );
+
+  int                            m_led_amount;
+  std::vector<LEDLayoutPosition> m_positions;  // Index 0 is LED 1.
+
+  std::vector<int32_t> m_sorted[ LEDLAYOUT_AXES ];  // LED numbers in coordinate order.
+  std::vector<float>   m_keys[ LEDLAYOUT_AXES ];    // Their coordinates, apart so the search stays in cache.
+
+  float    m_min[ LEDLAYOUT_AXES ];
+  float    m_cell_scale[ LEDLAYOUT_AXES ];  // Cells per unit.
+  int      m_cells[ LEDLAYOUT_AXES ];
+  std::vector<uint32_t> m_cell_start;  // Into m_cell_leds for each cell, one extra at the end.
+  std::vector<int32_t>  m_cell_leds;
+};
+
+#endif
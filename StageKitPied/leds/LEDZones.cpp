@@ -0,0 +1,184 @@
+#include "LEDZones.h"
+
+LEDZones::LEDZones() {
+  for( int config_id = 0; config_id < LEDZONES_CONFIGS; config_id++ ) {
+    m_config_lights[ config_id ] = true;
+    m_config_strobe[ config_id ] = true;
+  }
+};
+
+LEDZones::~LEDZones() {
+  mWorkerPool.Stop();
+};
+
+void LEDZones::SetMain( LEDArray* ptr_leds ) {
+  LEDZone zone;
+  zone.m_name      = "LEDS";
+  zone.m_ptr_leds  = ptr_leds;
+  zone.m_config_id = 0;
+
+  if( !m_zones.empty() && m_zones[ 0 ].m_leds == NULL ) {
+    m_zones[ 0 ] = std::move( zone );
+  } else {
+    m_zones.insert( m_zones.begin(), std::move( zone ) );
+  }
+};
+
+bool LEDZones::Add( const std::string& name, const std::string& type, const std::string& device_name, const int led_amount,
+                    const std::string& ini_file, const std::string& remap, const int config_id ) {
+  MSG_LEDZONES_INFO( "Zone " << name << " : " << ini_file );
+
+  LEDZone zone;
+  zone.m_name      = name;
+  zone.m_leds.reset( new LEDArray() );
+  zone.m_ptr_leds  = zone.m_leds.get();
+  zone.m_config_id = config_id >= 0 && config_id < LEDZONES_CONFIGS ? config_id : 0;
+
+  LEDArray* ptr_leds = zone.m_ptr_leds;
+
+  if( !ptr_leds->Init( type, device_name, led_amount ) || !ptr_leds->SetEnabled( true ) ) {
+    MSG_LEDZONES_ERROR( "Zone " << name << " LED array start-up failed.  Check its DEVICE." );
+    return false;
+  }
+
+  if( !ptr_leds->LoadProfiles( { ini_file } ) || !ptr_leds->SelectProfile( 0 ) ) {
+    MSG_LEDZONES_ERROR( "Zone " << name << " failed to load " << ini_file );
+    return false;
+  }
+
+  if( !ptr_leds->SetRemap( remap ) ) {
+    MSG_LEDZONES_ERROR( "Zone " << name << " REMAP not used, LEDs are sent as numbered." );
+  }
+
+  m_zones.push_back( std::move( zone ) );
+
+  // A thread for each zone past the first, the caller draws one too.
+  const int threads = std::min<int>( m_zones.size(), std::max( 1u, std::thread::hardware_concurrency() ) ) - 1;
+  if( threads != mWorkerPool.GetAmountThreads() && !mWorkerPool.Start( threads ) ) {
+    MSG_LEDZONES_ERROR( "Only " << mWorkerPool.GetAmountThreads() << " worker threads started, zones will share them." );
+  }
+
+  return true;
+};
+
+int LEDZones::GetAmountZones() {
+  return m_zones.size();
+};
+
+void LEDZones::SetConfig( const int config_id, const bool lights_enabled, const bool strobe_enabled ) {
+  if( config_id <= 0 || config_id >= LEDZONES_CONFIGS ) {
+    return;
+  }
+
+  m_config_lights[ config_id ] = lights_enabled;
+  m_config_strobe[ config_id ] = strobe_enabled;
+
+  // Zones that have just lost their lights go dark rather than hold the last ones.
+  for( LEDZone& zone : m_zones ) {
+    if( zone.m_config_id == config_id ) {
+      if( !lights_enabled ) {
+        zone.m_ptr_leds->SetLights( SK_ALL_OFF, 0 );
+      }
+      if( !strobe_enabled ) {
+        zone.m_ptr_leds->Strobe( false );
+      }
+    }
+  }
+};
+
+void LEDZones::SetLights( const uint8_t colour, const uint8_t leds ) {
+  // Only sets what to draw, the frames are drawn by Flush.
+  for( LEDZone& zone : m_zones ) {
+    if( this->IsLit( zone ) ) {
+      zone.m_ptr_leds->SetLights( colour, leds );
+    }
+  }
+};
+
+void LEDZones::Strobe( const bool on ) {
+  this->ForEach( [ this, on ]( LEDZone& zone ) {
+    if( !on || this->IsStrobed( zone ) ) {
+      zone.m_ptr_leds->Strobe( on );
+    }
+  } );
+};
+
+bool LEDZones::Flush() {
+  if( m_zones.size() == 1 ) {
+    return m_zones[ 0 ].m_ptr_leds->Flush();
+  }
+
+  std::atomic<bool> is_drawn( false );
+
+  this->ForEach( [ &is_drawn ]( LEDZone& zone ) {
+    if( zone.m_ptr_leds->Flush() ) {
+      is_drawn = true;
+    }
+  } );
+
+  return is_drawn;
+};
+
+void LEDZones::SetAllLED( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
+  // Captured as one, small enough for std::function to hold without allocating.
+  const uint8_t colour[ 4 ] = { red, green, blue, brightness };
+
+  this->ForEach( [ &colour ]( LEDZone& zone ) {
+    zone.m_ptr_leds->SetAllLED( colour[ 0 ], colour[ 1 ], colour[ 2 ], colour[ 3 ] );
+  } );
+};
+
+void LEDZones::SetFade( const int frame_rate, const int fade_in_ms, const int fade_out_ms ) {
+  for( LEDZone& zone : m_zones ) {
+    zone.m_ptr_leds->SetFade( frame_rate, fade_in_ms, fade_out_ms );
+  }
+};
+
+void LEDZones::SetHighDepth( const bool enabled ) {
+  for( LEDZone& zone : m_zones ) {
+    zone.m_ptr_leds->SetHighDepth( enabled );
+  }
+};
+
+void LEDZones::SetRenderThreads( const int threads ) {
+  for( LEDZone& zone : m_zones ) {
+    zone.m_ptr_leds->SetRenderThreads( threads );
+  }
+};
+
+bool LEDZones::IsAnimating() {
+  for( LEDZone& zone : m_zones ) {
+    if( zone.m_ptr_leds->IsAnimating() ) {
+      return true;
+    }
+  }
+  return false;
+};
+
+int LEDZones::GetFrameIntervalMs() {
+  int interval_ms = 0;
+
+  for( LEDZone& zone : m_zones ) {
+    if( zone.m_ptr_leds->IsAnimating() && ( interval_ms == 0 || zone.m_ptr_leds->GetFrameIntervalMs() < interval_ms ) ) {
+      interval_ms = zone.m_ptr_leds->GetFrameIntervalMs();
+    }
+  }
+
+  return interval_ms;
+};
+
+bool LEDZones::IsLit( const LEDZone& zone ) {
+  return m_config_lights[ zone.m_config_id ];
+};
+
+bool LEDZones::IsStrobed( const LEDZone& zone ) {
+  return m_config_strobe[ zone.m_config_id ];
+};
+
+void LEDZones::ForEach( const std::function<void( LEDZone& )>& job ) {
+  ALLOC_SCOPE( "zones" );
+
+  mWorkerPool.Run( m_zones.size(), [ this, &job ]( const int zone_index ) {
+    job( m_zones[ zone_index ] );
+  } );
+};
@@ -0,0 +1,94 @@
+#ifndef _LEDZONES_H_
+#define _LEDZONES_H_
+
+#define MSG_LEDZONES_DEBUG( str ) LOG_DEBUG( "LEDZones", str )
+
+#define MSG_LEDZONES_ERROR( str ) LOG_ERROR( "LEDZones", str )
+#define MSG_LEDZONES_INFO( str ) LOG_INFO( "LEDZones", str )
+
+#define LEDZONES_CONFIGS 5  // Stage kit configs, 0 follows everything.
+
+#include <algorithm>  // min, max
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers/AllocTracker.h"
+#include "helpers/Log.h"
+#include "helpers/WorkerPool.h"
+#include "leds/LEDArray.h"
+#include "stagekit/StageKitConsts.h"
+
+// One LED array of the installation, such as the truss, backdrop or floor.
+struct LEDZone
+{
+  std::string               m_name;
+  LEDArray*                 m_ptr_leds;
+  std::unique_ptr<LEDArray> m_leds;       // NULL for the main array, which isn't owned.
+  int                       m_config_id;  // Stage kit config it follows, like a pod.  0 for all of them.
+};
+
+// Every LED array being driven, each with its own device & leds ini.  Light changes go to all of them, & frames
+// are drawn on a worker pool, so the slowest zone sets the frame time rather than all of them added up.
+// A zone given a stage kit config only shows the lights & strobe when that config has them enabled.
+class LEDZones {
+public:
+  LEDZones();
+
+  ~LEDZones();
+
+  // The [LEDS] array, zone 0.  It follows every config & keeps its profile switching.
+  void SetMain( LEDArray* ptr_leds );
+
+  // Opens another LED array with a single leds ini.  config_id 1 - 4 or 0 for all.
+  bool Add( const std::string& name, const std::string& type, const std::string& device_name, const int led_amount,
+            const std::string& ini_file, const std::string& remap, const int config_id );
+
+  int GetAmountZones();
+
+  // From a STAGEKIT_CONFIG_ section.  A config without one shows everything.
+  void SetConfig( const int config_id, const bool lights_enabled, const bool strobe_enabled );
+
+  void SetLights( const uint8_t colour, const uint8_t leds );
+
+  void Strobe( const bool on );
+
+  // Draws every zone that has anything to draw, at the same time.  Returns true if any did.
+  bool Flush();
+
+  void SetAllLED( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness );
+
+  void SetFade( const int frame_rate, const int fade_in_ms, const int fade_out_ms );
+
+  void SetHighDepth( const bool enabled );
+
+  // Each zone's own, see LEDArray::SetRenderThreads.
+  void SetRenderThreads( const int threads );
+
+  bool IsAnimating();
+
+  // Shortest of the animating zones.
+  int GetFrameIntervalMs();
+
+private:
+  bool IsLit( const LEDZone& zone );
+
+  bool IsStrobed( const LEDZone& zone );
+
+  // Calls job for every zone, spread over the pool.
+  void ForEach( const std::function<void( LEDZone& )>& job );
+
+  std::vector<LEDZone> m_zones;
+
+  WorkerPool mWorkerPool;
+
+  bool m_config_lights[ LEDZONES_CONFIGS ];
+  bool m_config_strobe[ LEDZONES_CONFIGS ];
+};
+
+#endif
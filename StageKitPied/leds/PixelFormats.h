@@ -0,0 +1,157 @@
+#ifndef _PIXELFORMATS_H_
+#define _PIXELFORMATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // memcpy
+
+#include "leds/LEDOutput.h"
+#include "leds/PixelKernels.h"
+
+// How clocked SPI LEDs want each pixel.  Each format is a set of static kernels picked at compile time by
+// SPIPixelOutput, so the per pixel code has no branches on the protocol or colour order.
+
+static_assert( __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Pixel formats build their words little endian." );
+
+// Order the colours go out in.
+#define PIXEL_ORDER_RGB 0
+#define PIXEL_ORDER_RBG 1
+#define PIXEL_ORDER_GRB 2
+#define PIXEL_ORDER_GBR 3
+#define PIXEL_ORDER_BRG 4
+#define PIXEL_ORDER_BGR 5
+#define PIXEL_ORDERS    6
+
+static constexpr const char* PIXEL_ORDER_NAMES[ PIXEL_ORDERS ] = { "RGB", "RBG", "GRB", "GBR", "BRG", "BGR" };
+
+// Colour sent at a position for an order, 0 red, 1 green, 2 blue.
+constexpr int PixelOrderChannel( const int order, const int position ) {
+  constexpr int channels[ PIXEL_ORDERS ][ 3 ] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+  return channels[ order ][ position ];
+};
+
+// Where a colour sits in a Pixel.
+constexpr int PixelChannelShift( const int channel ) {
+  return channel == 0 ? 24 : ( channel == 1 ? 16 : 8 );
+};
+
+// SK9822 & APA102 : 0xE0 | 5 bit brightness, then 8 bit colours.  They differ only in the end frame.
+template< int ORDER, uint8_t END_BYTE >
+struct PixelFormatBrightness8
+{
+  static constexpr int      FORMAT   = LEDOUTPUT_FORMAT_BRIGHTNESS_8;
+  static constexpr size_t   BYTES    = 4;
+  static constexpr bool     DEPTH16  = false;
+  static constexpr uint32_t SPEED_HZ = 4000000;  // 4Mhz
+  static constexpr uint8_t  END_FILL = END_BYTE;
+
+  static size_t StartBytes( const int number_leds ) {
+    return 4;
+  };
+
+  // The data is pushed along by the clock, half a bit per LED, plus a spare word.
+  static size_t EndBytes( const int number_leds ) {
+    return 4 * ( 2 + ( ( number_leds / 2 ) / 32 ) );
+  };
+
+  static constexpr int SHIFT_0 = PixelChannelShift( PixelOrderChannel( ORDER, 0 ) );
+  static constexpr int SHIFT_1 = PixelChannelShift( PixelOrderChannel( ORDER, 1 ) );
+  static constexpr int SHIFT_2 = PixelChannelShift( PixelOrderChannel( ORDER, 2 ) );
+
+  static uint32_t Word( const Pixel pixel ) {
+    if constexpr( ORDER == PIXEL_ORDER_BGR ) {
+      // Already the order a Pixel is in.
+      return pixel | 0xE0;
+    } else {
+      return 0xE0 | ( pixel & 0x1F ) |
+             ( ( ( pixel >> SHIFT_0 ) & 0xFF ) << 8 ) |
+             ( ( ( pixel >> SHIFT_1 ) & 0xFF ) << 16 ) |
+             ( ( ( pixel >> SHIFT_2 ) & 0xFF ) << 24 );
+    }
+  };
+
+  static void Encode( uint8_t* ptr_led, const Pixel pixel ) {
+    const uint32_t word = Word( pixel );
+    std::memcpy( ptr_led, &word, BYTES );
+  };
+
+  static void EncodeAll( uint8_t* ptr_leds, const Pixel* pixels, const int amount ) {
+    for( int i = 0; i < amount; i++ ) {
+      const uint32_t word = Word( pixels[ i ] );
+      std::memcpy( ptr_leds + i * BYTES, &word, BYTES );
+    }
+  };
+
+  static void EncodeAll16( uint8_t* ptr_leds, const uint16_t* ptr_colour, const int amount ) {
+  };
+};
+
+template< int ORDER >
+using PixelFormatSK9822 = PixelFormatBrightness8< ORDER, 0x00 >;
+
+// APA102 wants its end frame all 1s.
+template< int ORDER >
+using PixelFormatAPA102 = PixelFormatBrightness8< ORDER, 0xFF >;
+
+// HD108 : 1 start bit & a 5 bit gain for each colour, then 16 bit colours, all most significant byte first.
+template< int ORDER >
+struct PixelFormatHD108
+{
+  static constexpr int      FORMAT   = LEDOUTPUT_FORMAT_HD108;
+  static constexpr size_t   BYTES    = 8;
+  static constexpr bool     DEPTH16  = true;
+  static constexpr uint32_t SPEED_HZ = 8000000;  // Twice the bits of an SK9822, so twice the clock.
+  static constexpr uint8_t  END_FILL = 0x00;
+
+  static size_t StartBytes( const int number_leds ) {
+    return 16;
+  };
+
+  static size_t EndBytes( const int number_leds ) {
+    return 4 + ( number_leds + 15 ) / 16;
+  };
+
+  static constexpr int CHANNEL_0 = PixelOrderChannel( ORDER, 0 );
+  static constexpr int CHANNEL_1 = PixelOrderChannel( ORDER, 1 );
+  static constexpr int CHANNEL_2 = PixelOrderChannel( ORDER, 2 );
+  static constexpr int SHIFT_0   = PixelChannelShift( CHANNEL_0 );
+  static constexpr int SHIFT_1   = PixelChannelShift( CHANNEL_1 );
+  static constexpr int SHIFT_2   = PixelChannelShift( CHANNEL_2 );
+
+  // 8 bit colour is stretched to 16 bit, the brightness goes in each gain.
+  static uint64_t Word( const Pixel pixel ) {
+    const uint64_t gain = pixel & 0x1F;
+    const uint64_t word = ( ( 0x8000 | ( gain << 10 ) | ( gain << 5 ) | gain ) << 48 ) |
+                          ( (uint64_t)( ( ( pixel >> SHIFT_0 ) & 0xFF ) * 257 ) << 32 ) |
+                          ( (uint64_t)( ( ( pixel >> SHIFT_1 ) & 0xFF ) * 257 ) << 16 ) |
+                          ( (uint64_t)( ( ( pixel >> SHIFT_2 ) & 0xFF ) * 257 ) );
+    return __builtin_bswap64( word );
+  };
+
+  static void Encode( uint8_t* ptr_led, const Pixel pixel ) {
+    const uint64_t word = Word( pixel );
+    std::memcpy( ptr_led, &word, BYTES );
+  };
+
+  static void EncodeAll( uint8_t* ptr_leds, const Pixel* pixels, const int amount ) {
+    for( int i = 0; i < amount; i++ ) {
+      const uint64_t word = Word( pixels[ i ] );
+      std::memcpy( ptr_leds + i * BYTES, &word, BYTES );
+    }
+  };
+
+  // Full gain, the brightness is already in the 16 bit colour.
+  static void EncodeAll16( uint8_t* ptr_leds, const uint16_t* ptr_colour, const int amount ) {
+    for( int i = 0; i < amount; i++ ) {
+      const uint64_t word = ( (uint64_t)0xFFFF << 48 ) |
+                            ( (uint64_t)ptr_colour[ CHANNEL_0 ] << 32 ) |
+                            ( (uint64_t)ptr_colour[ CHANNEL_1 ] << 16 ) |
+                            ( (uint64_t)ptr_colour[ CHANNEL_2 ] );
+      const uint64_t wire = __builtin_bswap64( word );
+      std::memcpy( ptr_leds + i * BYTES, &wire, BYTES );
+      ptr_colour += 3;
+    }
+  };
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef _PIXELKERNELS_H_
+#define _PIXELKERNELS_H_
+
+#include <cstdint>
+
+// A pixel packed the same way as an SK9822 LED in BGR order, from the low byte up : brightness (0-31), blue, green, red.
+// The kernels work on all 4 channels at once, a byte lane each, with plain integer ops (SWAR).
+typedef uint32_t Pixel;
+
+#define PIXEL_HIGH_BITS  0x80808080u
+#define PIXEL_LOW_BITS   0x7F7F7F7Fu
+#define PIXEL_BRIGHTNESS 0x000000FFu
+
+inline Pixel PixelPack( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
+  return (Pixel)brightness | ( (Pixel)blue << 8 ) | ( (Pixel)green << 16 ) | ( (Pixel)red << 24 );
+};
+
+inline uint8_t PixelBrightness( const Pixel pixel ) {
+  return pixel & 0xFF;
+};
+
+inline uint8_t PixelBlue( const Pixel pixel ) {
+  return ( pixel >> 8 ) & 0xFF;
+};
+
+inline uint8_t PixelGreen( const Pixel pixel ) {
+  return ( pixel >> 16 ) & 0xFF;
+};
+
+inline uint8_t PixelRed( const Pixel pixel ) {
+  return pixel >> 24;
+};
+
+// 0xFF in each byte lane whose high bit is set in bits.
+inline Pixel PixelLaneMask( const Pixel bits ) {
+  return ( ( bits & PIXEL_HIGH_BITS ) >> 7 ) * 0xFF;
+};
+
+// Scales red, green & blue by level / 256, level 0 - 256.  Brightness is kept.
+inline Pixel PixelScale( const Pixel pixel, const uint32_t level ) {
+  // Blue & red in the low byte of two 16 bit lanes, so each has room for the multiply.
+  const Pixel blue_red = ( ( ( pixel >> 8 ) & 0x00FF00FF ) * level ) & 0xFF00FF00;
+  const Pixel green    = ( ( ( pixel >> 16 ) & 0xFF ) * level & 0xFF00 ) << 8;
+
+  return blue_red | green | ( pixel & PIXEL_BRIGHTNESS );
+};
+
+// Per lane max.
+inline Pixel PixelMax( const Pixel a, const Pixel b ) {
+  // Low 7 bits of a minus those of b, the high bit is left set where a's are >= b's.
+  const Pixel difference = ( a | PIXEL_HIGH_BITS ) - ( b & PIXEL_LOW_BITS );
+  const Pixel a_less = ( ~a & b ) | ( ~( a ^ b ) & ~difference );
+
+  return a ^ ( ( a ^ b ) & PixelLaneMask( a_less ) );
+};
+
+// Per lane add, stopping at 255.  Brightness takes the max, it's a scale rather than light.
+inline Pixel PixelAddSaturate( const Pixel a, const Pixel b ) {
+  const Pixel low   = ( a & PIXEL_LOW_BITS ) + ( b & PIXEL_LOW_BITS );
+  const Pixel sum   = low ^ ( ( a ^ b ) & PIXEL_HIGH_BITS );
+  const Pixel carry = ( a & b ) | ( low & ( a ^ b ) );
+
+  return ( ( sum | PixelLaneMask( carry ) ) & ~PIXEL_BRIGHTNESS ) | ( PixelMax( a, b ) & PIXEL_BRIGHTNESS );
+};
+
+#endif
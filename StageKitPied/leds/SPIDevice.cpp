@@ -0,0 +1,118 @@
+#include "SPIDevice.h"
+
+#include <cstdlib>  // atol
+
+SPIDevice::SPIDevice() {
+  m_file_descriptor = -1;
+  m_speed_hz = 0;
+  m_write_max = SPIDEVICE_WRITE_MAX;
+  m_ptr_frames   = NULL;
+  m_ptr_bytes    = NULL;
+  m_ptr_failures = NULL;
+};
+
+SPIDevice::~SPIDevice() {
+  this->Close();
+};
+
+bool SPIDevice::Open( const std::string& device_name, const uint32_t speed_hz ) {
+  this->Close();
+
+  // Open the file descriptor to the device in write only mode
+  m_file_descriptor = open( device_name.c_str(), O_WRONLY );
+  if( m_file_descriptor < 0 ) {
+    MSG_SPIDEVICE_DEBUG( "Unable to open " << device_name );
+    return false;
+  }
+
+  // Setup SPI with write mode, the bits per word & the maximum writing speed.
+  const uint8_t spi_mode      = SPI_MODE_0;
+  const uint8_t bits_per_word = 8;
+
+  if( ioctl( m_file_descriptor, SPI_IOC_WR_MODE, &spi_mode ) == -1 ||
+      ioctl( m_file_descriptor, SPI_IOC_WR_BITS_PER_WORD, &bits_per_word ) == -1 ||
+      ioctl( m_file_descriptor, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz ) == -1 ) {
+    MSG_SPIDEVICE_ERROR( "Unable to set up " << device_name << " at " << speed_hz << " Hz" );
+    this->Close();
+    return false;
+  }
+
+  m_speed_hz = speed_hz;
+
+  // spidev turns down writes over its buffer size, which spidev.bufsiz in /boot/cmdline.txt raises.
+  m_write_max = SPIDEVICE_WRITE_MAX;
+  const int bufsiz_descriptor = open( SPIDEVICE_BUFSIZ_FILE, O_RDONLY );
+  if( bufsiz_descriptor != -1 ) {
+    char text[ 16 ] = {};
+    if( read( bufsiz_descriptor, text, sizeof( text ) - 1 ) > 0 && atol( text ) > 0 ) {
+      m_write_max = atol( text );
+    }
+    close( bufsiz_descriptor );
+  }
+  MSG_SPIDEVICE_DEBUG( device_name << " takes " << m_write_max << " bytes a write." );
+
+  const std::string labels = "device=\"" + device_name + "\"";
+  m_ptr_frames   = Metrics::Counter( "skp_spi_frames_total", "Frames written to SPI, by device.", labels );
+  m_ptr_bytes    = Metrics::Counter( "skp_spi_bytes_total", "Bytes written to SPI, by device.", labels );
+  m_ptr_failures = Metrics::Counter( "skp_spi_failures_total", "SPI writes that failed, by device.", labels );
+
+  return true;
+};
+
+void SPIDevice::Close() {
+  if( m_file_descriptor != -1 ) {
+    close( m_file_descriptor );
+    m_file_descriptor = -1;
+  }
+};
+
+bool SPIDevice::IsOpen() {
+  return m_file_descriptor != -1;
+};
+
+bool SPIDevice::Write( const void* ptr_data, const size_t size ) {
+  return this->WriteChunks( static_cast<const uint8_t*>( ptr_data ), size, m_write_max );
+};
+
+bool SPIDevice::WriteWhole( const void* ptr_data, const size_t size ) {
+  if( size > m_write_max ) {
+    if( m_ptr_failures != NULL ) {
+      m_ptr_failures->Add();
+    }
+    return false;
+  }
+
+  return this->WriteChunks( static_cast<const uint8_t*>( ptr_data ), size, size );
+};
+
+size_t SPIDevice::GetWriteMax() {
+  return m_write_max;
+};
+
+bool SPIDevice::WriteChunks( const uint8_t* ptr_bytes, const size_t size, const size_t chunk_max ) {
+  if( m_file_descriptor == -1 ) {
+    return false;
+  }
+
+  size_t written = 0;
+
+  while( written < size ) {
+    const size_t chunk = size - written < chunk_max ? size - written : chunk_max;
+
+    ssize_t bytes_written = write( m_file_descriptor, ptr_bytes + written, chunk );
+    if( bytes_written <= 0 ) {
+      m_ptr_failures->Add();
+      return false;
+    }
+    written += bytes_written;
+  }
+
+  m_ptr_frames->Add();
+  m_ptr_bytes->Add( size );
+
+  return true;
+};
+
+uint32_t SPIDevice::GetSpeed() {
+  return m_speed_hz;
+};
@@ -0,0 +1,62 @@
+#ifndef _SPIDEVICE_H_
+#define _SPIDEVICE_H_
+
+#define MSG_SPIDEVICE_DEBUG( str ) LOG_DEBUG( "SPIDevice", str )
+
+#define MSG_SPIDEVICE_ERROR( str ) LOG_ERROR( "SPIDevice", str )
+
+#define SPIDEVICE_WRITE_MAX   4096  // spidev's default buffer size, if it can't be read.
+#define SPIDEVICE_BUFSIZ_FILE "/sys/module/spidev/parameters/bufsiz"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
+
+// A spidev device, written to in mode 0 with 8 bit words.  Shared by the SPI LED outputs.
+class SPIDevice {
+public:
+  SPIDevice();
+
+  ~SPIDevice();
+
+  bool Open( const std::string& device_name, const uint32_t speed_hz );
+
+  void Close();
+
+  bool IsOpen();
+
+  // Blocks until the data has been clocked out.  Split into writes of GetWriteMax, fine for clocked LEDs which
+  // wait as long as they need between writes.
+  bool Write( const void* ptr_data, const size_t size );
+
+  // The same in one write, for LEDs without a clock that take a gap as the end of the frame.
+  // Fails if size is over GetWriteMax.
+  bool WriteWhole( const void* ptr_data, const size_t size );
+
+  // Most spidev takes in one write, spidev.bufsiz.  Read on Open.
+  size_t GetWriteMax();
+
+  uint32_t GetSpeed();
+
+private:
+  bool WriteChunks( const uint8_t* ptr_bytes, const size_t size, const size_t chunk_max );
+
+  int      m_file_descriptor;
+  uint32_t m_speed_hz;
+  size_t   m_write_max;
+
+  // Per device, registered on Open.
+  MetricCounter* m_ptr_frames;
+  MetricCounter* m_ptr_bytes;
+  MetricCounter* m_ptr_failures;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef _SPIPIXELOUTPUT_H_
+#define _SPIPIXELOUTPUT_H_
+
+#define MSG_SPIPIXELOUTPUT_ERROR( str ) LOG_ERROR( "SPIPixelOutput", str )
+
+#include <cstdint>
+#include <cstring> // memcpy
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "helpers/Log.h"
+#include "leds/LEDOutput.h"
+#include "leds/PixelFormats.h"
+#include "leds/SPIDevice.h"
+
+// Clocked SPI LEDs, a start frame, Format::BYTES per LED, then an end frame.  Format is one of PixelFormats.h.
+template< typename Format >
+class SPIPixelOutput : public LEDOutput {
+public:
+  SPIPixelOutput() {
+    m_enabled     = false;
+    m_number_leds = 0;
+    m_ptr_leds    = NULL;
+  };
+
+  ~SPIPixelOutput() {
+    this->SetEnabled( false );
+  };
+
+  bool Init( const int led_amount, const std::string& device_name ) override {
+    if( led_amount <= 0 ) {
+      return false;
+    }
+
+    m_device_name = device_name;
+    m_number_leds = led_amount;
+
+    const size_t start_bytes = Format::StartBytes( led_amount );
+    const size_t end_bytes   = Format::EndBytes( led_amount );
+
+    m_buffer.assign( start_bytes + led_amount * Format::BYTES + end_bytes, 0 );
+    std::memset( &m_buffer[ m_buffer.size() - end_bytes ], Format::END_FILL, end_bytes );
+    m_ptr_leds = &m_buffer[ start_bytes ];
+
+    // Ensure all LEDS are off at start
+    this->AllOff();
+
+    return true;
+  };
+
+  bool SetEnabled( const bool enabled ) override {
+    if( m_enabled == enabled ) {
+      return true;
+    }
+
+    if( enabled ) {
+      if( m_number_leds == 0 || !mSPIDevice.Open( m_device_name, Format::SPEED_HZ ) ) {
+        return false;
+      }
+      m_enabled = true;
+      this->Submit();
+      return true;
+    }
+
+    this->AllOff();
+    this->Submit();
+    mSPIDevice.Close();
+    m_enabled = false;
+
+    return true;
+  };
+
+  bool IsEnabled() override {
+    return m_enabled;
+  };
+
+  int GetAmountLEDS() override {
+    return m_number_leds;
+  };
+
+  int GetPixelFormat() override {
+    return Format::FORMAT;
+  };
+
+  bool HasBrightness() override {
+    return true;
+  };
+
+  bool HasDepth16() override {
+    return Format::DEPTH16;
+  };
+
+  size_t GetFrameSize() override {
+    return m_buffer.size();
+  };
+
+  long GetFrameTimeUs() override {
+    return ( (long long)m_buffer.size() * 8 * 1000000 ) / Format::SPEED_HZ;
+  };
+
+  void SetPixelRange( const Pixel* pixels, const int first, const int amount ) override {
+    Format::EncodeAll( m_ptr_leds + first * Format::BYTES, pixels + first, amount );
+  };
+
+  void SetPixelRange16( const uint16_t* ptr_colour, const int first, const int amount ) override {
+    Format::EncodeAll16( m_ptr_leds + first * Format::BYTES, ptr_colour + first * 3, amount );
+  };
+
+  void SetColour( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) override {
+    if( led_number > 0 && led_number <= m_number_leds ) {
+      Format::Encode( m_ptr_leds + ( led_number - 1 ) * Format::BYTES, PixelPack( red, green, blue, brightness & 0x1F ) );
+    } else {
+      MSG_SPIPIXELOUTPUT_ERROR( "Tried setting LED out of range ( " << led_number << " : 1 - " << m_number_leds << " )" );
+    }
+  };
+
+  void SetColourAll( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) override {
+    const Pixel pixel = PixelPack( red, green, blue, brightness & 0x1F );
+
+    uint8_t* ptr_led = m_ptr_leds;
+    for( int i = 0; i < m_number_leds; i++ ) {
+      Format::Encode( ptr_led, pixel );
+      ptr_led += Format::BYTES;
+    }
+  };
+
+  // Push colour/brightness changes to the actual LEDs
+  bool Submit() override {
+    if( !m_enabled || m_number_leds == 0 ) {
+      return false;
+    }
+
+    return mSPIDevice.Write( m_buffer.data(), m_buffer.size() );
+  };
+
+  bool WaitComplete() override {
+    return true;
+  };
+
+private:
+  bool        m_enabled;
+  std::string m_device_name;
+  SPIDevice   mSPIDevice;
+
+  int                  m_number_leds;
+  std::vector<uint8_t> m_buffer;    // Start frame, LEDs, end frame.
+  uint8_t*             m_ptr_leds;  // LED 1 in m_buffer.
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "WS2812.h"
+
+WS2812::WS2812( const bool rgbw ) {
+  m_rgbw        = rgbw;
+  m_led_bytes   = ( rgbw ? 4 : 3 ) * WS2812_SYMBOL_BYTES;
+  m_enabled     = false;
+  m_number_leds = 0;
+
+  for( int brightness = 0; brightness < 32; brightness++ ) {
+    m_brightness_level[ brightness ] = 0;
+  }
+};
+
+WS2812::~WS2812() {
+  this->SetEnabled( false );
+};
+
+bool WS2812::Init( const int led_amount, const std::string& device_name ) {
+  if( led_amount <= 0 ) {
+    return false;
+  }
+
+  m_device_name = device_name;
+  m_number_leds = led_amount;
+
+  // Lead & reset are all 0 bits, so the line sits low.
+  m_buffer.assign( WS2812_LEAD_BYTES + led_amount * m_led_bytes + WS2812_RESET_BYTES, 0 );
+
+  // PixelScale takes 0 - 256, brightness 31 is full.
+  for( int brightness = 0; brightness < 32; brightness++ ) {
+    m_brightness_level[ brightness ] = ( brightness * 256 + 15 ) / 31;
+  }
+
+  this->AllOff();
+
+  return true;
+};
+
+bool WS2812::SetEnabled( const bool enabled ) {
+  if( m_enabled == enabled ) {
+    return true;
+  }
+
+  if( enabled ) {
+    if( m_number_leds == 0 || !mSPIDevice.Open( m_device_name, WS2812_SPI_SPEED_HZ ) ) {
+      return false;
+    }
+
+    // Without a clock, a gap between writes ends the frame, so each has to go out in one.
+    if( this->GetFrameSize() > mSPIDevice.GetWriteMax() ) {
+      MSG_WS2812_ERROR( m_number_leds << " LEDs need " << this->GetFrameSize() << " bytes a frame, spidev only takes "
+                        << mSPIDevice.GetWriteMax() << ".  Add spidev.bufsiz=65536 to /boot/cmdline.txt & reboot." );
+      mSPIDevice.Close();
+      return false;
+    }
+    m_enabled = true;
+    this->Submit();
+    return true;
+  }
+
+  this->AllOff();
+  this->Submit();
+  mSPIDevice.Close();
+  m_enabled = false;
+
+  return true;
+};
+
+bool WS2812::IsEnabled() {
+  return m_enabled;
+};
+
+int WS2812::GetAmountLEDS() {
+  return m_number_leds;
+};
+
+int WS2812::GetPixelFormat() {
+  return m_rgbw ? LEDOUTPUT_FORMAT_GRBW : LEDOUTPUT_FORMAT_GRB;
+};
+
+bool WS2812::HasBrightness() {
+  return false;
+};
+
+size_t WS2812::GetFrameSize() {
+  return m_buffer.size();
+};
+
+long WS2812::GetFrameTimeUs() {
+  return ( (long long)m_buffer.size() * 8 * 1000000 ) / WS2812_SPI_SPEED_HZ;
+};
+
+void WS2812::SetPixelRange( const Pixel* pixels, const int first, const int amount ) {
+  uint8_t* ptr_led = &m_buffer[ WS2812_LEAD_BYTES + first * m_led_bytes ];
+  const int last = first + amount;
+
+  // Groups light runs of LEDs one colour, those are copies of the LED before.  Not across the start of the
+  // range, another thread may still be setting the LED before it.
+  for( int i = first; i < last; i++ ) {
+    if( i > first && pixels[ i ] == pixels[ i - 1 ] ) {
+      std::memcpy( ptr_led, ptr_led - m_led_bytes, m_led_bytes );
+    } else {
+      this->Encode( ptr_led, pixels[ i ] );
+    }
+    ptr_led += m_led_bytes;
+  }
+};
+
+void WS2812::SetColour( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
+  if( led_number > 0 && led_number <= m_number_leds ) {
+    this->Encode( &m_buffer[ WS2812_LEAD_BYTES + ( led_number - 1 ) * m_led_bytes ], PixelPack( red, green, blue, brightness & 0x1F ) );
+  } else {
+    MSG_WS2812_ERROR( "Tried setting LED out of range ( " << led_number << " : 1 - " << m_number_leds << " )" );
+  }
+};
+
+void WS2812::SetColourAll( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) {
+  if( m_number_leds == 0 ) {
+    return;
+  }
+
+  uint8_t* ptr_led = &m_buffer[ WS2812_LEAD_BYTES ];
+  this->Encode( ptr_led, PixelPack( red, green, blue, brightness & 0x1F ) );
+
+  for( int i = 1; i < m_number_leds; i++ ) {
+    std::memcpy( ptr_led + i * m_led_bytes, ptr_led, m_led_bytes );
+  }
+};
+
+bool WS2812::Submit() {
+  if( !m_enabled || m_number_leds == 0 ) {
+    return false;
+  }
+
+  return mSPIDevice.WriteWhole( m_buffer.data(), m_buffer.size() );
+};
+
+bool WS2812::WaitComplete() {
+  return true;
+};
+
+void WS2812::Encode( uint8_t* ptr_led, Pixel pixel ) {
+  const uint8_t brightness = PixelBrightness( pixel ) & 0x1F;
+  if( brightness < 31 ) {
+    pixel = PixelScale( pixel, m_brightness_level[ brightness ] );
+  }
+
+  uint8_t red   = PixelRed( pixel );
+  uint8_t green = PixelGreen( pixel );
+  uint8_t blue  = PixelBlue( pixel );
+
+  // Each symbol is a 4 byte copy, a single store.
+  if( m_rgbw ) {
+    uint8_t white = red < green ? red : green;
+    white = white < blue ? white : blue;
+    red   -= white;
+    green -= white;
+    blue  -= white;
+    std::memcpy( ptr_led + 3 * WS2812_SYMBOL_BYTES, WS2812_SYMBOLS[ white ].data(), WS2812_SYMBOL_BYTES );
+  }
+
+  std::memcpy( ptr_led,                           WS2812_SYMBOLS[ green ].data(), WS2812_SYMBOL_BYTES );
+  std::memcpy( ptr_led + WS2812_SYMBOL_BYTES,     WS2812_SYMBOLS[ red ].data(),   WS2812_SYMBOL_BYTES );
+  std::memcpy( ptr_led + 2 * WS2812_SYMBOL_BYTES, WS2812_SYMBOLS[ blue ].data(),  WS2812_SYMBOL_BYTES );
+};
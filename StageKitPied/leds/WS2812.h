@@ -0,0 +1,95 @@
+#ifndef _WS2812_H_
+#define _WS2812_H_
+
+#define MSG_WS2812_DEBUG( str ) LOG_DEBUG( "WS2812", str )
+
+#define MSG_WS2812_ERROR( str ) LOG_ERROR( "WS2812", str )
+
+// Each WS2812 bit is 4 SPI bits, 1000 for a 0 & 1110 for a 1, so a 1.25us bit needs 3.2MHz.
+#define WS2812_SPI_SPEED_HZ  3200000
+#define WS2812_SYMBOL_BYTES  4         // SPI bytes for one colour byte.
+#define WS2812_LEAD_BYTES    4         // Low before the first LED, in case the line idles high.
+#define WS2812_RESET_BYTES   120       // 300us low latches the colours, enough for newer WS2812B too.
+
+#include <array>
+#include <cstdint>
+#include <cstring> // memcpy
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "helpers/Log.h"
+#include "leds/LEDOutput.h"
+#include "leds/SPIDevice.h"
+
+typedef std::array<uint8_t, WS2812_SYMBOL_BYTES> WS2812Symbol;
+
+// SPI bytes for each colour byte, most significant bit first.  Built by the compiler.
+constexpr std::array<WS2812Symbol, 256> WS2812MakeSymbols() {
+  std::array<WS2812Symbol, 256> symbols = {};
+
+  for( int value = 0; value < 256; value++ ) {
+    for( int bit = 0; bit < 8; bit++ ) {
+      const uint8_t nibble = ( value & ( 0x80 >> bit ) ) ? 0x0E : 0x08;
+      symbols[ value ][ bit / 2 ] |= ( bit & 1 ) ? nibble : nibble << 4;
+    }
+  }
+
+  return symbols;
+};
+
+static constexpr std::array<WS2812Symbol, 256> WS2812_SYMBOLS = WS2812MakeSymbols();
+
+static_assert( WS2812_SYMBOLS[ 0x80 ][ 0 ] == 0xE8 && WS2812_SYMBOLS[ 0x01 ][ 3 ] == 0x8E, "WS2812 symbols are off." );
+
+// WS2812 & SK6812 LEDs, driven by the SPI data line alone.  They take green, red, blue (& white for RGBW)
+// with no brightness, so the pixel brightness is folded into the colour.
+class WS2812 : public LEDOutput {
+public:
+  // rgbw for SK6812 RGBW, white is taken from what red, green & blue have in common.
+  WS2812( const bool rgbw );
+
+  ~WS2812();
+
+  bool Init( const int led_amount, const std::string& device_name ) override;
+
+  bool SetEnabled( const bool enabled ) override;
+
+  bool IsEnabled() override;
+
+  int GetAmountLEDS() override;
+
+  int GetPixelFormat() override;
+
+  bool HasBrightness() override;
+
+  size_t GetFrameSize() override;
+
+  long GetFrameTimeUs() override;
+
+  void SetPixelRange( const Pixel* pixels, const int first, const int amount ) override;
+
+  void SetColour( const int led_number, const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) override;
+
+  void SetColourAll( const uint8_t red, const uint8_t green, const uint8_t blue, const uint8_t brightness ) override;
+
+  bool Submit() override;
+
+  bool WaitComplete() override;
+
+private:
+  void Encode( uint8_t* ptr_led, Pixel pixel );
+
+  bool        m_rgbw;
+  int         m_led_bytes;       // SPI bytes per LED.
+  bool        m_enabled;
+  std::string m_device_name;
+  SPIDevice   mSPIDevice;
+
+  int                  m_number_leds;
+  std::vector<uint8_t> m_buffer;  // Lead, LEDs, reset.
+
+  uint16_t    m_brightness_level[ 32 ];  // Brightness 0-31 to a PixelScale level.
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "ControlSocket.h"
+
+ControlSocket::ControlSocket() {
+  m_socket_descriptor = -1;
+  m_client_next       = 0;
+  m_client_current    = -1;
+  m_message_size      = 0;
+
+  for( int client = 0; client < CONTROLSOCKET_CLIENTS_MAX; client++ ) {
+    m_clients[ client ] = -1;
+  }
+};
+
+ControlSocket::~ControlSocket() {
+  this->Stop();
+};
+
+bool ControlSocket::Start( const std::string& socket_path ) {
+  this->Stop();
+
+  sockaddr_un address;
+  memset( &address, 0, sizeof( address ) );
+  address.sun_family = AF_UNIX;
+
+  if( socket_path.empty() || socket_path.size() >= sizeof( address.sun_path ) ) {
+    MSG_CONTROLSOCKET_ERROR( "Bad socket path : " << socket_path );
+    return false;
+  }
+  strcpy( address.sun_path, socket_path.c_str() );
+
+  m_socket_descriptor = socket( AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+  if( m_socket_descriptor == -1 ) {
+    MSG_CONTROLSOCKET_ERROR( "Unable to create a socket : " << strerror( errno ) );
+    return false;
+  }
+
+  // Left over from a previous run.
+  unlink( address.sun_path );
+
+  if( bind( m_socket_descriptor, (sockaddr*)&address, sizeof( address ) ) == -1 || listen( m_socket_descriptor, CONTROLSOCKET_CLIENTS_MAX ) == -1 ) {
+    MSG_CONTROLSOCKET_ERROR( "Unable to listen on " << socket_path << " : " << strerror( errno ) );
+    close( m_socket_descriptor );
+    m_socket_descriptor = -1;
+    return false;
+  }
+
+  m_socket_path = socket_path;
+
+  MSG_CONTROLSOCKET_INFO( "Taking commands on " << m_socket_path << "." );
+
+  return true;
+};
+
+void ControlSocket::Stop() {
+  for( int client = 0; client < CONTROLSOCKET_CLIENTS_MAX; client++ ) {
+    this->CloseClient( client );
+  }
+
+  if( m_socket_descriptor != -1 ) {
+    close( m_socket_descriptor );
+    m_socket_descriptor = -1;
+    unlink( m_socket_path.c_str() );
+  }
+};
+
+bool ControlSocket::Poll() {
+  ALLOC_SCOPE( "control" );
+
+  if( m_socket_descriptor == -1 ) {
+    return false;
+  }
+
+  this->AcceptClients();
+
+  for( int turn = 0; turn < CONTROLSOCKET_CLIENTS_MAX; turn++ ) {
+    const int client = ( m_client_next + turn ) % CONTROLSOCKET_CLIENTS_MAX;
+    if( m_clients[ client ] == -1 ) {
+      continue;
+    }
+
+    // MSG_TRUNC gives the whole length, so an oversized request can be turned away rather than half read.
+    const ssize_t bytes = recv( m_clients[ client ], m_message, sizeof( m_message ), MSG_DONTWAIT | MSG_TRUNC );
+    if( bytes == -1 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) {
+      continue;
+    }
+
+    if( bytes <= 0 ) {
+      MSG_CONTROLSOCKET_DEBUG( "Client " << client << " gone." );
+      this->CloseClient( client );
+      continue;
+    }
+
+    m_client_current = client;
+    m_client_next    = ( client + 1 ) % CONTROLSOCKET_CLIENTS_MAX;
+
+    if( bytes > (ssize_t)sizeof( m_message ) ) {
+      this->Reply( CONTROL_STATUS_BAD_LENGTH );
+      continue;
+    }
+
+    m_message_size = bytes;
+    return true;
+  }
+
+  return false;
+};
+
+uint8_t ControlSocket::GetCommand() {
+  return m_message[ 0 ];
+};
+
+const uint8_t* ControlSocket::GetData() {
+  return m_message + 1;
+};
+
+uint32_t ControlSocket::GetDataSize() {
+  return m_message_size - 1;
+};
+
+bool ControlSocket::Reply( const CONTROL_STATUS status, const void* ptr_data, const size_t size ) {
+  if( m_client_current == -1 || m_clients[ m_client_current ] == -1 ) {
+    return false;
+  }
+
+  uint8_t header[ 2 ] = { m_message[ 0 ], (uint8_t)status };
+
+  iovec parts[ 2 ];
+  parts[ 0 ].iov_base = header;
+  parts[ 0 ].iov_len  = sizeof( header );
+  parts[ 1 ].iov_base = const_cast<void*>( ptr_data );
+  parts[ 1 ].iov_len  = size;
+
+  msghdr message;
+  memset( &message, 0, sizeof( message ) );
+  message.msg_iov    = parts;
+  message.msg_iovlen = ptr_data != NULL && size > 0 ? 2 : 1;
+
+  // A full socket means the client isn't reading its replies, waiting on it would hold the lights up.
+  if( sendmsg( m_clients[ m_client_current ], &message, MSG_DONTWAIT | MSG_NOSIGNAL ) == -1 ) {
+    MSG_CONTROLSOCKET_ERROR( "Dropping client " << m_client_current << ", reply not sent : " << strerror( errno ) );
+    this->CloseClient( m_client_current );
+    return false;
+  }
+
+  return true;
+};
+
+void ControlSocket::AcceptClients() {
+  while( true ) {
+    const int descriptor = accept4( m_socket_descriptor, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC );
+    if( descriptor == -1 ) {
+      return;
+    }
+
+    int client = 0;
+    while( client < CONTROLSOCKET_CLIENTS_MAX && m_clients[ client ] != -1 ) {
+      client++;
+    }
+
+    if( client == CONTROLSOCKET_CLIENTS_MAX ) {
+      MSG_CONTROLSOCKET_ERROR( "Already " << CONTROLSOCKET_CLIENTS_MAX << " clients, turning another away." );
+      close( descriptor );
+      continue;
+    }
+
+    m_clients[ client ] = descriptor;
+    MSG_CONTROLSOCKET_DEBUG( "Client " << client << " connected." );
+  }
+};
+
+void ControlSocket::CloseClient( const int client ) {
+  if( m_clients[ client ] != -1 ) {
+    close( m_clients[ client ] );
+    m_clients[ client ] = -1;
+  }
+};
@@ -0,0 +1,109 @@
+#ifndef _CONTROLSOCKET_H_
+#define _CONTROLSOCKET_H_
+
+#define MSG_CONTROLSOCKET_DEBUG( str ) LOG_DEBUG( "ControlSocket", str )
+
+#define MSG_CONTROLSOCKET_ERROR( str ) LOG_ERROR( "ControlSocket", str )
+#define MSG_CONTROLSOCKET_INFO( str ) LOG_INFO( "ControlSocket", str )
+
+#define CONTROLSOCKET_CLIENTS_MAX       4
+#define CONTROLSOCKET_MESSAGE_MAX       512   // Longest request, 255 cues.
+#define CONTROLSOCKET_MESSAGES_PER_POLL 16    // Handled each pass of the main loop, so a busy client can't starve the lights.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "helpers/AllocTracker.h"
+#include "helpers/Log.h"
+
+// Protocol - One SOCK_SEQPACKET message each way, so nothing needs framing.
+//  Request : uint8 command, then its data.
+//  Reply   : uint8 command, uint8 CONTROL_STATUS, then its data.
+// Multi byte values are little endian, as on the Pi.
+enum CONTROL_COMMAND {
+  CONTROL_COMMAND_SELECT_PROFILE = 1,  // uint8 profile, 1 = INI1.
+  CONTROL_COMMAND_SET_KIT_CONFIG = 2,  // uint8 stage kit, uint8 config id 0 - 4.
+  CONTROL_COMMAND_CUE            = 3,  // uint8 left weight, uint8 right weight, repeated for more cues.
+  CONTROL_COMMAND_GET_STATE      = 4,  // Reply ControlState.
+  CONTROL_COMMAND_GET_STATS      = 5,  // Reply the metrics, Prometheus text.
+  CONTROL_COMMAND_GET_RECORDING  = 6   // Reply ControlCueRecord for each recent cue, oldest first.
+};
+
+enum CONTROL_STATUS {
+  CONTROL_STATUS_OK              = 0,
+  CONTROL_STATUS_UNKNOWN_COMMAND = 1,
+  CONTROL_STATUS_BAD_LENGTH      = 2,
+  CONTROL_STATUS_FAILED          = 3
+};
+
+#pragma pack( push, 1 )
+struct ControlState
+{
+  uint8_t m_profile;                 // 1 = INI1.
+  uint8_t m_profile_amount;
+  uint8_t m_red;                     // Pod LED bits.
+  uint8_t m_green;
+  uint8_t m_blue;
+  uint8_t m_yellow;
+  uint8_t m_strobe_speed;            // 0 = Off.
+  uint8_t m_fog_on;
+  uint8_t m_stagekit_amount;
+  uint8_t m_stagekit_config[ 4 ];
+};
+
+struct ControlCueRecord
+{
+  uint32_t m_age_ms;                 // Before the recording was asked for.
+  uint8_t  m_left_weight;
+  uint8_t  m_right_weight;
+};
+#pragma pack( pop )
+
+// Takes commands on a unix socket, polled from the main loop.  Never blocks, a client that stops reading its
+// replies is dropped.
+class ControlSocket
+{
+public:
+  ControlSocket();
+
+  ~ControlSocket();
+
+  bool Start( const std::string& socket_path );
+
+  void Stop();
+
+  // Returns true with the next request from any client.  Reply before polling again.
+  bool Poll();
+
+  uint8_t GetCommand();
+
+  // Data after the command.
+  const uint8_t* GetData();
+
+  uint32_t GetDataSize();
+
+  bool Reply( const CONTROL_STATUS status, const void* ptr_data = NULL, const size_t size = 0 );
+
+private:
+  void AcceptClients();
+
+  void CloseClient( const int client );
+
+  std::string m_socket_path;
+  int         m_socket_descriptor;
+  int         m_clients[ CONTROLSOCKET_CLIENTS_MAX ];
+  int         m_client_next;     // Polled first next time, so every client gets a turn.
+  int         m_client_current;  // Sent the last request.
+
+  uint8_t     m_message[ CONTROLSOCKET_MESSAGE_MAX ];
+  uint32_t    m_message_size;
+};
+
+#endif
@@ -19,6 +19,17 @@ RB3E_Network::RB3E_Network() {
     m_player_difficulty[ i ] = 0;
     m_player_track_type[ i ] = 0;
   }  
+
+  // Room for the longest a packet can carry, so a new song's names never allocate mid song.
+  m_song_name.reserve( RB3E_NETWORK_STRING_MAX );
+  m_song_name_short.reserve( RB3E_NETWORK_STRING_MAX );
+  m_song_artist.reserve( RB3E_NETWORK_STRING_MAX );
+
+  m_ptr_packets_received   = Metrics::Counter( "skp_packets_received_total", "Packets taken in, by source.", "source=\"rb3e\"" );
+  m_ptr_packets_unexpected = Metrics::Counter( "skp_packets_dropped_total", "Packets thrown away, by source & reason.",
+                                               "source=\"rb3e\",reason=\"unexpected_source\"" );
+  m_ptr_packets_invalid    = Metrics::Counter( "skp_packets_dropped_total", "Packets thrown away, by source & reason.",
+                                               "source=\"rb3e\",reason=\"invalid\"" );
 };
 
 RB3E_Network::~RB3E_Network() {
@@ -127,6 +138,8 @@ void RB3E_Network::Stop() {
 };
 
 bool RB3E_Network::Poll() {
+  ALLOC_SCOPE( "network" );
+
   if( m_is_sender || m_network_socket == -1 ) {
     return false;
   }
@@ -156,6 +169,7 @@ bool RB3E_Network::Poll() {
       char source_ip[ INET_ADDRSTRLEN ];
       inet_ntop( AF_INET, &( senders_address.sin_addr ), source_ip, INET_ADDRSTRLEN );
       MSG_RB3E_NETWORK_INFO( "Ignoring packet from unexpected source : " << source_ip );
+      m_ptr_packets_unexpected->Add();
       return false;
     }
   }
@@ -164,9 +178,12 @@ bool RB3E_Network::Poll() {
   if( ntohl( packet->Header.ProtocolMagic ) != RB3E_NETWORK_MAGICKEY ) {
     MSG_RB3E_NETWORK_INFO( "Incorrect RB3E magic key in packet." );
     m_data_buffer_last_size = 0;
+    m_ptr_packets_invalid->Add();
     return false;
   }
 
+  m_ptr_packets_received->Add();
+
   // Process received data
   m_event_type_last = packet->Header.PacketType;
 
@@ -1,14 +1,12 @@
 #ifndef _RB3E_NETWORK_H_
 #define _RB3E_NETWORK_H_
 
-#ifdef DEBUG
-  #define MSG_RB3E_NETWORK_DEBUG( str ) do { std::cout << "RB3E_Network : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_RB3E_NETWORK_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_RB3E_NETWORK_DEBUG( str ) LOG_DEBUG( "RB3E_Network", str )
+
+#define MSG_RB3E_NETWORK_ERROR( str ) LOG_ERROR( "RB3E_Network", str )
+#define MSG_RB3E_NETWORK_INFO( str ) LOG_INFO( "RB3E_Network", str )
 
-#define MSG_RB3E_NETWORK_ERROR( str ) do { std::cout << "RB3E_Network : ERROR : " << str << std::endl; } while( false )
-#define MSG_RB3E_NETWORK_INFO( str ) do { std::cout << "RB3E_Network : INFO : " << str << std::endl; } while( false )
+#define RB3E_NETWORK_STRING_MAX 255  // Longest string a packet carries, PacketSize being a byte.
 
 #include <iostream>
 #include <fcntl.h>
@@ -20,6 +18,9 @@
 #include <iomanip>
 #include <bitset>
 
+#include "helpers/AllocTracker.h"
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
 #include "network/RB3E_NetworkHelpers.h"
 
 class RB3E_Network
@@ -95,6 +96,10 @@ private:
   uint32_t           m_player_score[ 4 ];
   uint8_t            m_player_difficulty[ 4 ];
   uint8_t            m_player_track_type[ 4 ];  
+
+  MetricCounter*     m_ptr_packets_received;
+  MetricCounter*     m_ptr_packets_unexpected;  // From somewhere other than SOURCE_IP.
+  MetricCounter*     m_ptr_packets_invalid;     // Not RB3E.
 };
 
 #endif
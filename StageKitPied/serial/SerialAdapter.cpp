@@ -4,13 +4,18 @@
 SerialAdapter::SerialAdapter() {
   m_filedescriptor = -1;
   m_status = -1;
+  m_surpress_warnings = false;
+  m_baudrate = SERIALADAPTER_DEFAULT_BAUDRATE_BPS;
+  m_baudrate_max = SERIALADAPTER_BAUDRATE_MAX_BPS;
+  m_link_errors = 0;
 
-  time_t sec = SERIALADAPTER_DEFAULT_TIMEOUT / 1000;
-  __suseconds_t usec = (SERIALADAPTER_DEFAULT_TIMEOUT - sec * 1000) * 1000;
-  m_timeout = {.tv_sec = sec, .tv_usec = usec};
+  this->SetTimeout( SERIALADAPTER_DEFAULT_TIMEOUT );
 
   m_poll_timeout_msecs = 10;
 
+  m_ptr_packets_received = Metrics::Counter( "skp_packets_received_total", "Packets taken in, by source.", "source=\"serial\"" );
+  m_ptr_packets_dropped  = Metrics::Counter( "skp_packets_dropped_total", "Packets thrown away, by source & reason.",
+                                             "source=\"serial\",reason=\"link_error\"" );
 };
 
 SerialAdapter::~SerialAdapter() {
@@ -40,19 +45,32 @@ int SerialAdapter::PayloadLength() {
   return m_payload_length;
 };
 
-bool SerialAdapter::Init( const char* path, bool surpress_warnings ) {
-  if( m_filedescriptor != -1 ) {
-    return false;
-  }
+void SerialAdapter::SetBaudrateMax( const int baudrate ) {
+  m_baudrate_max = baudrate;
+};
+
+int SerialAdapter::GetBaudrate() {
+  return m_baudrate;
+};
 
+void SerialAdapter::SetTimeout( const int timeout_ms ) {
+  time_t sec = timeout_ms / 1000;
+  __suseconds_t usec = (timeout_ms - sec * 1000) * 1000;
+  m_timeout = {.tv_sec = sec, .tv_usec = usec};
+  m_timeout_ms = timeout_ms;
+};
+
+bool SerialAdapter::Open( const char* path ) {
   m_filedescriptor = open( path, O_RDWR | O_NOCTTY | O_NONBLOCK );
   if( m_filedescriptor < 0 ) {
+    m_filedescriptor = -1;
     return false;
   }
 
   struct termios options;
 
   if( tcgetattr( m_filedescriptor, &options ) < 0 ) {
+    this->Close();
     return false;
   }
 
@@ -63,13 +81,54 @@ bool SerialAdapter::Init( const char* path, bool surpress_warnings ) {
   cfmakeraw( &options );
 
   if( tcsetattr( m_filedescriptor, TCSANOW, &options ) < 0) {
+    this->Close();
     return false;
   }
 
   tcflush( m_filedescriptor, TCIFLUSH );
 
+  return true;
+};
+
+bool SerialAdapter::Probe( const char* path, const int timeout_ms ) {
+  if( m_filedescriptor != -1 ) {
+    return false;
+  }
+
+  m_surpress_warnings = true;
+
+  // Not a serial port, or in use.
+  if( !this->Open( path ) ) {
+    return false;
+  }
+
+  this->SetTimeout( timeout_ms );
+  bool found = this->GetType() && m_type == ADAPTER_TYPE_X360SK;
+  this->SetTimeout( SERIALADAPTER_DEFAULT_TIMEOUT );
+
+  close( m_filedescriptor );
+  m_filedescriptor = -1;
+
+  return found;
+};
+
+bool SerialAdapter::Init( const char* path, bool surpress_warnings ) {
+  if( m_filedescriptor != -1 ) {
+    return false;
+  }
+
+  // Save warnings surpress
+  m_surpress_warnings = surpress_warnings;
+  m_baudrate = SERIALADAPTER_DEFAULT_BAUDRATE_BPS;
+  m_link_errors = 0;
+
+  if( !this->Open( path ) ) {
+    return false;
+  }
+
   if( !this->GetType() ) {
     MSG_SERIALADAPTER_ERROR( "Failed to get adapter type." );
+    this->Close();
     return false;
   }
 
@@ -86,6 +145,8 @@ bool SerialAdapter::Init( const char* path, bool surpress_warnings ) {
 
     this->DumpData( true );
 
+    this->Close();
+
     return false;
   }
 
@@ -95,12 +156,22 @@ bool SerialAdapter::Init( const char* path, bool surpress_warnings ) {
 
     this->DumpData( true );
 
+    this->Close();
+
     return false;
   }
   MSG_SERIALADAPTER_INFO( "Adapter version = " << m_version_major << "." << m_version_minor );
 
+  // Raise the link speed before the adapter starts talking to the console.
+  if( !this->NegotiateBaudrate() ) {
+    MSG_SERIALADAPTER_ERROR( "Lost the adapter while negotiating the baudrate." );
+    this->Close();
+    return false;
+  }
+
   if( !this->Start() ) {
     MSG_SERIALADAPTER_ERROR( "Serial Adapter : ERROR : Failed to start." );
+    this->Close();
     return false;
   }
 
@@ -108,9 +179,6 @@ bool SerialAdapter::Init( const char* path, bool surpress_warnings ) {
   m_poll_fds[ 0 ].fd = m_filedescriptor;
   m_poll_fds[ 0 ].events = POLLIN | POLLOUT | POLLERR | POLLHUP | POLLNVAL;  // input/output/error/disconnect/fd invalid.  
 
-  // Save warnings surpress
-  m_surpress_warnings = surpress_warnings;
-
   return true;
 };
 
@@ -126,11 +194,14 @@ int SerialAdapter::Write( unsigned char* buffer, unsigned int count )
   int write_amount;
 
   fd_set writefds;
+  struct timeval timeout;
 
   while( bytes_written != count ) {
     FD_ZERO( &writefds );
     FD_SET( m_filedescriptor, &writefds );
-    int status = select( m_filedescriptor + 1, NULL, &writefds, NULL, &m_timeout );
+    // select updates the timeout with the time left, so it is copied each time.
+    timeout = m_timeout;
+    int status = select( m_filedescriptor + 1, NULL, &writefds, NULL, &timeout );
     if( status > 0 ) {
       if( FD_ISSET( m_filedescriptor, &writefds ) ) {
         write_amount = write( m_filedescriptor, buffer + bytes_written, count - bytes_written );
@@ -157,11 +228,13 @@ int SerialAdapter::Read( unsigned char* buffer, unsigned int count ) {
   int read_amount;
 
   fd_set readfds;
+  struct timeval timeout;
 
   while( bytes_read != count ) {
     FD_ZERO( &readfds );
     FD_SET( m_filedescriptor, &readfds );
-    int status = select( m_filedescriptor + 1, &readfds, NULL, NULL, &m_timeout );
+    timeout = m_timeout;
+    int status = select( m_filedescriptor + 1, &readfds, NULL, NULL, &timeout );
     if( status > 0 ) {
       if( FD_ISSET( m_filedescriptor, &readfds ) ) {
         read_amount = read( m_filedescriptor, buffer + bytes_read, count - bytes_read );
@@ -195,9 +268,11 @@ int SerialAdapter::Read( unsigned char* buffer, unsigned int count ) {
 
 bool SerialAdapter::WaitForReply( int header_value, int payload_length ) {
   int read_amount;
-  int timeout = 10000;
 
-  while( timeout-- > 0 ) {
+  // Other packets can arrive first, but the reply has to turn up within the timeout.
+  const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( m_timeout_ms );
+
+  while( std::chrono::steady_clock::now() < deadline ) {
     // Find header
     read_amount = this->Read( m_header, 2 );
     if( read_amount != 2 ) {
@@ -268,7 +343,8 @@ bool SerialAdapter::GetVersion() {
   return true;
 };
 
-bool SerialAdapter::GetBaudrate() {
+// Asks the adapter which rate it is running at.
+bool SerialAdapter::RequestBaudrate() {
   m_header[ 0 ] = HEADER_BAUDRATE;
   m_header[ 1 ] = 0x00;
 
@@ -281,11 +357,143 @@ bool SerialAdapter::GetBaudrate() {
     return false;
   }
 
-  m_baudrate = m_payload[ 0 ] * 1000;
+  // Adapter rate is in 100Kbps steps.
+  m_baudrate = m_payload[ 0 ] * 100000;
+
+  return true;
+};
+
+// Tells the adapter to change rate.  There is no reply, the adapter switches as soon as the packet is read.
+bool SerialAdapter::SetBaudrate( const int baudrate ) {
+  m_payload_out[ 0 ] = HEADER_BAUDRATE;
+  m_payload_out[ 1 ] = 0x01;
+  m_payload_out[ 2 ] = baudrate / 100000;
+
+  if( this->Write( m_payload_out, 3 ) != 3 ) {
+    return false;
+  }
+
+  // Packet must be fully out before our side changes rate.
+  tcdrain( m_filedescriptor );
+
+  return true;
+};
+
+bool SerialAdapter::SetLocalBaudrate( const int baudrate ) {
+  speed_t speed;
+
+  switch( baudrate ) {
+    case 2000000:
+      speed = B2000000;
+      break;
+    case 1000000:
+      speed = B1000000;
+      break;
+    case 500000:
+      speed = B500000;
+      break;
+    default:
+      return false;
+  }
+
+  struct termios options;
+
+  if( tcgetattr( m_filedescriptor, &options ) < 0 ) {
+    return false;
+  }
+
+  cfsetispeed( &options, speed );
+  cfsetospeed( &options, speed );
+
+  if( tcsetattr( m_filedescriptor, TCSANOW, &options ) < 0 ) {
+    return false;
+  }
+
+  // Output was drained before the change, only stale input is dropped.
+  tcflush( m_filedescriptor, TCIFLUSH );
+
+  return true;
+};
+
+// Steps down from the fastest rate until one passes a run of round trips.
+// Returns false only if the adapter can't be got back at the default rate.
+bool SerialAdapter::NegotiateBaudrate() {
+  static const int baudrates[] = { 2000000, 1000000 };
+
+  m_baudrate = SERIALADAPTER_DEFAULT_BAUDRATE_BPS;
+
+  for( int baudrate : baudrates ) {
+    if( baudrate > m_baudrate_max ) {
+      continue;
+    }
+
+    MSG_SERIALADAPTER_DEBUG( "Trying baudrate " << baudrate );
+
+    bool passed = this->SetBaudrate( baudrate ) && this->SetLocalBaudrate( baudrate );
+
+    // Short timeout, a bad rate should fail fast.
+    this->SetTimeout( SERIALADAPTER_NEGOTIATE_TIMEOUT );
+    for( int check = 0; passed && check < SERIALADAPTER_NEGOTIATE_CHECKS; check++ ) {
+      // Adapter firmware ignores rates it can't do, so the reply also confirms the change was taken.
+      passed = this->RequestBaudrate() && m_baudrate == baudrate && this->GetType() && m_type == ADAPTER_TYPE_X360SK;
+    }
+    this->SetTimeout( SERIALADAPTER_DEFAULT_TIMEOUT );
+
+    if( passed ) {
+      MSG_SERIALADAPTER_INFO( "Baudrate raised to " << baudrate );
+      return true;
+    }
+
+    MSG_SERIALADAPTER_INFO( "Baudrate " << baudrate << " failed, falling back." );
+
+    if( !this->RecoverDefaultBaudrate() ) {
+      return false;
+    }
+  }
 
   return true;
 };
 
+// A reset puts the adapter back to its default rate.  It also resets itself on any receive error, so
+// this still works if the reset packet is garbled.
+bool SerialAdapter::RecoverDefaultBaudrate() {
+  this->Reset();
+  tcdrain( m_filedescriptor );
+
+  m_baudrate = SERIALADAPTER_DEFAULT_BAUDRATE_BPS;
+  if( !this->SetLocalBaudrate( m_baudrate ) ) {
+    return false;
+  }
+
+  bool recovered = false;
+
+  this->SetTimeout( SERIALADAPTER_NEGOTIATE_TIMEOUT );
+  for( int retry = 0; !recovered && retry < SERIALADAPTER_RESET_RETRIES; retry++ ) {
+    usleep( SERIALADAPTER_RESET_WAIT * 1000 );
+    tcflush( m_filedescriptor, TCIOFLUSH );
+    recovered = this->GetType() && m_type == ADAPTER_TYPE_X360SK;
+  }
+  this->SetTimeout( SERIALADAPTER_DEFAULT_TIMEOUT );
+
+  return recovered;
+};
+
+// Too many errors in a row at a raised rate, so close down & use a lower rate on the next Init.
+void SerialAdapter::LinkError() {
+  if( ++m_link_errors < SERIALADAPTER_LINK_ERROR_LIMIT || m_baudrate <= SERIALADAPTER_DEFAULT_BAUDRATE_BPS ) {
+    return;
+  }
+
+  m_baudrate_max = m_baudrate / 2;
+  if( m_baudrate_max < SERIALADAPTER_DEFAULT_BAUDRATE_BPS ) {
+    m_baudrate_max = SERIALADAPTER_DEFAULT_BAUDRATE_BPS;
+  }
+
+  MSG_SERIALADAPTER_ERROR( "Too many errors at baudrate " << m_baudrate << ".  Closing, next connection limited to " << m_baudrate_max );
+
+  this->Close();
+};
+
 int SerialAdapter::GetStatus() {
   m_header[ 0 ] = HEADER_STATUS;
   m_header[ 1 ] = 0x00;
@@ -393,6 +601,8 @@ bool SerialAdapter::SendInterruptReply( unsigned char* ptr_interrupt_reply, unsi
 };
 
 bool SerialAdapter::Poll() {
+  ALLOC_SCOPE( "serial" );
+
   if( m_filedescriptor == -1 ) {
     return false;
   }
@@ -406,10 +616,16 @@ bool SerialAdapter::Poll() {
       if( header_size == 2 ) {
         if( m_header[ 1 ] > 0 ) {
           m_payload_length = m_header[ 1 ];
-          this->Read( m_payload, m_payload_length );
+          if( this->Read( m_payload, m_payload_length ) != m_payload_length ) {
+            m_ptr_packets_dropped->Add();
+            this->LinkError();
+            return false;
+          }
+          m_link_errors = 0;
           if( m_header[ 0 ] == HEADER_START ) {
             MSG_SERIALADAPTER_INFO( "Adapter replied as started." );
           } else if( m_header[ 0 ] == HEADER_CONTROL_DATA || m_header[ 0 ] == HEADER_OUT_REPORT ) {
+            m_ptr_packets_received->Add();
             return true;
           }
         } else {
@@ -419,14 +635,22 @@ bool SerialAdapter::Poll() {
             std::cout << m_header[ 0 ] << " : " << m_header[ 1 ] << std::endl;
             std::cout << std::dec;
           }
+          m_ptr_packets_dropped->Add();
+          this->LinkError();
         }
       } else {
         if( !m_surpress_warnings ) {
           MSG_SERIALADAPTER_INFO( "*WARNING* Header size error! - No payload? : Size = " << header_size );
         }
+        m_ptr_packets_dropped->Add();
+        this->LinkError();
       }
     }
 
+    if( m_filedescriptor == -1 ) {
+      return false;
+    }
+
     if( m_poll_fds[ 0 ].revents & (POLLERR | POLLHUP | POLLNVAL) ) {
       // Error noted on file descriptor
       MSG_SERIALADAPTER_ERROR( "Polling issue.  Check adapter." );
@@ -1,14 +1,10 @@
 #ifndef _SERIALADAPTER_H_
 #define _SERIALADAPTER_H_
 
-#ifdef DEBUG
-  #define MSG_SERIALADAPTER_DEBUG( str ) do { std::cout << "SerialAdapter : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_SERIALADAPTER_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_SERIALADAPTER_DEBUG( str ) LOG_DEBUG( "SerialAdapter", str )
 
-#define MSG_SERIALADAPTER_ERROR( str ) do { std::cout << "SerialAdapter : ERROR : " << str << std::endl; } while( false )
-#define MSG_SERIALADAPTER_INFO( str ) do { std::cout << "SerialAdapter : INFO : " << str << std::endl; } while( false )
+#define MSG_SERIALADAPTER_ERROR( str ) LOG_ERROR( "SerialAdapter", str )
+#define MSG_SERIALADAPTER_INFO( str ) LOG_INFO( "SerialAdapter", str )
 
 #include <iostream>
 #include <unistd.h>
@@ -19,11 +15,26 @@
 #include <termios.h> // termio
 #include <sys/time.h> // timeval
 #include <poll.h> // poll
+#include <chrono> // reply deadline
+
+#include "helpers/AllocTracker.h"
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
 
 #define SERIALADAPTER_DEBUG 0
 
 #define SERIALADAPTER_DEFAULT_TIMEOUT 1000
+#define SERIALADAPTER_PROBE_TIMEOUT   250  // ms an adapter has to answer a probe
 #define SERIALADAPTER_DEFAULT_BAUDRATE B500000
+#define SERIALADAPTER_DEFAULT_BAUDRATE_BPS 500000
+#define SERIALADAPTER_BAUDRATE_MAX_BPS 2000000
+
+// Baudrate negotiation
+#define SERIALADAPTER_NEGOTIATE_TIMEOUT 100  // ms to wait on each reply while testing a new rate
+#define SERIALADAPTER_NEGOTIATE_CHECKS  8    // Round trips that must pass before a new rate is used
+#define SERIALADAPTER_RESET_WAIT        50   // ms to wait for the adapter to come back after a reset
+#define SERIALADAPTER_RESET_RETRIES     20
+#define SERIALADAPTER_LINK_ERROR_LIMIT  10   // Errors in a row before dropping to a lower rate
 
 #define HEADER_NO_PACKET    0x00
 #define HEADER_GET_TYPE     0x11
@@ -54,6 +65,16 @@ public:
 
   bool Init( const char* path, bool surpress_warnings );
 
+  // Quick check for an adapter on path, used to find which port it is on.
+  // Only asks for the adapter type, and closes without resetting, so a running adapter is left as it was.
+  bool Probe( const char* path, const int timeout_ms );
+
+  // Highest rate Init will try to raise the link to.  Rates above the default need adapter firmware support.
+  void SetBaudrateMax( const int baudrate );
+
+  // Rate the link is currently running at in bps.
+  int GetBaudrate();
+
   void Close();
 
   bool Poll();
@@ -79,6 +100,8 @@ public:
   int GetStatus();
 
 private:
+  bool Open( const char* path );
+
   int Read( unsigned char* buffer, unsigned int count );
 
   int Write( unsigned char* buffer, unsigned int count );
@@ -89,13 +112,26 @@ private:
 
   bool GetVersion();
 
-  bool GetBaudrate();
+  bool RequestBaudrate();
+
+  bool SetBaudrate( const int baudrate );
+
+  bool SetLocalBaudrate( const int baudrate );
+
+  bool NegotiateBaudrate();
+
+  bool RecoverDefaultBaudrate();
+
+  void SetTimeout( const int timeout_ms );
+
+  void LinkError();
 
   bool Reset();
 
   bool Start();
 
   struct timeval m_timeout;
+  int m_timeout_ms;
   int m_filedescriptor;
   unsigned char m_header[ 2 ]; // For debug - should be 2!
   unsigned char m_payload[ 255 ];
@@ -107,6 +143,8 @@ private:
   int m_version_major;
   int m_version_minor;
   int m_baudrate;
+  int m_baudrate_max;
+  int m_link_errors;
   int m_vid;
   int m_pid;
   int m_status;
@@ -115,6 +153,9 @@ private:
   struct pollfd m_poll_fds[ 1 ];
   int m_poll_timeout_msecs;
 
+  MetricCounter* m_ptr_packets_received;
+  MetricCounter* m_ptr_packets_dropped;  // Cut short or without a payload.
+
 };
 
 #endif
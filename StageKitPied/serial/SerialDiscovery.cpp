@@ -0,0 +1,155 @@
+#include "SerialDiscovery.h"
+
+SerialDiscovery::SerialDiscovery() {
+  m_is_searching    = false;
+  m_is_result_ready = false;
+};
+
+SerialDiscovery::~SerialDiscovery() {
+  this->Stop();
+};
+
+const std::vector<std::string>& SerialDiscovery::Ports() {
+  return m_ports;
+};
+
+void SerialDiscovery::AddPort( const std::string& path ) {
+  char device[ PATH_MAX ];
+
+  // Missing ports are skipped.
+  if( realpath( path.c_str(), device ) == NULL ) {
+    return;
+  }
+
+  for( const std::string& existing : m_devices ) {
+    if( existing == device ) {
+      return;
+    }
+  }
+
+  m_ports.push_back( path );
+  m_devices.push_back( device );
+};
+
+void SerialDiscovery::ScanPorts( const std::vector<std::string>& preferred ) {
+  m_ports.clear();
+  m_devices.clear();
+
+  for( const std::string& path : preferred ) {
+    if( !path.empty() ) {
+      this->AddPort( path );
+    }
+  }
+
+  static const char* patterns[] = SERIALDISCOVERY_PATTERNS;
+
+  for( const char* pattern : patterns ) {
+    glob_t found;
+    if( glob( pattern, 0, NULL, &found ) == 0 ) {
+      for( size_t index = 0; index < found.gl_pathc; index++ ) {
+        this->AddPort( found.gl_pathv[ index ] );
+      }
+    }
+    globfree( &found );
+  }
+
+  MSG_SERIALDISCOVERY_DEBUG( "Found " << m_ports.size() << " serial ports." );
+};
+
+std::string SerialDiscovery::FindAdapter( const int timeout_ms ) {
+  // Shared with the probes, which can outlive the call.
+  struct Probes {
+    std::mutex              lock;
+    std::condition_variable done;
+    std::string             found_port;
+    size_t                  probes_left;
+  };
+  std::shared_ptr<Probes> ptr_probes = std::make_shared<Probes>();
+  ptr_probes->probes_left = m_ports.size();
+
+  for( const std::string& port : m_ports ) {
+    std::thread( [ ptr_probes, port, timeout_ms ]() {
+      bool is_adapter;
+      {
+        // Closed before it's reported, so the port is free to connect to.
+        SerialAdapter adapter;
+        is_adapter = adapter.Probe( port.c_str(), timeout_ms );
+      }
+
+      std::lock_guard<std::mutex> lock( ptr_probes->lock );
+      if( is_adapter && ptr_probes->found_port.empty() ) {
+        ptr_probes->found_port = port;
+      }
+      ptr_probes->probes_left--;
+      ptr_probes->done.notify_all();
+    } ).detach();
+  }
+
+  std::string found_port;
+  {
+    // Every probe gives up by its timeout, the wait has one too in case one doesn't.
+    std::unique_lock<std::mutex> lock( ptr_probes->lock );
+    ptr_probes->done.wait_for( lock, std::chrono::milliseconds( timeout_ms * 2 ), [ &ptr_probes ]() {
+      return !ptr_probes->found_port.empty() || ptr_probes->probes_left == 0;
+    } );
+    found_port = ptr_probes->found_port;
+  }
+
+  if( found_port.empty() ) {
+    MSG_SERIALDISCOVERY_DEBUG( "No adapter answered on " << m_ports.size() << " ports." );
+  } else {
+    MSG_SERIALDISCOVERY_INFO( "Adapter answered on '" << found_port << "'" );
+  }
+
+  return found_port;
+};
+
+bool SerialDiscovery::StartSearch( const std::vector<std::string>& preferred, const int timeout_ms ) {
+  if( m_is_searching ) {
+    return false;
+  }
+
+  // Finished, so this doesn't wait.
+  if( m_thread.joinable() ) {
+    m_thread.join();
+  }
+
+  m_is_result_ready = false;
+  m_is_searching    = true;
+  m_thread = std::thread( &SerialDiscovery::Search, this, preferred, timeout_ms );
+
+  return true;
+};
+
+bool SerialDiscovery::TakeResult( std::string* ptr_port ) {
+  if( !m_is_result_ready ) {
+    return false;
+  }
+
+  *ptr_port = m_result;
+  m_is_result_ready = false;
+
+  return true;
+};
+
+void SerialDiscovery::Stop() {
+  if( m_thread.joinable() ) {
+    m_thread.join();
+  }
+
+  m_is_searching    = false;
+  m_is_result_ready = false;
+};
+
+void SerialDiscovery::Search( const std::vector<std::string> preferred, const int timeout_ms ) {
+  ALLOC_SCOPE( "serial" );
+
+  // Off the output CPU, it's started from the main loop.
+  Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+
+  this->ScanPorts( preferred );
+  m_result = this->FindAdapter( timeout_ms );
+
+  m_is_result_ready = true;
+  m_is_searching    = false;
+};
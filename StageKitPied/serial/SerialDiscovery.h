@@ -0,0 +1,69 @@
+#ifndef _SERIALDISCOVERY_H_
+#define _SERIALDISCOVERY_H_
+
+#define MSG_SERIALDISCOVERY_DEBUG( str ) LOG_DEBUG( "SerialDiscovery", str )
+
+#define MSG_SERIALDISCOVERY_ERROR( str ) LOG_ERROR( "SerialDiscovery", str )
+#define MSG_SERIALDISCOVERY_INFO( str ) LOG_INFO( "SerialDiscovery", str )
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <glob.h>   // glob
+#include <limits.h> // PATH_MAX
+#include <stdlib.h> // realpath
+
+#include "helpers/AllocTracker.h"
+#include "helpers/Log.h"
+#include "helpers/Realtime.h"
+#include "serial/SerialAdapter.h"
+
+// Where USB serial adapters show up.
+#define SERIALDISCOVERY_PATTERNS { "/dev/serial/by-id/*", "/dev/ttyUSB*", "/dev/ttyACM*" }
+
+class SerialDiscovery
+{
+public:
+  SerialDiscovery();
+
+  ~SerialDiscovery();
+
+  // Builds the port list.  Preferred ports go first, then any others found.  Links to the same device are dropped.
+  void ScanPorts( const std::vector<std::string>& preferred );
+
+  const std::vector<std::string>& Ports();
+
+  // Probes every port at the same time.  Returns the port that answered first, as soon as it does, or an empty
+  // string.  Takes at most timeout_ms, whatever the amount of ports.  Probes still going are left to time out.
+  std::string FindAdapter( const int timeout_ms );
+
+  // Scans & probes on its own thread, so the caller never waits on the ports.  False if a search is still running.
+  bool StartSearch( const std::vector<std::string>& preferred, const int timeout_ms );
+
+  // True once a search has finished, with the port that answered or an empty string.  Never blocks.
+  bool TakeResult( std::string* ptr_port );
+
+  void Stop();
+
+private:
+  void AddPort( const std::string& path );
+
+  void Search( const std::vector<std::string> preferred, const int timeout_ms );
+
+  std::vector<std::string> m_ports;
+  std::vector<std::string> m_devices; // Resolved paths of m_ports.
+
+  std::thread              m_thread;
+  std::atomic<bool>        m_is_searching;
+  std::atomic<bool>        m_is_result_ready;
+  std::string              m_result;  // Only touched by the search thread until m_is_result_ready.
+
+};
+
+#endif
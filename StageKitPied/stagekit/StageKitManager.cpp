@@ -16,7 +16,11 @@ StageKitManager::StageKitManager() {
   
   for( uint8_t stagekit_id = 0; stagekit_id < MAX_STAGEKITS_IN_EXISTENCE; stagekit_id++ ) {
     m_stagekit_config_number[ stagekit_id ] = 0;
+    m_stagekit[ stagekit_id ].SetMetricsID( stagekit_id );
   }  
+
+  m_ptr_stagekits_connected = Metrics::Gauge( "skp_stagekits_connected", "Stage kit pods connected over USB." );
+  m_ptr_fog_on_ms           = Metrics::Counter( "skp_fog_on_milliseconds_total", "Time the fog has been asked to be on." );
 };
 
 StageKitManager::~StageKitManager() {
@@ -85,6 +89,7 @@ uint8_t StageKitManager::Init() {
   } else {
     MSG_STAGEKITMANAGER_INFO( "Found [ " << +m_amount_of_stagekits << " ] Stage Kit(s) connected." );
   }
+  m_ptr_stagekits_connected->Set( m_amount_of_stagekits );
   
   return m_amount_of_stagekits;
 };
@@ -109,6 +114,7 @@ void StageKitManager::End() {
   }
   
   m_amount_of_stagekits = 0;
+  m_ptr_stagekits_connected->Set( 0 );
 };
 
 uint8_t StageKitManager::AmountOfStageKits() {
@@ -235,6 +241,10 @@ void StageKitManager::SetFog( const bool on ) {
   }
 };
 
+bool StageKitManager::IsFogOn() {
+  return m_fog_current_state_is_on;
+};
+
 bool StageKitManager::SetStatusLEDs( const uint8_t stagekit_id, const uint8_t status_value ) {
   if( this->IsConnected( stagekit_id ) ) {
     return m_stagekit[ stagekit_id ].UpdateStatusLEDs( status_value );
@@ -243,6 +253,10 @@ bool StageKitManager::SetStatusLEDs( const uint8_t stagekit_id, const uint8_t st
 };
 
 void StageKitManager::Handle_TimeUpdate( const long time_passed_ms ) {
+  if( m_fog_current_state_is_on ) {
+    m_ptr_fog_on_ms->Add( time_passed_ms );
+  }
+
   // Check instance time
   if( !m_fog_just_changed_to_off ) {
     m_fog_instance_time_current += time_passed_ms;
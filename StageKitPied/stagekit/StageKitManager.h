@@ -1,14 +1,10 @@
 #ifndef _STAGEKITMANAGER_H_
 #define _STAGEKITMANAGER_H_
 
-#ifdef DEBUG
-  #define MSG_STAGEKITMANAGER_DEBUG( str ) do { std::cout << "StageKitManager : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_STAGEKITMANAGER_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_STAGEKITMANAGER_DEBUG( str ) LOG_DEBUG( "StageKitManager", str )
 
-#define MSG_STAGEKITMANAGER_ERROR( str ) do { std::cout << "StageKitManager : ERROR : " << str << std::endl; } while( false )
-#define MSG_STAGEKITMANAGER_INFO( str ) do { std::cout << "StageKitManager : INFO : " << str << std::endl; } while( false )
+#define MSG_STAGEKITMANAGER_ERROR( str ) LOG_ERROR( "StageKitManager", str )
+#define MSG_STAGEKITMANAGER_INFO( str ) LOG_INFO( "StageKitManager", str )
 
 #define STAGEKIT_VID 0x0E6F
 #define STAGEKIT_PID 0x0103
@@ -17,6 +13,8 @@
 #include <iomanip>
 #include "libusb.h"
 
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
 #include "stagekit/USB_360StageKit.h"
 #include "stagekit/StageKitConfig.h"
 
@@ -74,6 +72,9 @@ public:
   void SetStrobe( const uint8_t speed ); // Speed = 0 - 4.  0 = Off.
 
   void SetFog( const bool on );
+
+  // As the stage kits were last told, false without any.
+  bool IsFogOn();
   
   void Handle_TimeUpdate( const long time_passed_ms );
   
@@ -92,6 +93,9 @@ private:
   long            m_fog_instance_time_current;
   long            m_fog_total_time_current;
 
+  MetricGauge*    m_ptr_stagekits_connected;
+  MetricCounter*  m_ptr_fog_on_ms;
+
 };
 
 #endif
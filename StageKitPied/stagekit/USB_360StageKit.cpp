@@ -4,6 +4,8 @@
 USB_360StageKit::USB_360StageKit() {
   m_ptr_usb_device_handle = NULL;
   m_ptr_stagekit_config   = NULL;
+  m_ptr_transfers         = NULL;
+  m_ptr_failures          = NULL;
 };
 
 USB_360StageKit::~USB_360StageKit() {
@@ -52,6 +54,12 @@ bool USB_360StageKit::Init( libusb_device_handle* ptr_usb_device_handle ) {
   return true;
 };
 
+void USB_360StageKit::SetMetricsID( const uint8_t stagekit_id ) {
+  const std::string labels = "kit=\"" + std::to_string( stagekit_id ) + "\"";
+  m_ptr_transfers = Metrics::Counter( "skp_usb_transfers_total", "USB control transfers, by stage kit.", labels );
+  m_ptr_failures  = Metrics::Counter( "skp_usb_failures_total", "USB control transfers that failed, by stage kit.", labels );
+};
+
 bool USB_360StageKit::IsConnected() {
   return ( m_ptr_usb_device_handle != NULL );
 };
@@ -69,6 +77,7 @@ int USB_360StageKit::Send( USB_ControlRequest* ptr_control_request, unsigned sho
                                    ptr_control_request->data,                   // report
                                    length,                                      // report_length
                                    USB_REQUEST_TIMEOUT );                       // 1000
+    this->CountTransfer( ret );
 
     if( ret == LIBUSB_ERROR_PIPE ) {
       libusb_clear_halt( m_ptr_usb_device_handle, 0 );
@@ -114,6 +123,7 @@ bool USB_360StageKit::PollButtons() {
                                      m_report_in,                                                             // pointer to data buffer
                                      STAGEKIT_MAX_INPUT_BUFFER,                                               // data buffer max size
                                      USB_REQUEST_TIMEOUT );
+  this->CountTransfer( ret );
 
   if( ret < 0 )
   {
@@ -309,6 +319,7 @@ bool USB_360StageKit::SetStatusLEDs( const uint8_t status_value ) {
                                       m_report_out,                                                            // pointer to data buffer
                                       3,                                                                       // data buffer size
                                       USB_REQUEST_TIMEOUT );
+    this->CountTransfer( retVal );
 
   };
 
@@ -340,6 +351,7 @@ bool USB_360StageKit::SetLights( const uint8_t left_weight, const uint8_t right_
                                       m_report_out,                                                            // pointer to data buffer
                                       8,                                                                       // data buffer size
                                       USB_REQUEST_TIMEOUT );
+    this->CountTransfer( retVal );
 
   };
 
@@ -383,6 +395,7 @@ bool USB_360StageKit::SetStrobe( const uint8_t speed ) {
                                       m_report_out,                                                            // pointer to data buffer
                                       8,                                                                       // data buffer size
                                       USB_REQUEST_TIMEOUT );
+    this->CountTransfer( retVal );
 
   };
 
@@ -414,8 +427,20 @@ bool USB_360StageKit::SetFog( const bool on ) {
                                       m_report_out,                                                             // pointer to data buffer
                                       8,                                                                        // data buffer size
                                       USB_REQUEST_TIMEOUT );
+    this->CountTransfer( retVal );
 
   };
 
   return ( retVal < 0 ) ? false : true;
 };
+
+void USB_360StageKit::CountTransfer( const int result ) {
+  if( m_ptr_transfers == NULL ) {
+    return;
+  }
+
+  m_ptr_transfers->Add();
+  if( result < 0 ) {
+    m_ptr_failures->Add();
+  }
+};
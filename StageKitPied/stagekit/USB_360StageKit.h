@@ -1,19 +1,17 @@
 #ifndef _USB_360STAGEKIT_H_
 #define _USB_360STAGEKIT_H_
 
-#ifdef DEBUG
-  #define MSG_USB360SK_DEBUG( str ) do { std::cout << "USB_360StageKit : DEBUG : " << str << std::endl; } while( false )
-#else
-  #define MSG_USB360SK_DEBUG( str ) do { } while ( false )
-#endif
+#define MSG_USB360SK_DEBUG( str ) LOG_DEBUG( "USB_360StageKit", str )
 
-#define MSG_USB360SK_ERROR( str ) do { std::cout << "USB_360StageKit : ERROR : " << str << std::endl; } while( false )
-#define MSG_USB360SK_INFO( str ) do { std::cout << "USB_360StageKit : INFO : " << str << std::endl; } while( false )
+#define MSG_USB360SK_ERROR( str ) LOG_ERROR( "USB_360StageKit", str )
+#define MSG_USB360SK_INFO( str ) LOG_INFO( "USB_360StageKit", str )
 
 
 #include <iostream>
 #include "libusb.h"
 
+#include "helpers/Log.h"
+#include "helpers/Metrics.h"
 #include "stagekit/USB_ControlRequest.h"
 #include "stagekit/StageKitConfig.h"
 #include "stagekit/StageKitConsts.h"
@@ -45,6 +43,9 @@ public:
 
   bool Init( libusb_device_handle* ptr_usb_device_handle );
 
+  // Labels this kit's USB metrics.  Until it's called transfers aren't counted.
+  void SetMetricsID( const uint8_t stagekit_id );
+
   bool IsConnected();
 
   int Send( USB_ControlRequest* ptr_control_request, unsigned short length );
@@ -77,6 +78,9 @@ private:
   bool SetStrobe( const uint8_t speed ); // Speed = 0 - 4.  0 - Off.
 
   bool SetFog( const bool on );
+
+  // Counts a libusb_control_transfer, failed if result is negative.
+  void CountTransfer( const int result );
   
   libusb_device_handle* m_ptr_usb_device_handle;
 
@@ -90,6 +94,8 @@ private:
   uint32_t m_buttonstate_old;
   uint16_t m_buttonstate_clicked;
 
+  MetricCounter* m_ptr_transfers;
+  MetricCounter* m_ptr_failures;
 };
 
 #endif
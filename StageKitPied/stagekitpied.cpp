@@ -4,12 +4,13 @@
 
 #include "helpers/SleepTimer.h"
 #include "helpers/ConsoleInput.h"
+#include "helpers/Log.h"
 #include "controller/RpiLightsController.h"
 
 #define INI_FILE "lights.ini"
 
-#define MSG_SKP_INFO( str ) do { std::cout << "StageKitPied : INFO : " << str << std::endl; } while( false )
-#define MSG_SKP_ERROR( str ) do { std::cout << "StageKitPied : ERROR : " << str << std::endl; } while( false )
+#define MSG_SKP_INFO( str ) LOG_INFO( "StageKitPied", str )
+#define MSG_SKP_ERROR( str ) LOG_ERROR( "StageKitPied", str )
 
 // *******
 // sigterm
@@ -35,6 +36,11 @@ int main(int arc, char *argv[]) {
   action.sa_handler = term;
   sigaction(SIGTERM, &action, NULL);
 
+  // Logging from here on is written out on its own thread, off the light loop.
+  if( !Log::Start() ) {
+    MSG_SKP_ERROR( "Unable to start the log thread, logging as it happens." );
+  }
+
   int pid = getpid();
 
   MSG_SKP_INFO( "Program started with PID = " << pid );
@@ -88,5 +94,7 @@ int main(int arc, char *argv[]) {
 
   MSG_SKP_INFO( "Program ended." );
 
+  Log::Stop();
+
   return 0;
 }
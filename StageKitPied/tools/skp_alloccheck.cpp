@@ -0,0 +1,180 @@
+/*
+ Allocation check.
+
+ Runs the steady state cue loop the way skp's RB3E mode does : stage kit & song packets in over UDP, then light
+ changes, strobes, fades & dithered frames drawn over two LED zones.  Once warmed up nothing in it should touch
+ the heap, so it fails listing what allocated, by subsystem.
+
+ Needs building with make ALLOC_TRACKING=1 (make clean first), see helpers/AllocTracker.h.
+
+ Usage : skp_alloccheck [led_amount] [frames] [port]
+         led_amount defaults to 4000, frames to 2000 & port to 21170.  Returns 0 if nothing allocated.
+*/
+
+#include <stdlib.h>
+#include <unistd.h>  // unlink
+#include <fstream>
+
+#include "helpers/AllocTracker.h"
+#include "leds/LEDArray.h"
+#include "leds/LEDOutputMemory.h"
+#include "leds/LEDZones.h"
+#include "network/RB3E_Network.h"
+#include "stagekit/StageKitConsts.h"
+
+#define MSG_ALLOCCHECK_INFO( str ) do { std::cout << "AllocCheck : INFO : " << str << std::endl; } while( false )
+#define MSG_ALLOCCHECK_ERROR( str ) do { std::cout << "AllocCheck : ERROR : " << str << std::endl; } while( false )
+
+#define ALLOCCHECK_INI_FILE    "/tmp/skp_alloccheck.ini"
+// The second zone's memory output keeps its last frames, in a ring that grows until it's full.
+#define ALLOCCHECK_WARM_FRAMES ( LEDOUTPUTMEMORY_FRAMES_DEFAULT + 200 )
+
+bool WriteIni( const int led_amount ) {
+  std::ofstream ini( ALLOCCHECK_INI_FILE, std::ios::trunc );
+  if( !ini ) {
+    return false;
+  }
+
+  ini << "[SK_COLOURS]\nRGB_RED=255,0,0\nRGB_GREEN=0,255,0\nRGB_BLUE=0,0,255\nRGB_YELLOW=255,255,0\nRGB_STROBE=255,255,255\n";
+  ini << "GAMMA=2.2\nBLEND_MODE=ADD\n\n";
+
+  static const char* colour_names[ LEDLAYOUT_COLOURS ] = { "RED", "GREEN", "BLUE", "YELLOW" };
+  const int group_leds = led_amount / ( LEDLAYOUT_COLOURS * LEDLAYOUT_GROUPS );
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      // Each colour's groups overlap the next colour's, so blending has work to do.
+      const int first = ( group * LEDLAYOUT_COLOURS + colour ) * group_leds + 1;
+      ini << "[" << colour_names[ colour ] << "_GROUP_" << group + 1 << "]\nBRIGHTNESS=12\n";
+      ini << "LEDS=" << first << "-" << std::min( first + group_leds * 2 - 1, led_amount ) << "\n\n";
+    }
+  }
+
+  ini << "[STROBE]\nBRIGHTNESS=15\nLEDS_ALL=1\n";
+
+  return ini.good();
+};
+
+// An RB3E event, as RB3Enhanced sends them.
+void SendEvent( const int socket_id, const sockaddr_in& address, const uint8_t type, const uint8_t* ptr_data, const uint8_t size ) {
+  RB3E_EventPacket packet;
+  packet.Header.ProtocolMagic   = htonl( RB3E_NETWORK_MAGICKEY );
+  packet.Header.ProtocolVersion = 0;
+  packet.Header.PacketType      = type;
+  packet.Header.PacketSize      = size;
+  packet.Header.Platform        = 0;
+  memcpy( packet.Data, ptr_data, size );
+
+  sendto( socket_id, &packet, sizeof( packet.Header ) + size, 0, (const sockaddr*)&address, sizeof( address ) );
+};
+
+// One pass of the main loop : packets in, light changes, then a frame if anything needs one.
+void Cue( const int frame, const int socket_id, const sockaddr_in& address, RB3E_Network* ptr_network, LEDZones* ptr_zones ) {
+  static const uint8_t sk_colours[ LEDLAYOUT_COLOURS ] = { SK_LED_RED, SK_LED_GREEN, SK_LED_BLUE, SK_LED_YELLOW };
+
+  RB3E_EventStagekit stagekit;
+  stagekit.LeftChannel  = ( frame * 37 ) & 0xFF;
+  stagekit.RightChannel = sk_colours[ frame & 3 ];
+  SendEvent( socket_id, address, RB3E_EVENT_STAGEKIT, (const uint8_t*)&stagekit, sizeof( stagekit ) );
+
+  // Songs change now & then, with names longer than fit in a std::string without allocating.
+  if( frame % 50 == 0 ) {
+    static const char song_name[] = "A Song Name Long Enough To Need Its Own Buffer, & Then Some";
+    SendEvent( socket_id, address, RB3E_EVENT_SONG_NAME, (const uint8_t*)song_name, sizeof( song_name ) - 1 + ( frame / 50 ) % 8 );
+    SendEvent( socket_id, address, RB3E_EVENT_SONG_ARTIST, (const uint8_t*)song_name, sizeof( song_name ) - 1 - ( frame / 50 ) % 8 );
+  }
+
+  while( ptr_network->Poll() ) {
+    if( ptr_network->EventWasStagekit() ) {
+      ptr_zones->SetLights( ptr_network->GetWeightRight(), ptr_network->GetWeightLeft() );
+    }
+  }
+
+  if( frame % 16 == 0 ) {
+    ptr_zones->Strobe( ( frame / 16 ) & 1 );
+  }
+
+  ptr_zones->Flush();
+  ptr_zones->IsAnimating();
+  ptr_zones->GetFrameIntervalMs();
+};
+
+int main( int argc, char *argv[] ) {
+  const int      led_amount = argc > 1 ? atoi( argv[ 1 ] ) : 4000;
+  const int      frames     = argc > 2 ? atoi( argv[ 2 ] ) : 2000;
+  const uint16_t port       = argc > 3 ? atoi( argv[ 3 ] ) : 21170;
+
+  if( led_amount < LEDLAYOUT_COLOURS * LEDLAYOUT_GROUPS * 2 || frames < 1 ) {
+    std::cout << "Usage : " << argv[ 0 ] << " [led_amount] [frames] [port]" << std::endl;
+    return 1;
+  }
+
+  if( !AllocTracker::IsEnabled() ) {
+    MSG_ALLOCCHECK_ERROR( "Allocation tracking isn't built in, make clean & make ALLOC_TRACKING=1 tools." );
+    return 1;
+  }
+
+  if( !WriteIni( led_amount ) ) {
+    MSG_ALLOCCHECK_ERROR( "Unable to write " << ALLOCCHECK_INI_FILE );
+    return 1;
+  }
+
+  // Everything skp can have on at once.
+  LEDArray leds;
+  if( !leds.Init( "MEMORY", "", led_amount ) || !leds.SetEnabled( true ) || !leds.LoadProfiles( { ALLOCCHECK_INI_FILE } ) || !leds.SelectProfile( 0 ) ) {
+    MSG_ALLOCCHECK_ERROR( "Unable to load " << ALLOCCHECK_INI_FILE << " into an LED array." );
+    return 1;
+  }
+  static_cast<LEDOutputMemory*>( leds.GetOutput() )->SetFramesMax( 0 );
+  leds.SetRemap( "1-" + std::to_string( led_amount - 2 ) + "/30,GAP2" );
+  leds.SetRenderThreads( 2 );
+
+  LEDZones zones;
+  zones.SetMain( &leds );
+  if( !zones.Add( "CHECK", "MEMORY", "", led_amount, ALLOCCHECK_INI_FILE, "", 0 ) ) {
+    MSG_ALLOCCHECK_ERROR( "Unable to add a second zone." );
+    return 1;
+  }
+  zones.SetFade( 200, 150, 400 );
+  zones.SetHighDepth( true );
+
+  std::string source_ip = "0.0.0.0";
+  RB3E_Network network;
+  if( !network.StartReceiver( source_ip, port ) ) {
+    MSG_ALLOCCHECK_ERROR( "Unable to listen on port " << port );
+    return 1;
+  }
+
+  const int socket_id = socket( AF_INET, SOCK_DGRAM, 0 );
+  sockaddr_in address;
+  memset( &address, 0, sizeof( address ) );
+  address.sin_family      = AF_INET;
+  address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+  address.sin_port        = htons( port );
+
+  // Anything sized on first use, such as a song name's buffer, is start up rather than steady state.
+  for( int frame = 0; frame < ALLOCCHECK_WARM_FRAMES; frame++ ) {
+    Cue( frame, socket_id, address, &network, &zones );
+  }
+
+  AllocTracker::Reset();
+  for( int frame = ALLOCCHECK_WARM_FRAMES; frame < ALLOCCHECK_WARM_FRAMES + frames; frame++ ) {
+    Cue( frame, socket_id, address, &network, &zones );
+  }
+  const uint64_t allocations = AllocTracker::GetAmount();
+
+  close( socket_id );
+  network.Stop();
+  unlink( ALLOCCHECK_INI_FILE );
+  unlink( ( std::string( ALLOCCHECK_INI_FILE ) + LEDLAYOUT_EXTENSION ).c_str() );
+
+  if( allocations > 0 ) {
+    MSG_ALLOCCHECK_ERROR( "FAIL : " << allocations << " allocations over " << frames << " steady state frames." );
+    AllocTracker::Report();
+    return 1;
+  }
+
+  MSG_ALLOCCHECK_INFO( "PASS : No allocations over " << frames << " steady state frames." );
+
+  return 0;
+};
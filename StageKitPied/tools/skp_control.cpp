@@ -0,0 +1,184 @@
+/*
+ Control socket client.
+
+ Sends one command to a running skp over its [CONTROL] socket & prints the reply.  cue with a count sends that many,
+ in batches, & reports how quickly skp took them, for load testing.
+
+ Usage : skp_control [-s socket] <command>
+         profile <number>            Switch the LEDs to INI<number>.
+         kit <stagekit> <config>     Set a stage kit's config, 0 is off.
+         cue <left> <right> [count]  Inject a cue, as the game sends them.  See SKRUMBLEDATA for right.
+         state                       Lights, profile & stage kit configs.
+         stats                       Metrics, in Prometheus text format.
+         recording                   Recent cues, oldest first.
+*/
+
+#include <stdlib.h>
+#include <algorithm>  // min
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "network/ControlSocket.h"
+
+#define MSG_CONTROL_INFO( str ) do { std::cout << "Control : INFO : " << str << std::endl; } while( false )
+#define MSG_CONTROL_ERROR( str ) do { std::cout << "Control : ERROR : " << str << std::endl; } while( false )
+
+#define CONTROL_SOCKET_DEFAULT "/tmp/skp_control.sock"
+#define CONTROL_REPLY_MAX      262144  // Stats are the longest reply, a few KB.
+#define CONTROL_TIMEOUT_S      2       // skp replies on its next pass of the main loop.
+
+static const char* status_names[] = { "OK", "Unknown command", "Bad length", "Failed" };
+
+static void Usage( const char* ptr_name ) {
+  std::cout << "Usage : " << ptr_name << " [-s socket] <profile N | kit STAGEKIT CONFIG | cue LEFT RIGHT [COUNT] | state | stats | recording>" << std::endl;
+};
+
+// Sends request & waits for its reply.  Returns the reply's data size, or -1.
+static long Send( const int descriptor, const std::vector<uint8_t>& request, std::vector<uint8_t>& reply ) {
+  if( send( descriptor, request.data(), request.size(), MSG_NOSIGNAL ) != (ssize_t)request.size() ) {
+    MSG_CONTROL_ERROR( "Send failed : " << strerror( errno ) );
+    return -1;
+  }
+
+  reply.resize( CONTROL_REPLY_MAX );
+  const ssize_t bytes = recv( descriptor, reply.data(), reply.size(), 0 );
+  if( bytes < 2 ) {
+    MSG_CONTROL_ERROR( "No reply : " << ( bytes == -1 ? strerror( errno ) : "closed" ) );
+    return -1;
+  }
+
+  if( reply[ 1 ] != CONTROL_STATUS_OK ) {
+    MSG_CONTROL_ERROR( ( reply[ 1 ] <= CONTROL_STATUS_FAILED ? status_names[ reply[ 1 ] ] : "Unknown status" ) );
+    return -1;
+  }
+
+  reply.resize( bytes );
+  reply.erase( reply.begin(), reply.begin() + 2 );
+  return reply.size();
+};
+
+int main( int argc, char *argv[] ) {
+  std::string socket_path = CONTROL_SOCKET_DEFAULT;
+  int arg = 1;
+
+  if( argc > 2 && strcmp( argv[ 1 ], "-s" ) == 0 ) {
+    socket_path = argv[ 2 ];
+    arg = 3;
+  }
+
+  if( arg >= argc ) {
+    Usage( argv[ 0 ] );
+    return 1;
+  }
+
+  const std::string command = argv[ arg ];
+  const int         values  = argc - arg - 1;
+  std::vector<uint8_t> request;
+  std::vector<uint8_t> reply;
+
+  sockaddr_un address;
+  memset( &address, 0, sizeof( address ) );
+  address.sun_family = AF_UNIX;
+  strncpy( address.sun_path, socket_path.c_str(), sizeof( address.sun_path ) - 1 );
+
+  const int descriptor = socket( AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0 );
+  if( descriptor == -1 || connect( descriptor, (sockaddr*)&address, sizeof( address ) ) == -1 ) {
+    MSG_CONTROL_ERROR( "Unable to connect to " << socket_path << " : " << strerror( errno ) << ".  Is [CONTROL] enabled?" );
+    return 1;
+  }
+
+  timeval timeout = { CONTROL_TIMEOUT_S, 0 };
+  setsockopt( descriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+
+  if( command == "profile" && values == 1 ) {
+    request = { CONTROL_COMMAND_SELECT_PROFILE, (uint8_t)atoi( argv[ arg + 1 ] ) };
+    if( Send( descriptor, request, reply ) < 0 ) {
+      return 1;
+    }
+
+  } else if( command == "kit" && values == 2 ) {
+    request = { CONTROL_COMMAND_SET_KIT_CONFIG, (uint8_t)atoi( argv[ arg + 1 ] ), (uint8_t)atoi( argv[ arg + 2 ] ) };
+    if( Send( descriptor, request, reply ) < 0 ) {
+      return 1;
+    }
+
+  } else if( command == "cue" && ( values == 2 || values == 3 ) ) {
+    const uint8_t left  = strtol( argv[ arg + 1 ], NULL, 0 );
+    const uint8_t right = strtol( argv[ arg + 2 ], NULL, 0 );
+    long count = values == 3 ? atol( argv[ arg + 3 ] ) : 1;
+    const long cues_total = count;
+    const long batch_max  = ( CONTROLSOCKET_MESSAGE_MAX - 1 ) / 2;
+
+    const std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+    while( count > 0 ) {
+      const long batch = std::min( count, batch_max );
+      request.assign( 1, CONTROL_COMMAND_CUE );
+      for( long cue = 0; cue < batch; cue++ ) {
+        request.push_back( left );
+        request.push_back( right );
+      }
+      if( Send( descriptor, request, reply ) < 0 ) {
+        return 1;
+      }
+      count -= batch;
+    }
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count();
+
+    if( cues_total > 1 ) {
+      MSG_CONTROL_INFO( cues_total << " cues taken in " << std::fixed << std::setprecision( 3 ) << seconds << " s, "
+                        << std::setprecision( 0 ) << cues_total / seconds << " a second." );
+    }
+
+  } else if( command == "state" && values == 0 ) {
+    request = { CONTROL_COMMAND_GET_STATE };
+    if( Send( descriptor, request, reply ) != sizeof( ControlState ) ) {
+      return 1;
+    }
+
+    ControlState state;
+    memcpy( &state, reply.data(), sizeof( state ) );
+
+    std::cout << "Profile   : INI" << +state.m_profile << " of " << +state.m_profile_amount << std::endl;
+    std::cout << "Red       : 0x" << std::hex << std::setfill( '0' ) << std::setw( 2 ) << +state.m_red << std::endl;
+    std::cout << "Green     : 0x" << std::setw( 2 ) << +state.m_green << std::endl;
+    std::cout << "Blue      : 0x" << std::setw( 2 ) << +state.m_blue << std::endl;
+    std::cout << "Yellow    : 0x" << std::setw( 2 ) << +state.m_yellow << std::dec << std::endl;
+    std::cout << "Strobe    : " << ( state.m_strobe_speed == 0 ? "Off" : "Speed " + std::to_string( state.m_strobe_speed ) ) << std::endl;
+    std::cout << "Fog       : " << ( state.m_fog_on ? "On" : "Off" ) << std::endl;
+    for( int stagekit_id = 0; stagekit_id < state.m_stagekit_amount && stagekit_id < 4; stagekit_id++ ) {
+      std::cout << "Stage kit : " << stagekit_id << " config " << +state.m_stagekit_config[ stagekit_id ] << std::endl;
+    }
+
+  } else if( command == "stats" && values == 0 ) {
+    request = { CONTROL_COMMAND_GET_STATS };
+    if( Send( descriptor, request, reply ) < 0 ) {
+      return 1;
+    }
+    std::cout.write( (const char*)reply.data(), reply.size() );
+
+  } else if( command == "recording" && values == 0 ) {
+    request = { CONTROL_COMMAND_GET_RECORDING };
+    if( Send( descriptor, request, reply ) < 0 ) {
+      return 1;
+    }
+
+    for( size_t offset = 0; offset + sizeof( ControlCueRecord ) <= reply.size(); offset += sizeof( ControlCueRecord ) ) {
+      ControlCueRecord record;
+      memcpy( &record, reply.data() + offset, sizeof( record ) );
+      std::cout << "-" << std::setw( 8 ) << std::setfill( ' ' ) << record.m_age_ms << " ms : left 0x" << std::hex << std::setfill( '0' )
+                << std::setw( 2 ) << +record.m_left_weight << " right 0x" << std::setw( 2 ) << +record.m_right_weight << std::dec << std::endl;
+    }
+
+  } else {
+    Usage( argv[ 0 ] );
+    return 1;
+  }
+
+  close( descriptor );
+
+  return 0;
+}
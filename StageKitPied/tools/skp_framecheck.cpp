@@ -0,0 +1,241 @@
+/*
+ Frame check.
+
+ Plays a fixed set of cues through a MEMORY LED array, on a clock of its own so fades come out the same every run :
+ overlapping colour groups blended with gamma & white balance, strobes, fades in & out, the sweep, then a remap &
+ high depth dithering switched on part way.  The frames drawn are compared with the known good ones in frames_file,
+ a recording as LEDOutputMemory writes them, & it fails listing the first frames that differ.
+
+ After a change that's meant to alter the frames, -w records frames_file afresh.  Check what changed before
+ committing it.
+
+ Usage : skp_framecheck [-w] [frames_file]
+         frames_file defaults to tools/framecheck.frames.  Returns 0 if every frame matched.
+*/
+
+#include <stdlib.h>
+#include <unistd.h>  // unlink
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include "leds/LEDArray.h"
+#include "leds/LEDOutputMemory.h"
+#include "stagekit/StageKitConsts.h"
+
+#define MSG_FRAMECHECK_INFO( str ) do { std::cout << "FrameCheck : INFO : " << str << std::endl; } while( false )
+#define MSG_FRAMECHECK_ERROR( str ) do { std::cout << "FrameCheck : ERROR : " << str << std::endl; } while( false )
+
+#define FRAMECHECK_INI_FILE    "/tmp/skp_framecheck.ini"
+#define FRAMECHECK_FRAMES_FILE "tools/framecheck.frames"
+#define FRAMECHECK_LEDS        136   // Two compositor blocks & a short one.
+#define FRAMECHECK_TICK_MS     10    // Main loop passes, at the fade frame rate.
+#define FRAMECHECK_TICKS       240
+#define FRAMECHECK_FRAMES_MAX  4096  // More than the cues draw.
+#define FRAMECHECK_REPORT_MAX  8     // Differing frames listed.
+
+#define FRAMECHECK_LIGHTS      0
+#define FRAMECHECK_STROBE      1
+#define FRAMECHECK_REMAP       2
+#define FRAMECHECK_HIGH_DEPTH  3
+
+struct FrameCheckCue
+{
+  int     m_tick;
+  uint8_t m_action;  // FRAMECHECK_
+  uint8_t m_value;   // Stage kit colour for lights, otherwise on or off.
+  uint8_t m_leds;
+};
+
+// In tick order.
+static const FrameCheckCue framecheck_cues[] = {
+  {   0, FRAMECHECK_LIGHTS,     SK_LED_RED,    0x0F },
+  {   0, FRAMECHECK_LIGHTS,     SK_LED_GREEN,  0x3C },
+  {  25, FRAMECHECK_LIGHTS,     SK_LED_BLUE,   0xF0 },
+  {  30, FRAMECHECK_STROBE,     1,             0 },
+  {  32, FRAMECHECK_STROBE,     0,             0 },
+  {  34, FRAMECHECK_STROBE,     1,             0 },
+  {  36, FRAMECHECK_STROBE,     0,             0 },
+  {  45, FRAMECHECK_LIGHTS,     SK_LED_RED,    0x00 },
+  {  45, FRAMECHECK_LIGHTS,     SK_LED_YELLOW, 0xFF },
+  {  60, FRAMECHECK_REMAP,      1,             0 },
+  {  80, FRAMECHECK_LIGHTS,     SK_ALL_OFF,    0 },
+  { 100, FRAMECHECK_HIGH_DEPTH, 1,             0 },
+  { 100, FRAMECHECK_LIGHTS,     SK_LED_RED,    0x81 },
+  { 100, FRAMECHECK_LIGHTS,     SK_LED_GREEN,  0x42 },
+  { 130, FRAMECHECK_STROBE,     1,             0 },
+  { 131, FRAMECHECK_STROBE,     0,             0 },
+  { 150, FRAMECHECK_LIGHTS,     SK_LED_BLUE,   0x18 },
+  { 180, FRAMECHECK_REMAP,      0,             0 },
+  { 200, FRAMECHECK_LIGHTS,     SK_ALL_OFF,    0 },
+};
+
+// Each colour's groups overlap the next colour's, so blending has work to do.  Changing this changes the frames.
+bool WriteIni() {
+  std::ofstream ini( FRAMECHECK_INI_FILE, std::ios::trunc );
+  if( !ini ) {
+    return false;
+  }
+
+  ini << "[POSITION_1]\nLEDS=1-68\nFROM=0,0,0\nTO=670,0,0\n\n";
+  ini << "[POSITION_2]\nLEDS=69-136\nFROM=670,10,0\nTO=0,10,0\n\n";
+
+  ini << "[SK_COLOURS]\nRGB_RED=255,0,0\nRGB_GREEN=0,255,0\nRGB_BLUE=0,0,255\nRGB_YELLOW=255,255,0\nRGB_STROBE=255,255,255\n";
+  ini << "GAMMA=2.2\nWHITE_BALANCE=100,90,80\nBLEND_MODE=ADD\n\n";
+
+  static const char* colour_names[ LEDLAYOUT_COLOURS ] = { "RED", "GREEN", "BLUE", "YELLOW" };
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      const int first = group * 17 + colour * 4 + 1;
+      ini << "[" << colour_names[ colour ] << "_GROUP_" << group + 1 << "]\nBRIGHTNESS=" << 15 - group << "\n";
+      ini << "LEDS=" << first << "-" << std::min( first + 16, FRAMECHECK_LEDS ) << "\n\n";
+    }
+  }
+
+  ini << "[SWEEP]\nAXIS=X\nWIDTH=150\nTIME_MS=1500\nRGB=255,128,0\nBRIGHTNESS=8\n\n";
+  ini << "[STROBE]\nBRIGHTNESS=15\nLEDS=1-20,60-80,120-136\n";
+
+  return ini.good();
+};
+
+// Frames in a recording, pixels only, the times it was made at don't matter.
+bool ReadFrames( const std::string& frames_file, std::vector< std::vector<Pixel> >* ptr_frames ) {
+  std::ifstream file( frames_file, std::ios::binary );
+  if( !file ) {
+    MSG_FRAMECHECK_ERROR( "Unable to open " << frames_file << ", -w records it." );
+    return false;
+  }
+
+  LEDOutputMemoryHeader header;
+  if( !file.read( (char*)&header, sizeof( header ) ) || header.m_magic != LEDOUTPUTMEMORY_MAGIC ||
+      header.m_version != LEDOUTPUTMEMORY_VERSION || header.m_led_amount != FRAMECHECK_LEDS ) {
+    MSG_FRAMECHECK_ERROR( frames_file << " isn't a recording of " << FRAMECHECK_LEDS << " LEDs." );
+    return false;
+  }
+  file.seekg( header.m_header_size );
+
+  ptr_frames->clear();
+  int64_t time_us;
+  std::vector<Pixel> pixels( FRAMECHECK_LEDS );
+  while( file.read( (char*)&time_us, sizeof( time_us ) ) ) {
+    if( !file.read( (char*)pixels.data(), pixels.size() * sizeof( Pixel ) ) ) {
+      MSG_FRAMECHECK_ERROR( frames_file << " ends part way through frame " << ptr_frames->size() << "." );
+      return false;
+    }
+    ptr_frames->push_back( pixels );
+  }
+
+  return true;
+};
+
+// One main loop pass a tick, cues then Flush.  Strobes draw straight away, as they do in skp.
+void PlayCues( LEDArray* ptr_leds ) {
+  const std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+  size_t cue = 0;
+
+  for( int tick = 0; tick < FRAMECHECK_TICKS; tick++ ) {
+    const std::chrono::steady_clock::time_point time_now = time_start + std::chrono::milliseconds( tick * FRAMECHECK_TICK_MS );
+
+    for( ; cue < sizeof( framecheck_cues ) / sizeof( FrameCheckCue ) && framecheck_cues[ cue ].m_tick == tick; cue++ ) {
+      const FrameCheckCue& frame_cue = framecheck_cues[ cue ];
+      switch( frame_cue.m_action ) {
+        case FRAMECHECK_LIGHTS:
+          ptr_leds->SetLights( frame_cue.m_value, frame_cue.m_leds );
+          break;
+        case FRAMECHECK_STROBE:
+          ptr_leds->Strobe( frame_cue.m_value, time_now );
+          break;
+        case FRAMECHECK_REMAP:
+          // A serpentine of 16 a row, then a corner.
+          ptr_leds->SetRemap( frame_cue.m_value ? "1-128/16,GAP2,129-134" : "" );
+          break;
+        case FRAMECHECK_HIGH_DEPTH:
+          ptr_leds->SetHighDepth( frame_cue.m_value );
+          break;
+      }
+    }
+
+    ptr_leds->Flush( time_now );
+  }
+};
+
+int main( int argc, char *argv[] ) {
+  bool is_writing = false;
+  int arg = 1;
+
+  if( argc > 1 && strcmp( argv[ 1 ], "-w" ) == 0 ) {
+    is_writing = true;
+    arg = 2;
+  }
+  if( argc > arg + 1 ) {
+    std::cout << "Usage : " << argv[ 0 ] << " [-w] [frames_file]" << std::endl;
+    return 1;
+  }
+  const std::string frames_file = argc > arg ? argv[ arg ] : FRAMECHECK_FRAMES_FILE;
+
+  std::vector< std::vector<Pixel> > expected_frames;
+  if( !is_writing && !ReadFrames( frames_file, &expected_frames ) ) {
+    return 1;
+  }
+
+  if( !WriteIni() ) {
+    MSG_FRAMECHECK_ERROR( "Unable to write " << FRAMECHECK_INI_FILE );
+    return 1;
+  }
+
+  // Writing, the memory output records straight to frames_file.
+  LEDArray leds;
+  if( !leds.Init( "MEMORY", is_writing ? frames_file : "", FRAMECHECK_LEDS ) || !leds.SetEnabled( true ) ||
+      !leds.LoadProfiles( { FRAMECHECK_INI_FILE } ) || !leds.SelectProfile( 0 ) ) {
+    MSG_FRAMECHECK_ERROR( "Unable to load " << FRAMECHECK_INI_FILE << " into an LED array." );
+    return 1;
+  }
+  LEDOutputMemory* ptr_output = static_cast<LEDOutputMemory*>( leds.GetOutput() );
+  ptr_output->SetFramesMax( FRAMECHECK_FRAMES_MAX );
+  leds.SetFade( 1000 / FRAMECHECK_TICK_MS, 150, 300 );
+
+  PlayCues( &leds );
+
+  // Closes the recording before the array turns off on its way out, which would be a frame more.
+  leds.SetEnabled( false );
+  unlink( FRAMECHECK_INI_FILE );
+  unlink( ( std::string( FRAMECHECK_INI_FILE ) + LEDLAYOUT_EXTENSION ).c_str() );
+
+  if( is_writing ) {
+    MSG_FRAMECHECK_INFO( "Recorded " << ptr_output->GetFramesSubmitted() << " frames to " << frames_file );
+    return 0;
+  }
+
+  const uint32_t frames = ptr_output->GetAmountFrames();
+  int frames_different = 0;
+
+  for( uint32_t index = 0; index < frames && index < expected_frames.size(); index++ ) {
+    const std::vector<Pixel>& pixels   = ptr_output->GetFrame( index ).m_pixels;
+    const std::vector<Pixel>& expected = expected_frames[ index ];
+    if( pixels == expected ) {
+      continue;
+    }
+
+    if( frames_different++ < FRAMECHECK_REPORT_MAX ) {
+      const size_t led = std::mismatch( expected.begin(), expected.end(), pixels.begin() ).first - expected.begin();
+      MSG_FRAMECHECK_ERROR( "Frame " << index << " LED " << led + 1 << " is 0x" << std::hex << std::setfill( '0' ) << std::setw( 8 )
+                            << pixels[ led ] << ", expected 0x" << std::setw( 8 ) << expected[ led ] << std::dec );
+    }
+  }
+
+  if( frames != expected_frames.size() ) {
+    MSG_FRAMECHECK_ERROR( "FAIL : Drew " << frames << " frames, expected " << expected_frames.size() << "." );
+    return 1;
+  }
+
+  if( frames_different > 0 ) {
+    MSG_FRAMECHECK_ERROR( "FAIL : " << frames_different << " of " << frames << " frames differ from " << frames_file << "." );
+    return 1;
+  }
+
+  MSG_FRAMECHECK_INFO( "PASS : " << frames << " frames match " << frames_file << "." );
+
+  return 0;
+};
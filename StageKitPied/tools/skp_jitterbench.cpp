@@ -0,0 +1,197 @@
+/*
+ Jitter bench.
+
+ Runs a frame loop like skp's, waking every period to draw a high depth frame into memory, first with normal
+ scheduling & then in realtime mode (see helpers/Realtime.h), & compares how late each wake up was.  Other
+ threads keep every CPU busy meanwhile, as a desktop or other services would.  Realtime mode needs root.
+
+ Usage : skp_jitterbench [led_amount] [frames] [period_us] [load_threads] [output_cpu]
+         led_amount defaults to 2000, frames to 2000, period_us to 5000, load_threads to one per CPU
+         & output_cpu to the last CPU.
+*/
+
+#include <stdlib.h>
+#include <time.h>    // clock_nanosleep
+#include <unistd.h>  // unlink
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "helpers/Realtime.h"
+#include "leds/LEDArray.h"
+#include "leds/LEDOutputMemory.h"
+
+#define MSG_JITTERBENCH_INFO( str ) do { std::cout << "JitterBench : INFO : " << str << std::endl; } while( false )
+#define MSG_JITTERBENCH_ERROR( str ) do { std::cout << "JitterBench : ERROR : " << str << std::endl; } while( false )
+
+#define JITTERBENCH_INI_FILE   "/tmp/skp_jitterbench.ini"
+#define JITTERBENCH_LOAD_BYTES ( 4 * 1024 * 1024 )  // Churned by each load thread, enough to push the frame out of cache.
+
+struct JitterResult
+{
+  long m_late_min_us;
+  long m_late_median_us;
+  long m_late_99_us;
+  long m_late_max_us;
+  long m_draw_max_us;
+  int  m_missed;       // Frames not drawn before the next was due.
+};
+
+std::atomic<bool> load_running( false );
+
+long long NowNs() {
+  timespec time_now;
+  clock_gettime( CLOCK_MONOTONIC, &time_now );
+  return (long long)time_now.tv_sec * 1000000000LL + time_now.tv_nsec;
+};
+
+// Busy work at normal priority, allocating & writing memory so the frame loop loses its cache & pages too.
+void Load() {
+  uint32_t realtime_generation = Realtime::GetGeneration();
+  Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+
+  while( load_running ) {
+    if( realtime_generation != Realtime::GetGeneration() ) {
+      realtime_generation = Realtime::GetGeneration();
+      Realtime::Apply( REALTIME_ROLE_HOUSEKEEPING );
+    }
+
+    std::vector<uint8_t> churn( JITTERBENCH_LOAD_BYTES );
+    for( size_t i = 0; i < churn.size(); i += 64 ) {
+      churn[ i ] = i;
+    }
+  }
+};
+
+bool WriteIni( const int led_amount ) {
+  std::ofstream ini( JITTERBENCH_INI_FILE, std::ios::trunc );
+  if( !ini ) {
+    return false;
+  }
+
+  ini << "[SK_COLOURS]\nRGB_RED=255,0,0\nRGB_GREEN=0,255,0\nRGB_BLUE=0,0,255\nRGB_YELLOW=255,255,0\nRGB_STROBE=255,255,255\n";
+  ini << "GAMMA=2.2\n\n";
+
+  static const char* colour_names[ LEDLAYOUT_COLOURS ] = { "RED", "GREEN", "BLUE", "YELLOW" };
+  const int colour_leds = led_amount / LEDLAYOUT_COLOURS;
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    ini << "[" << colour_names[ colour ] << "_GROUP_1]\nBRIGHTNESS=15\n";
+    ini << "LEDS=" << colour * colour_leds + 1 << "-" << ( colour + 1 ) * colour_leds << "\n\n";
+  }
+
+  ini << "[STROBE]\nBRIGHTNESS=15\nLEDS_ALL=1\n";
+
+  return ini.good();
+};
+
+JitterResult Run( LEDArray* ptr_leds, const int frames, const long period_us ) {
+  std::vector<long> late_us( frames );
+  JitterResult result;
+  result.m_draw_max_us = 0;
+  result.m_missed      = 0;
+
+  long long wake_ns = NowNs();
+
+  for( int frame = 0; frame < frames; frame++ ) {
+    wake_ns += period_us * 1000;
+
+    timespec wake;
+    wake.tv_sec  = wake_ns / 1000000000LL;
+    wake.tv_nsec = wake_ns % 1000000000LL;
+    while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL ) != 0 ) {
+    }
+
+    const long long woke_ns = NowNs();
+    ptr_leds->Render( frame & 0xFF, ~frame & 0xFF, ( frame >> 2 ) & 0xFF, ( frame >> 4 ) & 0xFF );
+    const long long drawn_ns = NowNs();
+
+    late_us[ frame ] = ( woke_ns - wake_ns ) / 1000;
+    result.m_draw_max_us = std::max<long>( result.m_draw_max_us, ( drawn_ns - woke_ns ) / 1000 );
+    if( drawn_ns - wake_ns > period_us * 1000 ) {
+      result.m_missed++;
+      // Start again from now rather than rush to catch up.
+      wake_ns = drawn_ns;
+    }
+  }
+
+  std::sort( late_us.begin(), late_us.end() );
+  result.m_late_min_us    = late_us.front();
+  result.m_late_median_us = late_us[ frames / 2 ];
+  result.m_late_99_us     = late_us[ std::min( frames - 1, frames * 99 / 100 ) ];
+  result.m_late_max_us    = late_us.back();
+
+  return result;
+};
+
+void Report( const char* mode, const JitterResult& result, const int frames ) {
+  MSG_JITTERBENCH_INFO( "  " << mode << " : late min " << result.m_late_min_us << " us, median " << result.m_late_median_us
+                        << " us, 99% " << result.m_late_99_us << " us, max " << result.m_late_max_us << " us : draw max "
+                        << result.m_draw_max_us << " us : missed " << result.m_missed << " of " << frames );
+};
+
+int main( int argc, char *argv[] ) {
+  const int  led_amount   = argc > 1 ? atoi( argv[ 1 ] ) : 2000;
+  const int  frames       = argc > 2 ? atoi( argv[ 2 ] ) : 2000;
+  const long period_us    = argc > 3 ? atol( argv[ 3 ] ) : 5000;
+  const int  load_threads = argc > 4 ? atoi( argv[ 4 ] ) : Realtime::GetAmountCPUs();
+  const int  output_cpu   = argc > 5 ? atoi( argv[ 5 ] ) : Realtime::GetAmountCPUs() - 1;
+
+  if( led_amount < LEDLAYOUT_COLOURS || frames < 1 || period_us < 1 || load_threads < 0 ) {
+    std::cout << "Usage : " << argv[ 0 ] << " [led_amount] [frames] [period_us] [load_threads] [output_cpu]" << std::endl;
+    return 1;
+  }
+
+  if( !WriteIni( led_amount ) ) {
+    MSG_JITTERBENCH_ERROR( "Unable to write " << JITTERBENCH_INI_FILE );
+    return 1;
+  }
+
+  LEDArray leds;
+  if( !leds.Init( "MEMORY", "", led_amount ) || !leds.SetEnabled( true ) || !leds.LoadProfiles( { JITTERBENCH_INI_FILE } ) || !leds.SelectProfile( 0 ) ) {
+    MSG_JITTERBENCH_ERROR( "Unable to load " << JITTERBENCH_INI_FILE << " into an LED array." );
+    return 1;
+  }
+  static_cast<LEDOutputMemory*>( leds.GetOutput() )->SetFramesMax( 0 );
+  leds.SetHighDepth( true );
+
+  load_running = true;
+  std::vector<std::thread> loads;
+  for( int thread = 0; thread < load_threads; thread++ ) {
+    loads.push_back( std::thread( Load ) );
+  }
+
+  const JitterResult normal = Run( &leds, frames, period_us );
+
+  RealtimeSettings settings;
+  settings.m_enabled    = true;
+  settings.m_output_cpu = output_cpu;
+  Realtime::Set( settings );
+  Realtime::UpdateMemoryLock();
+  const bool is_realtime = Realtime::Apply( REALTIME_ROLE_MAIN );
+  if( !is_realtime ) {
+    MSG_JITTERBENCH_ERROR( "Realtime scheduling not allowed, run as root.  Realtime below is only pinned." );
+  }
+
+  const JitterResult realtime = Run( &leds, frames, period_us );
+
+  load_running = false;
+  for( std::thread& load : loads ) {
+    load.join();
+  }
+
+  Realtime::Set( RealtimeSettings() );
+  Realtime::UpdateMemoryLock();
+  Realtime::Apply( REALTIME_ROLE_MAIN );
+
+  MSG_JITTERBENCH_INFO( led_amount << " LEDs every " << period_us << " us, " << frames << " frames, " << load_threads
+                        << " load threads, " << Realtime::GetAmountCPUs() << " CPUs :" );
+  Report( "Normal  ", normal, frames );
+  Report( "Realtime", realtime, frames );
+
+  unlink( JITTERBENCH_INI_FILE );
+
+  return 0;
+};
@@ -0,0 +1,405 @@
+/*
+ LED layout bench.
+
+ Builds a leds ini for a large rig, with each colour group a couple of long LED ranges, then times compiling,
+ mapping & rendering it through LEDArray.  The LED device isn't opened, so render times are the buffer fill only.
+ Then draws the same cues on 1, 2 & 4 render threads, with & without a remap & high depth, & fails if sharding
+ changed any frame.
+
+ Usage : skp_layoutbench [led_amount] [frames] [ini_file]
+         led_amount defaults to 12000, frames to 10000 & ini_file to /tmp/skp_layoutbench.ini
+         Returns 1 if the threaded frames don't match the 1 thread ones.
+*/
+
+#include <stdlib.h>
+#include <algorithm>  // mismatch
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#include "leds/ColourCorrection.h"
+#include "leds/LEDArray.h"
+#include "leds/LEDLayout.h"
+#include "leds/LEDOutputMemory.h"
+#include "leds/LEDRemap.h"
+#include "leds/LEDSpatialIndex.h"
+#include "leds/LEDZones.h"
+#include "leds/SPIPixelOutput.h"
+#include "leds/WS2812.h"
+
+#define MSG_LAYOUTBENCH_INFO( str ) do { std::cout << "LayoutBench : INFO : " << str << std::endl; } while( false )
+#define MSG_LAYOUTBENCH_ERROR( str ) do { std::cout << "LayoutBench : ERROR : " << str << std::endl; } while( false )
+
+#define LAYOUTBENCH_CHECK_FRAMES 200  // Frames kept from each run of the sharding check.
+
+typedef std::chrono::steady_clock Clock;
+
+long MicrosecondsSince( const Clock::time_point time_start ) {
+  return std::chrono::duration_cast<std::chrono::microseconds>( Clock::now() - time_start ).count();
+};
+
+// 32 colour groups each get two ranges, split over 3/4 of the LEDs.  The rest are left to LEDS_AUTO strobe.
+// The LEDs are placed in rows of 100, 10 units apart, for the spatial queries.
+bool WriteIni( const std::string& ini_file, const int led_amount ) {
+  std::ofstream ini( ini_file, std::ios::trunc );
+  if( !ini ) {
+    return false;
+  }
+
+  for( int row = 0; row * 100 < led_amount; row++ ) {
+    ini << "[POSITION_" << row + 1 << "]\n";
+    ini << "LEDS=" << row * 100 + 1 << "-" << std::min( row * 100 + 100, led_amount ) << "\n";
+    ini << "FROM=0," << row * 10 << ",0\nTO=990," << row * 10 << ",0\n\n";
+  }
+
+  ini << "[SK_COLOURS]\n";
+  ini << "RGB_RED=255,0,0\nRGB_GREEN=0,255,0\nRGB_BLUE=0,0,255\nRGB_YELLOW=255,255,0\nRGB_STROBE=255,255,255\n\n";
+
+  static const char* colour_names[ LEDLAYOUT_COLOURS ] = { "RED", "GREEN", "BLUE", "YELLOW" };
+
+  const int groups     = LEDLAYOUT_COLOURS * LEDLAYOUT_GROUPS;
+  const int group_leds = ( led_amount * 3 / 4 ) / groups;
+  int led_number = 1;
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      const int first_half = group_leds / 2;
+      ini << "[" << colour_names[ colour ] << "_GROUP_" << group + 1 << "]\n";
+      ini << "BRIGHTNESS=15\n";
+      ini << "LEDS=" << led_number << "-" << led_number + first_half - 1 << ","
+                     << led_number + group_leds - 1 << "-" << led_number + first_half << "\n\n";
+      led_number += group_leds;
+    }
+  }
+
+  ini << "[STROBE]\nBRIGHTNESS=15\nLEDS_ALL=0\nLEDS_AUTO=1\n";
+
+  return ini.good();
+};
+
+// The same cues each time, straight drawn so the frames don't depend on timing.  The memory output's frames are
+// copied to ptr_frames, in strip order.
+bool DrawCheckFrames( const std::string& ini_file, const int led_amount, const int threads, const bool is_remapped,
+                      const bool is_high_depth, std::vector< std::vector<Pixel> >* ptr_frames ) {
+  LEDArray leds;
+  if( !leds.Init( "MEMORY", "", led_amount ) || !leds.SetEnabled( true ) || !leds.LoadProfiles( { ini_file } ) || !leds.SelectProfile( 0 ) ) {
+    return false;
+  }
+  LEDOutputMemory* ptr_output = static_cast<LEDOutputMemory*>( leds.GetOutput() );
+  ptr_output->SetFramesMax( LAYOUTBENCH_CHECK_FRAMES );
+
+  leds.SetRenderThreads( threads );
+  if( is_remapped ) {
+    leds.SetRemap( "1-" + std::to_string( led_amount - 2 ) + "/30,GAP2" );
+  }
+  leds.SetHighDepth( is_high_depth );
+
+  for( int frame = 0; frame < LAYOUTBENCH_CHECK_FRAMES; frame++ ) {
+    if( frame % 8 == 7 ) {
+      leds.Strobe( frame & 8 );
+    } else {
+      leds.Render( frame * 37 & 0xFF, ~frame & 0xFF, ( frame >> 2 ) & 0xFF, frame * 11 & 0xFF );
+    }
+  }
+
+  ptr_frames->clear();
+  for( uint32_t index = 0; index < ptr_output->GetAmountFrames(); index++ ) {
+    ptr_frames->push_back( ptr_output->GetFrame( index ).m_pixels );
+  }
+
+  return true;
+};
+
+int main( int argc, char *argv[] ) {
+  const int led_amount = argc > 1 ? atoi( argv[ 1 ] ) : 12000;
+  const int frames     = argc > 2 ? atoi( argv[ 2 ] ) : 10000;
+  const std::string ini_file = argc > 3 ? argv[ 3 ] : "/tmp/skp_layoutbench.ini";
+  const std::string layout_file = ini_file + LEDLAYOUT_EXTENSION;
+
+  if( led_amount < LEDLAYOUT_COLOURS * LEDLAYOUT_GROUPS * 2 || frames < 1 ) {
+    std::cout << "Usage : " << argv[ 0 ] << " [led_amount] [frames] [ini_file]" << std::endl;
+    return 1;
+  }
+
+  if( !WriteIni( ini_file, led_amount ) ) {
+    MSG_LAYOUTBENCH_ERROR( "Unable to write " << ini_file );
+    return 1;
+  }
+  unlink( layout_file.c_str() );
+
+  // Compile & map.
+  LEDLayout layout;
+
+  Clock::time_point time_start = Clock::now();
+  if( !layout.Compile( ini_file, led_amount ) ) {
+    MSG_LAYOUTBENCH_ERROR( "Unable to compile " << ini_file );
+    return 1;
+  }
+  const long compile_us = MicrosecondsSince( time_start );
+
+  if( !layout.Save( layout_file ) ) {
+    MSG_LAYOUTBENCH_ERROR( "Unable to write " << layout_file );
+    return 1;
+  }
+
+  time_start = Clock::now();
+  if( !layout.Map( layout_file, ini_file, led_amount ) ) {
+    MSG_LAYOUTBENCH_ERROR( "Written layout failed to map back in." );
+    return 1;
+  }
+  const long map_us = MicrosecondsSince( time_start );
+
+  uint32_t grouped_leds = 0;
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      grouped_leds += layout.GetGroup( colour, group ).m_amount;
+    }
+  }
+
+  MSG_LAYOUTBENCH_INFO( "LEDs " << led_amount << " : In colour groups " << grouped_leds << " : Strobe " << layout.GetStrobe().m_amount );
+  MSG_LAYOUTBENCH_INFO( "Layout " << layout.GetSize() << " bytes : Compile " << compile_us << " us : Map " << map_us << " us" );
+
+  // Area effects, a band sweeping across the stage & a pulse growing from the middle, each lighting what they find.
+  LEDSpatialIndex spatial_index;
+  time_start = Clock::now();
+  spatial_index.Build( layout.GetPositions(), led_amount );
+  const long index_us = MicrosecondsSince( time_start );
+
+  std::vector<Pixel> area_frame( led_amount );
+  std::vector<int32_t> area_leds;
+  uint64_t band_found = 0;
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    const int32_t* band_leds;
+    const float band_x = frame % 1000;
+    const uint32_t amount = spatial_index.Band( LEDLAYOUT_AXIS_X, band_x, band_x + 50, &band_leds );
+    for( uint32_t i = 0; i < amount; i++ ) {
+      area_frame[ band_leds[ i ] - 1 ] = 0xFFFFFF1F;
+    }
+    band_found += amount;
+  }
+  const long band_us = MicrosecondsSince( time_start );
+
+  const float pulse_centre[ LEDLAYOUT_AXES ] = { 500, (float)( led_amount / 100 ) * 5, 0 };
+  uint64_t sphere_found = 0;
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    area_leds.clear();
+    spatial_index.Sphere( pulse_centre, frame % 200, &area_leds );
+    for( const int32_t led_number : area_leds ) {
+      area_frame[ led_number - 1 ] = 0xFF00001F;
+    }
+    sphere_found += area_leds.size();
+  }
+  const long sphere_us = MicrosecondsSince( time_start );
+
+  MSG_LAYOUTBENCH_INFO( "Spatial index of " << spatial_index.GetAmountLEDS() << " LEDs built in " << index_us << " us, per frame :" );
+  MSG_LAYOUTBENCH_INFO( "  Band sweep            : " << (double)band_us / frames << " us (" << band_found / frames << " LEDs)" );
+  MSG_LAYOUTBENCH_INFO( "  Radial pulse          : " << (double)sphere_us / frames << " us (" << sphere_found / frames << " LEDs)" );
+
+  layout.Close();
+
+  // Render into memory, so frames are really submitted without needing LEDs.
+  LEDArray leds;
+  if( !leds.Init( "MEMORY", "", led_amount ) || !leds.SetEnabled( true ) || !leds.LoadProfiles( { ini_file } ) || !leds.SelectProfile( 0 ) ) {
+    MSG_LAYOUTBENCH_ERROR( "Unable to load the layout into an LED array." );
+    return 1;
+  }
+  LEDOutputMemory* ptr_output = static_cast<LEDOutputMemory*>( leds.GetOutput() );
+  ptr_output->SetFramesMax( 1 );
+
+  static const uint8_t sk_colours[ LEDLAYOUT_COLOURS ] = { SK_LED_RED, SK_LED_GREEN, SK_LED_BLUE, SK_LED_YELLOW };
+
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    leds.SetLights( sk_colours[ frame & 3 ], frame & 0xFF );
+    leds.Flush();
+  }
+  const long lights_us = MicrosecondsSince( time_start );
+
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    leds.Render( frame & 0xFF, ~frame & 0xFF, ( frame >> 2 ) & 0xFF, ( frame >> 4 ) & 0xFF );
+  }
+  const long render_us = MicrosecondsSince( time_start );
+
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    leds.Strobe( frame & 1 );
+  }
+  const long strobe_us = MicrosecondsSince( time_start );
+
+  // The same light changes over 4 zones of this size, drawn on the worker pool.
+  LEDZones zones;
+  zones.SetMain( &leds );
+  for( int zone = 1; zone < 4; zone++ ) {
+    zones.Add( "BENCH_" + std::to_string( zone ), "MEMORY", "", led_amount, ini_file, "", 0 );
+  }
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    zones.SetLights( sk_colours[ frame & 3 ], frame & 0xFF );
+    zones.Flush();
+  }
+  const long zones_us = MicrosecondsSince( time_start );
+
+  // Every group part way through a long fade, drawn as often as Flush allows.
+  leds.Strobe( false );
+  leds.SetFade( 1000000, 60 * 1000, 60 * 1000 );
+  leds.Render( 0xFF, 0xFF, 0xFF, 0xFF );
+  int fade_frames = 0;
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    fade_frames += leds.Flush() ? 1 : 0;
+  }
+  const long fade_us = MicrosecondsSince( time_start );
+
+  // Every group lit & held, only the dither frames left to draw.
+  leds.SetFade( 1000000, 0, 0 );
+  leds.SetHighDepth( true );
+  leds.Render( 0x55, 0xAA, 0x0F, 0xF0 );
+  int dither_frames = 0;
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    dither_frames += leds.Flush() ? 1 : 0;
+  }
+  const long dither_us = MicrosecondsSince( time_start );
+
+  // Whole high depth frames, correction, dithering & encoding sharded over more & more render threads.
+  // Efficiency is the 1 thread time over threads times the time, 100% when each thread adds a full core.
+  const int thread_steps = std::max( 4u, std::thread::hardware_concurrency() );
+  std::vector<long> sharded_us;
+  std::vector<int>  shard_amounts;
+  for( int threads = 1; threads <= thread_steps; threads *= 2 ) {
+    leds.SetRenderThreads( threads );
+    time_start = Clock::now();
+    for( int frame = 0; frame < frames; frame++ ) {
+      leds.Render( frame & 0xFF, ~frame & 0xFF, ( frame >> 2 ) & 0xFF, ( frame >> 4 ) & 0xFF );
+    }
+    sharded_us.push_back( MicrosecondsSince( time_start ) );
+    shard_amounts.push_back( leds.GetAmountShards() );
+  }
+  leds.SetRenderThreads( 1 );
+  leds.SetHighDepth( false );
+
+  // Gamma & a mixing colour matrix over a frame with every LED lit.
+  static const int16_t colour_matrix[ 3 ][ 3 ] = { { 240, 16, 0 }, { 8, 230, 8 }, { 0, 16, 200 } };
+  ColourCorrection colour_correction;
+  colour_correction.Set( 22, colour_matrix );
+  std::vector<Pixel> corrected_frame( led_amount );
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    std::fill( corrected_frame.begin(), corrected_frame.end(), PixelPack( frame, ~frame, frame >> 2, 31 ) );
+    colour_correction.Apply( corrected_frame.data(), led_amount );
+  }
+  const long correction_us = MicrosecondsSince( time_start );
+
+  // SK6812 RGBW SPI encoding with every LED a different colour, so no runs to copy.
+  WS2812 ws2812( true );
+  ws2812.Init( led_amount, "" );
+  for( int led = 0; led < led_amount; led++ ) {
+    corrected_frame[ led ] = PixelPack( led, led >> 1, ~led, 31 - ( led & 7 ) );
+  }
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    ws2812.SetPixels( corrected_frame.data() );
+  }
+  const long ws2812_us = MicrosecondsSince( time_start );
+
+  // SK9822 8 bit encoding, the usual path.
+  SPIPixelOutput< PixelFormatSK9822< PIXEL_ORDER_BGR > > sk9822;
+  sk9822.Init( led_amount, "" );
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    sk9822.SetPixels( corrected_frame.data() );
+  }
+  const long sk9822_us = MicrosecondsSince( time_start );
+
+  // Serpentine wiring in rows of 30 with a gap at the end, gathered into strip order.
+  LEDRemap remap;
+  remap.Set( "1-" + std::to_string( led_amount - 2 ) + "/30,GAP2", led_amount );
+  std::vector<Pixel> strip_frame( led_amount );
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    remap.Gather( corrected_frame.data(), strip_frame.data() );
+  }
+  const long remap_us = MicrosecondsSince( time_start );
+
+  // HD108 16 bit encoding, the high depth path for those LEDs.
+  SPIPixelOutput< PixelFormatHD108< PIXEL_ORDER_RGB > > hd108;
+  hd108.Init( led_amount, "" );
+  std::vector<uint16_t> colour16( led_amount * 3 );
+  for( int i = 0; i < led_amount * 3; i++ ) {
+    colour16[ i ] = i * 97;
+  }
+  time_start = Clock::now();
+  for( int frame = 0; frame < frames; frame++ ) {
+    hd108.SetPixels16( colour16.data() );
+  }
+  const long hd108_us = MicrosecondsSince( time_start );
+
+  MSG_LAYOUTBENCH_INFO( "Per frame over " << frames << " frames, " << ptr_output->GetFramesSubmitted() << " submitted :" );
+  MSG_LAYOUTBENCH_INFO( "  SetLights & Flush     : " << (double)lights_us / frames << " us" );
+  MSG_LAYOUTBENCH_INFO( "  4 zones, Flush        : " << (double)zones_us / frames << " us (" << std::thread::hardware_concurrency() << " CPUs)" );
+  MSG_LAYOUTBENCH_INFO( "  Render, all colours   : " << (double)render_us / frames << " us" );
+  MSG_LAYOUTBENCH_INFO( "  Strobe                : " << (double)strobe_us / frames << " us" );
+  MSG_LAYOUTBENCH_INFO( "  Fade, all colours     : " << (double)fade_us / ( fade_frames > 0 ? fade_frames : 1 ) << " us" );
+  MSG_LAYOUTBENCH_INFO( "  High depth dither     : " << (double)dither_us / ( dither_frames > 0 ? dither_frames : 1 ) << " us (" << dither_frames << " frames)" );
+  for( size_t step = 0; step < sharded_us.size(); step++ ) {
+    const int    threads = 1 << step;
+    const double speedup = (double)sharded_us[ 0 ] / ( sharded_us[ step ] > 0 ? sharded_us[ step ] : 1 );
+    MSG_LAYOUTBENCH_INFO( "  High depth, " << threads << " thread" << ( threads > 1 ? "s" : " " ) << " : "
+                          << (double)sharded_us[ step ] / frames << " us : " << shard_amounts[ step ] << " shards, "
+                          << speedup << "x, " << (int)( speedup * 100 / threads ) << "% efficient" );
+  }
+  MSG_LAYOUTBENCH_INFO( "  Colour correction     : " << (double)correction_us / frames << " us (every LED lit, includes the fill)" );
+  MSG_LAYOUTBENCH_INFO( "  SK6812 RGBW encode    : " << (double)ws2812_us / frames << " us (every LED different) : "
+                        << ws2812.GetFrameSize() << " SPI bytes, " << ws2812.GetFrameTimeUs() << " us to send" );
+  MSG_LAYOUTBENCH_INFO( "  SK9822 encode         : " << (double)sk9822_us / frames << " us : "
+                        << sk9822.GetFrameSize() << " SPI bytes, " << sk9822.GetFrameTimeUs() << " us to send" );
+  MSG_LAYOUTBENCH_INFO( "  Serpentine remap      : " << (double)remap_us / frames << " us" );
+  MSG_LAYOUTBENCH_INFO( "  HD108 16 bit encode   : " << (double)hd108_us / frames << " us : "
+                        << hd108.GetFrameSize() << " SPI bytes, " << hd108.GetFrameTimeUs() << " us to send" );
+
+  // Sharding only splits the work, every frame has to come out as it does on 1 thread.
+  static const int check_threads[] = { 2, 4 };
+  std::vector< std::vector<Pixel> > single_frames;
+  std::vector< std::vector<Pixel> > sharded_frames;
+  int mismatches = 0;
+
+  MSG_LAYOUTBENCH_INFO( "Sharding check, " << LAYOUTBENCH_CHECK_FRAMES << " frames against 1 thread :" );
+  for( int is_remapped = 0; is_remapped < 2; is_remapped++ ) {
+    for( int is_high_depth = 0; is_high_depth < 2; is_high_depth++ ) {
+      if( !DrawCheckFrames( ini_file, led_amount, 1, is_remapped, is_high_depth, &single_frames ) ) {
+        MSG_LAYOUTBENCH_ERROR( "Unable to load the layout into an LED array." );
+        return 1;
+      }
+
+      for( const int threads : check_threads ) {
+        DrawCheckFrames( ini_file, led_amount, threads, is_remapped, is_high_depth, &sharded_frames );
+
+        int frames_different = sharded_frames.size() == single_frames.size() ? 0 : LAYOUTBENCH_CHECK_FRAMES;
+        for( size_t frame = 0; frames_different == 0 && frame < single_frames.size(); frame++ ) {
+          if( sharded_frames[ frame ] != single_frames[ frame ] ) {
+            const size_t led = std::mismatch( single_frames[ frame ].begin(), single_frames[ frame ].end(), sharded_frames[ frame ].begin() ).first - single_frames[ frame ].begin();
+            MSG_LAYOUTBENCH_ERROR( "Frame " << frame << " differs first at LED " << led + 1 << "." );
+            frames_different++;
+          }
+        }
+        mismatches += frames_different;
+
+        MSG_LAYOUTBENCH_INFO( "  " << threads << " threads" << ( is_remapped ? ", remap" : "" ) << ( is_high_depth ? ", high depth" : "" )
+                              << " : " << ( frames_different == 0 ? "match" : "MISMATCH" ) << " (" << sharded_frames.size() << " frames)" );
+      }
+    }
+  }
+
+  unlink( layout_file.c_str() );
+  unlink( ini_file.c_str() );
+
+  if( mismatches > 0 ) {
+    MSG_LAYOUTBENCH_ERROR( "FAIL : Sharded frames differ from 1 thread." );
+    return 1;
+  }
+
+  return 0;
+};
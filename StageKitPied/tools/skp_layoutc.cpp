@@ -0,0 +1,70 @@
+/*
+ LED layout compiler.
+
+ Compiles a leds ini into the layout file LEDArray maps at start up, so the ini doesn't need reading.
+ skp also writes this itself the first time it loads an ini.  This is for building them in advance, e.g. for a
+ read only install, and for checking a layout.
+
+ Usage : skp_layoutc <leds_ini> <led_amount> [layout_file]
+         layout_file defaults to the ini name with .layout appended.
+*/
+
+#include <stdlib.h>
+#include <chrono>
+
+#include "leds/LEDLayout.h"
+
+#define MSG_LAYOUTC_INFO( str ) do { std::cout << "LayoutCompiler : INFO : " << str << std::endl; } while( false )
+#define MSG_LAYOUTC_ERROR( str ) do { std::cout << "LayoutCompiler : ERROR : " << str << std::endl; } while( false )
+
+int main( int argc, char *argv[] ) {
+  if( argc < 3 ) {
+    std::cout << "Usage : " << argv[ 0 ] << " <leds_ini> <led_amount> [layout_file]" << std::endl;
+    return 1;
+  }
+
+  const std::string ini_file = argv[ 1 ];
+  const int led_amount = atoi( argv[ 2 ] );
+  const std::string layout_file = argc > 3 ? argv[ 3 ] : ini_file + LEDLAYOUT_EXTENSION;
+
+  typedef std::chrono::steady_clock Clock;
+
+  LEDLayout layout;
+
+  Clock::time_point time_start = Clock::now();
+  if( !layout.Compile( ini_file, led_amount ) ) {
+    MSG_LAYOUTC_ERROR( "Unable to compile " << ini_file );
+    return 1;
+  }
+  const long compile_us = std::chrono::duration_cast<std::chrono::microseconds>( Clock::now() - time_start ).count();
+
+  if( !layout.Save( layout_file ) ) {
+    MSG_LAYOUTC_ERROR( "Unable to write " << layout_file );
+    return 1;
+  }
+
+  static const char* colour_names[ LEDLAYOUT_COLOURS ] = { "RED   ", "GREEN ", "BLUE  ", "YELLOW" };
+
+  for( int colour = 0; colour < LEDLAYOUT_COLOURS; colour++ ) {
+    std::string amounts;
+    for( int group = 0; group < LEDLAYOUT_GROUPS; group++ ) {
+      amounts += " ";
+      amounts += std::to_string( layout.GetGroup( colour, group ).m_amount );
+    }
+    MSG_LAYOUTC_INFO( colour_names[ colour ] << " LEDs per group :" << amounts );
+  }
+  MSG_LAYOUTC_INFO( "STROBE LEDs           : " << layout.GetStrobe().m_amount );
+
+  // Read it back the same way LEDArray does.
+  time_start = Clock::now();
+  if( !layout.Map( layout_file, ini_file, led_amount ) ) {
+    MSG_LAYOUTC_ERROR( "Written layout failed to map back in." );
+    return 1;
+  }
+  const long map_us = std::chrono::duration_cast<std::chrono::microseconds>( Clock::now() - time_start ).count();
+
+  MSG_LAYOUTC_INFO( "Written " << layout_file << " : " << layout.GetSize() << " bytes" );
+  MSG_LAYOUTC_INFO( "Compile " << compile_us << " us : Map " << map_us << " us" );
+
+  return 0;
+};
@@ -0,0 +1,120 @@
+/*
+ Serial adapter bench.
+
+ Connects to a serial adapter, or the adapter emulator in gimx-adapter/host, and times the decode of the out
+ reports it sends.  Reports packets per second & time spent in SerialAdapter::Poll per packet.
+
+ Usage : skp_serialbench <serial_port> [seconds] [baudrate_max]
+         serial_port 'auto' probes all USB serial ports for the adapter.
+*/
+
+#include <signal.h>
+#include <stdlib.h>
+#include <chrono>
+#include <cstring>
+
+#include "serial/SerialAdapter.h"
+#include "serial/SerialDiscovery.h"
+
+#define MSG_BENCH_INFO( str ) do { std::cout << "SerialBench : INFO : " << str << std::endl; } while( false )
+#define MSG_BENCH_ERROR( str ) do { std::cout << "SerialBench : ERROR : " << str << std::endl; } while( false )
+
+volatile sig_atomic_t done = 0;
+
+void term( int signum )
+{
+  done = 1;
+}
+
+int main( int argc, char *argv[] ) {
+  if( argc < 2 ) {
+    std::cout << "Usage : " << argv[ 0 ] << " <serial_port> [seconds] [baudrate_max]" << std::endl;
+    return 1;
+  }
+
+  const long seconds = argc > 2 ? atol( argv[ 2 ] ) : 10;
+
+  struct sigaction action;
+  memset( &action, 0, sizeof( action ) );
+  action.sa_handler = term;
+  sigaction( SIGTERM, &action, NULL );
+  sigaction( SIGINT, &action, NULL );
+
+  SerialAdapter adapter;
+  if( argc > 3 ) {
+    adapter.SetBaudrateMax( atoi( argv[ 3 ] ) );
+  }
+
+  std::string serial_port = argv[ 1 ];
+  if( serial_port == "auto" ) {
+    const std::chrono::steady_clock::time_point discover_start = std::chrono::steady_clock::now();
+
+    SerialDiscovery discovery;
+    discovery.ScanPorts( std::vector<std::string>() );
+    serial_port = discovery.FindAdapter( SERIALADAPTER_PROBE_TIMEOUT );
+
+    MSG_BENCH_INFO( "Probed " << discovery.Ports().size() << " ports in "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - discover_start ).count() << " ms" );
+
+    if( serial_port.empty() ) {
+      MSG_BENCH_ERROR( "No serial adapter found." );
+      return 1;
+    }
+  }
+
+  if( !adapter.Init( serial_port.c_str(), false ) ) {
+    MSG_BENCH_ERROR( "Unable to connect to serial adapter on " << serial_port );
+    return 1;
+  }
+
+  MSG_BENCH_INFO( "Connected at " << adapter.GetBaudrate() << " bps" );
+
+  typedef std::chrono::steady_clock Clock;
+
+  const Clock::time_point time_begin = Clock::now();
+  const Clock::time_point time_end = time_begin + std::chrono::seconds( seconds );
+  Clock::time_point time_report = time_begin + std::chrono::seconds( 1 );
+
+  long packets = 0;
+  long packets_last = 0;
+  long packets_invalid = 0;
+  long long poll_ns = 0;
+  long long poll_ns_max = 0;
+
+  while( !done && adapter.IsRunning() && Clock::now() < time_end ) {
+    const Clock::time_point poll_start = Clock::now();
+    const bool received = adapter.Poll();
+    const long long poll_time = std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - poll_start ).count();
+
+    if( received && adapter.PayloadType() == HEADER_OUT_REPORT ) {
+      // Same checks as RpiLightsController::SerialAdapter_HandleOutReport
+      if( adapter.PayloadLength() == 8 && adapter.Payload()[ 0 ] == 0x00 && adapter.Payload()[ 1 ] == 0x08 ) {
+        packets++;
+        poll_ns += poll_time;
+        if( poll_time > poll_ns_max ) {
+          poll_ns_max = poll_time;
+        }
+      } else {
+        packets_invalid++;
+      }
+    }
+
+    if( Clock::now() >= time_report ) {
+      MSG_BENCH_INFO( ( packets - packets_last ) << " packets/s" );
+      packets_last = packets;
+      time_report += std::chrono::seconds( 1 );
+    }
+  }
+
+  const double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>( Clock::now() - time_begin ).count();
+
+  MSG_BENCH_INFO( "Packets       : " << packets << " ( " << packets_invalid << " invalid )" );
+  MSG_BENCH_INFO( "Packets/s     : " << ( elapsed > 0 ? packets / elapsed : 0 ) );
+  MSG_BENCH_INFO( "Poll average  : " << ( packets ? poll_ns / packets : 0 ) << " ns" );
+  MSG_BENCH_INFO( "Poll max      : " << poll_ns_max << " ns" );
+  MSG_BENCH_INFO( "Link baudrate : " << adapter.GetBaudrate() << " bps" );
+
+  adapter.Close();
+
+  return 0;
+};
@@ -6,11 +6,15 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef ADAPTER_HOST
+#include "host/adapter_host.h"
+#else
 #include <avr/wdt.h>
 #include <avr/power.h>
 
 #include <LUFA/Drivers/USB/USB.h>
 #include <LUFA/Drivers/Peripheral/Serial.h>
+#endif
 
 #include "../adapter_protocol.h"
 #include "Config/AdapterConfig.h"
@@ -50,6 +54,7 @@
 #define MAX_CONTROL_TRANSFER_SIZE 64
 
 #define USART_BAUDRATE 5 // 500Kbps
+#define USART_BAUDRATE_MAX 20 // 2Mbps
 #define USART_DOUBLE_SPEED true
 
 const uint8_t version_major = 8;
@@ -94,6 +99,14 @@ static inline bool Serial_WaitByte(volatile uint8_t * byte) {
   return false;
 }
 
+/*
+ * Only accept rates the CPU clock divides exactly in double speed mode (500Kbps, 1Mbps & 2Mbps at 16MHz).
+ * An unsupported rate is ignored, so the software side sees the old rate when it reads it back.
+ */
+static inline bool baudrate_is_supported(uint8_t value) {
+    return value >= USART_BAUDRATE && value <= USART_BAUDRATE_MAX && (F_CPU / 8) % (value * 100000UL) == 0;
+}
+
 static inline void send_spoof_header(void) {
     Serial_SendByte(BYTE_CONTROL_DATA);
     if (USB_ControlRequest.bmRequestType & REQDIR_DEVICETOHOST) {
@@ -141,6 +154,9 @@ static inline void handle_packet(void) {
         break;
     case BYTE_BAUDRATE:
         if (value_len > 0) {
+          if (!baudrate_is_supported(buf[0])) {
+            break;
+          }
           baudrate = buf[0];
           PORTD |= (1 << 3); // keep TX high while reconfiguring
           Serial_Disable();
@@ -295,6 +311,7 @@ void HID_Task(void) {
 #endif
 }
 
+#ifndef ADAPTER_HOST
 int main(void) {
 
     SetupHardware();
@@ -304,3 +321,4 @@ int main(void) {
         USB_USBTask();
     }
 }
+#endif
@@ -0,0 +1,369 @@
+/*
+ Adapter emulator.
+
+ Runs the host build of the adapter firmware on a pseudo-terminal, so SerialAdapter can connect to it as if it
+ were a Pro Micro behind an FTDI adapter.  Once started, it plays stage kit rumble data out as BYTE_OUT_REPORT
+ packets, the same as the firmware does when the console sends them.
+
+ Cue file : One cue per line as "left,right" (the two rumble weights, decimal or 0x hex).  '#' starts a comment.
+            Without a cue file a synthetic light show is generated.
+ License: GPLv3
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "adapter_host.h"
+
+#define EMU_MAX_CUES 65536
+
+// Time both ends get to switch rate before the line is taken as mismatched.
+#define EMU_RATE_CHANGE_US 5000
+
+// Rumble weights, see StageKitConsts.h
+#define EMU_SK_FOG_OFF    0x02
+#define EMU_SK_STROBE_1   0x03
+#define EMU_SK_STROBE_OFF 0x07
+#define EMU_SK_BLUE       0x20
+#define EMU_SK_GREEN      0x40
+#define EMU_SK_YELLOW     0x60
+#define EMU_SK_RED        0x80
+
+typedef struct {
+    uint8_t left;
+    uint8_t right;
+} cue;
+
+static volatile sig_atomic_t done = 0;
+
+static int master_fd = -1;
+static cue cues[EMU_MAX_CUES];
+static uint32_t cue_amount = 0;
+static uint64_t bytes_out = 0;
+
+static void term(int signum) {
+    done = 1;
+}
+
+static uint64_t now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static uint32_t speed_to_bps(speed_t speed) {
+    switch (speed) {
+    case B500000:
+        return 500000;
+    case B1000000:
+        return 1000000;
+    case B2000000:
+        return 2000000;
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Termios calls on a pty master act on the slave, so this is the rate SerialAdapter set.  When it differs from
+ * the firmware rate, bytes are garbled as they would be on a real line.
+ */
+static bool line_matches(void) {
+    struct termios options;
+    if (tcgetattr(master_fd, &options) < 0) {
+        return true;
+    }
+    return speed_to_bps(cfgetospeed(&options)) == adapter_host_baudrate();
+}
+
+/*
+ * A pty has no bit timing, so bytes written just before a rate change can be read after it.  Received bytes are
+ * only garbled once the rates have differed for a while.
+ */
+static uint64_t line_mismatched_for_us(void) {
+    static uint64_t mismatch_since_us = 0;
+
+    if (line_matches()) {
+        mismatch_since_us = 0;
+        return 0;
+    }
+    if (mismatch_since_us == 0) {
+        mismatch_since_us = now_us();
+    }
+    return now_us() - mismatch_since_us;
+}
+
+static void to_serial(const uint8_t* data, uint16_t length, void* context) {
+    uint8_t garbled[256];
+
+    if (!line_matches()) {
+        for (uint16_t pos = 0; pos < length; pos++) {
+            garbled[pos] = data[pos] ^ 0x5A;
+        }
+        data = garbled;
+    }
+
+    while (length > 0) {
+        ssize_t written = write(master_fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                // Nobody reading, drop it as the FTDI buffer would.
+                return;
+            }
+            return;
+        }
+        bytes_out += written;
+        data += written;
+        length -= written;
+    }
+}
+
+static uint8_t parse_byte(const char* text, char** end) {
+    return (uint8_t) strtoul(text, end, 0);
+}
+
+static bool load_cues(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Unable to open cue file '%s'\n", filename);
+        return false;
+    }
+
+    char line[256];
+    while (cue_amount < EMU_MAX_CUES && fgets(line, sizeof(line), file)) {
+        char* hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+
+        char* pos = line;
+        while (*pos == ' ' || *pos == '\t') {
+            pos++;
+        }
+        if (*pos == '\0' || *pos == '\n' || *pos == '\r') {
+            continue;
+        }
+
+        char* end;
+        cues[cue_amount].left = parse_byte(pos, &end);
+        while (*end == ' ' || *end == '\t') {
+            end++;
+        }
+        if (*end != ',') {
+            fprintf(stderr, "Malformed cue : %s", line);
+            fclose(file);
+            return false;
+        }
+        cues[cue_amount].right = parse_byte(end + 1, &end);
+        cue_amount++;
+    }
+
+    fclose(file);
+    return cue_amount > 0;
+}
+
+// A chase round each colour with a strobe burst, fog off is sent often as it is by the games.
+static void synthetic_cues(void) {
+    static const uint8_t colours[] = { EMU_SK_RED, EMU_SK_GREEN, EMU_SK_BLUE, EMU_SK_YELLOW };
+
+    for (uint8_t colour = 0; colour < sizeof(colours); colour++) {
+        for (uint8_t led = 0; led < 8; led++) {
+            cues[cue_amount++] = (cue) { (uint8_t) (0x11 << (led & 3)), colours[colour] };
+            cues[cue_amount++] = (cue) { 0x00, EMU_SK_FOG_OFF };
+        }
+        cues[cue_amount++] = (cue) { 0x00, colours[colour] };
+    }
+    cues[cue_amount++] = (cue) { 0x00, EMU_SK_STROBE_1 + 3 };
+    cues[cue_amount++] = (cue) { 0x00, EMU_SK_STROBE_OFF };
+}
+
+static void usage(const char* name) {
+    fprintf(stderr, "Usage: %s [-f cue_file] [-r packets_per_second] [-l link_path] [-b max_reliable_bps] [-n packets]\n", name);
+    fprintf(stderr, "  -f  Cue file to play, loops.  Default is a synthetic light show.\n");
+    fprintf(stderr, "  -r  Rate to send rumble packets at.  Default 100.\n");
+    fprintf(stderr, "  -l  Symlink to create to the pty, e.g. /tmp/ttySKP.\n");
+    fprintf(stderr, "  -b  Garble the line when the firmware runs above this rate, to test baudrate fallback.\n");
+    fprintf(stderr, "  -n  Stop after sending this many packets.  Default never.\n");
+}
+
+int main(int argc, char* argv[]) {
+    const char* cue_file = NULL;
+    const char* link_path = NULL;
+    uint32_t rate = 100;
+    uint32_t baudrate_limit = 0;
+    uint64_t packet_limit = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:r:l:b:n:h")) != -1) {
+        switch (opt) {
+        case 'f':
+            cue_file = optarg;
+            break;
+        case 'r':
+            rate = strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            link_path = optarg;
+            break;
+        case 'b':
+            baudrate_limit = strtoul(optarg, NULL, 0);
+            break;
+        case 'n':
+            packet_limit = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (rate == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (cue_file) {
+        if (!load_cues(cue_file)) {
+            return 1;
+        }
+    } else {
+        synthetic_cues();
+    }
+
+    master_fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (master_fd < 0 || grantpt(master_fd) < 0 || unlockpt(master_fd) < 0) {
+        perror("pty");
+        return 1;
+    }
+
+    // Raw & at the firmware default rate until SerialAdapter sets it up.
+    struct termios options;
+    tcgetattr(master_fd, &options);
+    cfmakeraw(&options);
+    cfsetispeed(&options, B500000);
+    cfsetospeed(&options, B500000);
+    tcsetattr(master_fd, TCSANOW, &options);
+
+    const char* slave_path = ptsname(master_fd);
+    if (link_path) {
+        unlink(link_path);
+        if (symlink(slave_path, link_path) < 0) {
+            perror("symlink");
+            return 1;
+        }
+    }
+
+    printf("Adapter emulator on %s%s%s\n", slave_path, link_path ? " -> " : "", link_path ? link_path : "");
+    printf("%u cues at %u packets/s\n", cue_amount, rate);
+    fflush(stdout);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = term;
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGINT, &action, NULL);
+
+    adapter_host_power_on(to_serial, NULL);
+    adapter_host_set_baudrate_limit(baudrate_limit);
+
+    const uint64_t interval_us = 1000000 / rate;
+    uint64_t next_packet_us = 0;
+    uint64_t next_report_us = now_us() + 1000000;
+    uint64_t packets = 0;
+    uint64_t packets_last = 0;
+    uint64_t packets_dropped = 0;
+    uint32_t cue_next = 0;
+    bool was_started = false;
+    uint8_t report[8] = { 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+    while (!done && (packet_limit == 0 || packets < packet_limit)) {
+        uint64_t now = now_us();
+
+        uint64_t timeout_us = 10000;
+        if (was_started) {
+            timeout_us = next_packet_us > now ? next_packet_us - now : 0;
+        }
+        struct timespec timeout = { .tv_sec = timeout_us / 1000000, .tv_nsec = (timeout_us % 1000000) * 1000 };
+
+        struct pollfd pfd = { .fd = master_fd, .events = POLLIN };
+        if (ppoll(&pfd, 1, &timeout, NULL) > 0 && (pfd.revents & POLLIN)) {
+            uint8_t data[512];
+            ssize_t amount = read(master_fd, data, sizeof(data));
+            if (amount > 0) {
+                if (line_mismatched_for_us() > EMU_RATE_CHANGE_US) {
+                    for (ssize_t pos = 0; pos < amount; pos++) {
+                        data[pos] ^= 0x5A;
+                    }
+                }
+                adapter_host_receive(data, amount);
+            }
+        }
+
+        adapter_host_task();
+
+        if (adapter_host_started() != was_started) {
+            was_started = adapter_host_started();
+            if (was_started) {
+                // Console side is taken as already authenticated.
+                adapter_host_set_spoofed(true);
+                printf("Started at %u bps\n", adapter_host_baudrate());
+                next_packet_us = now_us();
+            } else {
+                printf("Adapter reset (%u resets), back at %u bps\n", adapter_host_resets(), adapter_host_baudrate());
+            }
+            fflush(stdout);
+        }
+
+        now = now_us();
+        if (was_started && now >= next_packet_us) {
+            report[3] = cues[cue_next].left;
+            report[4] = cues[cue_next].right;
+            if (adapter_host_out_report(report, sizeof(report))) {
+                adapter_host_task();
+                packets++;
+                cue_next = (cue_next + 1) % cue_amount;
+            } else {
+                packets_dropped++;
+            }
+            next_packet_us += interval_us;
+            if (next_packet_us + 100 * interval_us < now) {
+                // Fallen well behind, don't try to catch up.
+                next_packet_us = now + interval_us;
+            }
+        }
+
+        if (now >= next_report_us) {
+            if (was_started) {
+                printf("%llu packets/s : %llu total : %llu dropped : %llu bytes out\n",
+                       (unsigned long long) (packets - packets_last), (unsigned long long) packets,
+                       (unsigned long long) packets_dropped, (unsigned long long) bytes_out);
+                fflush(stdout);
+            }
+            packets_last = packets;
+            next_report_us += 1000000;
+        }
+    }
+
+    if (link_path) {
+        unlink(link_path);
+    }
+    close(master_fd);
+
+    printf("Sent %llu packets\n", (unsigned long long) packets);
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+/*
+ Host build of the adapter firmware.  See adapter_host.h.
+ License: GPLv3
+ */
+
+#include <setjmp.h>
+#include <string.h>
+#include <time.h>
+
+#include "adapter_host.h"
+#include "../adapter_common.c"
+
+// Firmware resets itself if a packet is not fully received within 10ms.
+#define HOST_PACKET_TIMEOUT_MS 10
+
+#define HOST_RX_BUFFER_SIZE 1024
+
+volatile uint8_t MCUSR;
+volatile uint8_t PORTD;
+volatile uint8_t UCSR1B;
+volatile uint8_t TCCR1B;
+
+USB_Request_Header_t USB_ControlRequest;
+volatile uint8_t USB_DeviceState = DEVICE_STATE_Unattached;
+
+static adapter_host_tx_callback host_tx = NULL;
+static void* host_tx_context = NULL;
+
+static uint8_t host_rx[HOST_RX_BUFFER_SIZE];
+static uint16_t host_rx_start = 0;
+static uint16_t host_rx_end = 0;
+static uint64_t host_rx_pending_since_ms = 0;
+
+static volatile uint16_t host_timer1 = 0;
+static uint32_t host_serial_baudrate = 0;
+static uint32_t host_baudrate_limit = 0;
+static uint32_t host_resets = 0;
+
+static uint8_t host_out_report[ADAPTER_OUT_SIZE];
+static uint8_t host_out_report_length = 0;
+
+static jmp_buf host_watchdog;
+
+static uint64_t host_now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static bool host_line_corrupt(void) {
+    return host_baudrate_limit != 0 && host_serial_baudrate > host_baudrate_limit;
+}
+
+static uint16_t host_rx_size(void) {
+    return host_rx_end - host_rx_start;
+}
+
+static void host_reset_state(void) {
+    sendReport = 0;
+    reportLen = 0;
+    started = 0;
+    packet_type = 0;
+    value_len = 0;
+    spoofReply = 0;
+    spoofReplyLen = 0;
+    spoof_initialized = BYTE_STATUS_NSPOOFED;
+    vid = 0;
+    pid = 0;
+    baudrate = USART_BAUDRATE;
+    i = 0;
+
+    host_rx_start = 0;
+    host_rx_end = 0;
+    host_rx_pending_since_ms = 0;
+    host_out_report_length = 0;
+
+    USB_DeviceState = DEVICE_STATE_Unattached;
+
+    // Same start up as SetupHardware, minus the wait for BYTE_START.
+    Serial_Init(baudrate * 100000U, true);
+}
+
+// Hands every fully received packet to the USART ISR, like the firmware does byte by byte.
+static void host_dispatch(void) {
+    if (setjmp(host_watchdog)) {
+        host_resets++;
+        host_reset_state();
+        return;
+    }
+
+    while (host_rx_size() >= 2 && host_rx_size() >= 2 + host_rx[host_rx_start + 1]) {
+        adapter_host_usart1_rx_isr();
+    }
+
+    if (host_rx_size() == 0) {
+        host_rx_start = 0;
+        host_rx_end = 0;
+        host_rx_pending_since_ms = 0;
+    } else if (host_rx_pending_since_ms == 0) {
+        host_rx_pending_since_ms = host_now_ms();
+    }
+}
+
+void adapter_host_power_on(adapter_host_tx_callback tx, void* context) {
+    host_tx = tx;
+    host_tx_context = context;
+    host_reset_state();
+}
+
+void adapter_host_receive(const uint8_t* data, uint16_t length) {
+    if (host_rx_start > 0 && host_rx_end + length > HOST_RX_BUFFER_SIZE) {
+        memmove(host_rx, host_rx + host_rx_start, host_rx_size());
+        host_rx_end -= host_rx_start;
+        host_rx_start = 0;
+    }
+    if (host_rx_end + length > HOST_RX_BUFFER_SIZE) {
+        // Overrun, the bytes are lost like on the real USART.
+        length = HOST_RX_BUFFER_SIZE - host_rx_end;
+    }
+
+    for (uint16_t pos = 0; pos < length; pos++) {
+        host_rx[host_rx_end++] = host_line_corrupt() ? data[pos] ^ 0xA5 : data[pos];
+    }
+
+    host_dispatch();
+}
+
+void adapter_host_task(void) {
+    if (host_rx_pending_since_ms != 0 && host_now_ms() - host_rx_pending_since_ms > HOST_PACKET_TIMEOUT_MS) {
+        // Incomplete packet, the ISR would have timed out on it.
+        if (setjmp(host_watchdog) == 0) {
+            forceHardReset();
+        }
+        host_resets++;
+        host_reset_state();
+    }
+
+    if (started && USB_DeviceState != DEVICE_STATE_Configured) {
+        USB_DeviceState = DEVICE_STATE_Configured;
+        EVENT_USB_Device_ConfigurationChanged();
+    }
+
+    HID_Task();
+}
+
+bool adapter_host_out_report(const uint8_t* report, uint8_t length) {
+    if (USB_DeviceState != DEVICE_STATE_Configured || host_out_report_length != 0 || length == 0 || length > ADAPTER_OUT_SIZE) {
+        return false;
+    }
+    memcpy(host_out_report, report, length);
+    host_out_report_length = length;
+    return true;
+}
+
+uint32_t adapter_host_baudrate(void) {
+    return host_serial_baudrate;
+}
+
+void adapter_host_set_baudrate_limit(uint32_t limit) {
+    host_baudrate_limit = limit;
+}
+
+bool adapter_host_started(void) {
+    return started != 0;
+}
+
+void adapter_host_set_spoofed(bool spoofed) {
+    spoof_initialized = spoofed ? BYTE_STATUS_SPOOFED : BYTE_STATUS_NSPOOFED;
+}
+
+uint32_t adapter_host_resets(void) {
+    return host_resets;
+}
+
+void adapter_host_watchdog_reset(void) {
+    longjmp(host_watchdog, 1);
+}
+
+uint8_t adapter_host_udr1(void) {
+    return host_rx_size() ? host_rx[host_rx_start++] : 0;
+}
+
+volatile uint16_t* adapter_host_timer1(void) {
+    return &host_timer1;
+}
+
+bool Serial_IsCharReceived(void) {
+    if (host_rx_size() == 0) {
+        // Nothing will arrive while the ISR spins, let the reception timer run out.
+        host_timer1++;
+        return false;
+    }
+    return true;
+}
+
+void Serial_SendByte(const char data) {
+    Serial_SendData(&data, 1);
+}
+
+void Serial_SendData(const void* buffer, uint16_t length) {
+    uint8_t out[256];
+    const uint8_t* data = (const uint8_t*) buffer;
+
+    while (length > 0) {
+        uint16_t chunk = length > sizeof(out) ? sizeof(out) : length;
+        for (uint16_t pos = 0; pos < chunk; pos++) {
+            out[pos] = host_line_corrupt() ? data[pos] ^ 0xA5 : data[pos];
+        }
+        if (host_tx) {
+            host_tx(out, chunk, host_tx_context);
+        }
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+void Serial_Init(const uint32_t rate, const bool double_speed) {
+    host_serial_baudrate = rate;
+}
+
+void Serial_Disable(void) {
+    host_serial_baudrate = 0;
+}
+
+bool Endpoint_ConfigureEndpoint(const uint8_t address, const uint8_t type, const uint16_t size, const uint8_t banks) {
+    return true;
+}
+
+void Endpoint_SelectEndpoint(const uint8_t address) {
+}
+
+bool Endpoint_IsINReady(void) {
+    return true;
+}
+
+bool Endpoint_IsOUTReceived(void) {
+    return host_out_report_length != 0;
+}
+
+bool Endpoint_IsReadWriteAllowed(void) {
+    return true;
+}
+
+uint8_t Endpoint_Write_Stream_LE(const void* buffer, uint16_t length, uint16_t* const bytes_processed) {
+    // IN reports go to the console, nothing to do with them here.
+    return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t Endpoint_Read_Stream_LE(void* buffer, uint16_t length, uint16_t* const bytes_processed) {
+    uint16_t amount = length < host_out_report_length ? length : host_out_report_length;
+
+    memcpy(buffer, host_out_report, amount);
+    if (bytes_processed) {
+        *bytes_processed = amount;
+    }
+    // Short reports end the transfer early, as a short USB packet would.
+    return amount == length ? ENDPOINT_RWSTREAM_NoError : 1;
+}
+
+void Endpoint_ClearIN(void) {
+}
+
+void Endpoint_ClearOUT(void) {
+    host_out_report_length = 0;
+}
@@ -0,0 +1,127 @@
+/*
+ Host build of the adapter firmware.
+
+ Stands in for the avr-libc and LUFA pieces used by adapter_common.c so the serial protocol side of the
+ firmware can be compiled & run on a PC.  The serial line is fed in with adapter_host_receive(), anything the
+ firmware sends back comes out through the tx callback given to adapter_host_power_on().
+ License: GPLv3
+ */
+
+#ifndef _ADAPTER_HOST_H_
+#define _ADAPTER_HOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+/*
+ * Harness
+ */
+
+typedef void (*adapter_host_tx_callback)(const uint8_t* data, uint16_t length, void* context);
+
+// Cold start of the firmware.  Also what happens after a watchdog reset.
+void adapter_host_power_on(adapter_host_tx_callback tx, void* context);
+
+// Bytes received on the adapter serial line (RX1).
+void adapter_host_receive(const uint8_t* data, uint16_t length);
+
+// Runs the main loop once & checks the packet reception timer.
+void adapter_host_task(void);
+
+// An OUT report from the console, sent back over serial as BYTE_OUT_REPORT by the firmware.
+bool adapter_host_out_report(const uint8_t* report, uint8_t length);
+
+// Current serial rate of the firmware in bps.
+uint32_t adapter_host_baudrate(void);
+
+// Corrupt the serial line whenever the firmware runs above this rate.  0 = never.
+void adapter_host_set_baudrate_limit(uint32_t baudrate);
+
+bool adapter_host_started(void);
+
+// Console side of the security handshake, as reported by BYTE_STATUS & BYTE_START.
+void adapter_host_set_spoofed(bool spoofed);
+
+// Amount of watchdog resets since the first power on.
+uint32_t adapter_host_resets(void);
+
+/*
+ * avr-libc
+ */
+
+#define ISR(vector) void vector(void)
+#define USART1_RX_vect adapter_host_usart1_rx_isr
+
+void adapter_host_usart1_rx_isr(void);
+void adapter_host_watchdog_reset(void) __attribute__((noreturn));
+uint8_t adapter_host_udr1(void);
+volatile uint16_t* adapter_host_timer1(void);
+
+extern volatile uint8_t MCUSR;
+extern volatile uint8_t PORTD;
+extern volatile uint8_t UCSR1B;
+extern volatile uint8_t TCCR1B;
+
+#define UDR1  adapter_host_udr1()
+#define TCNT1 (*adapter_host_timer1())
+
+#define RXCIE1 7
+#define CS12   2
+
+#define WDTO_15MS 0
+#define wdt_enable(timeout) adapter_host_watchdog_reset()
+#define wdt_disable()
+#define cli()
+
+#define clock_div_1 0
+#define clock_prescale_set(divider)
+
+/*
+ * LUFA
+ */
+
+typedef struct {
+  uint8_t  bmRequestType;
+  uint8_t  bRequest;
+  uint16_t wValue;
+  uint16_t wIndex;
+  uint16_t wLength;
+} __attribute__((packed)) USB_Request_Header_t;
+
+extern USB_Request_Header_t USB_ControlRequest;
+extern volatile uint8_t USB_DeviceState;
+
+#define REQDIR_DEVICETOHOST      0x80
+#define ENDPOINT_DIR_IN          0x80
+#define ENDPOINT_DIR_OUT         0x00
+#define EP_TYPE_INTERRUPT        0x03
+#define DEVICE_STATE_Unattached  0
+#define DEVICE_STATE_Configured  4
+#define ENDPOINT_RWSTREAM_NoError 0
+
+#define GlobalInterruptEnable()
+#define USB_Init()
+#define USB_USBTask()
+
+bool Serial_IsCharReceived(void);
+void Serial_SendByte(const char data);
+void Serial_SendData(const void* buffer, uint16_t length);
+void Serial_Init(const uint32_t baudrate, const bool double_speed);
+void Serial_Disable(void);
+
+bool Endpoint_ConfigureEndpoint(const uint8_t address, const uint8_t type, const uint16_t size, const uint8_t banks);
+void Endpoint_SelectEndpoint(const uint8_t address);
+bool Endpoint_IsINReady(void);
+bool Endpoint_IsOUTReceived(void);
+bool Endpoint_IsReadWriteAllowed(void);
+uint8_t Endpoint_Write_Stream_LE(const void* buffer, uint16_t length, uint16_t* const bytes_processed);
+uint8_t Endpoint_Read_Stream_LE(void* buffer, uint16_t length, uint16_t* const bytes_processed);
+void Endpoint_ClearIN(void);
+void Endpoint_ClearOUT(void);
+
+#endif